@@ -0,0 +1,400 @@
+﻿/**
+ * @file Benchmark.cpp
+ * @brief Мікробенчмарки гарячих шляхів бронювань і каталогу
+ *
+ * Для кожного розміру набору (кількість бронювань) генерує детермінований
+ * каталог і файл бронювань у тимчасовій теці, завантажує їх через
+ * HotelManager/BookingManager і вимірює операції. Результат - JSON з
+ * ns/op, виділеннями пам'яті на операцію та пропускною здатністю.
+ *
+ * Запуск: Benchmark [--sizes 1000,10000,100000] [--min-time 0.2] [--out результати.json]
+ * За замовчуванням розміри 1000, 10000 і 100000. Набір на 10 млн бронювань
+ * потребує багато часу й пам'яті, тому вимірюється лише на явний запит:
+ *   Benchmark --sizes 1000,100000,10000000
+ * Збірка у Linux:
+ *   g++ -std=c++17 -O2 -pthread -ICoursework1 Benchmark/Benchmark.cpp \
+ *       $(ls Coursework1/[A-Z]*.cpp | grep -v Coursework1.cpp) -o benchmark
+ */
+
+#include "HotelManager.h"
+#include "BookingManager.h"
+#include "PremiumHotel.h"
+#include "BudgetHotel.h"
+#include "Constants.hpp"
+#include "DatasetGenerator.h"
+#include "Logger.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+// Лічильник виділень пам'яті: глобальні operator new/delete замінюються
+// для всього процесу, тому враховуються й виділення всередині менеджерів
+// Усі форми (звичайні, масивів, nothrow, з розміром і з вирівнюванням)
+// проходять через одну пару функцій, тож виділення й звільнення узгоджені
+namespace {
+    std::atomic<std::uint64_t> allocationCount{ 0 };
+
+    void* countedAllocate(std::size_t size, std::size_t alignment) noexcept {
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+        size = size ? size : 1;
+#ifdef _MSC_VER
+        return _aligned_malloc(size, alignment);
+#else
+        // aligned_alloc вимагає розмір, кратний вирівнюванню
+        return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+    }
+
+    void countedRelease(void* memory) noexcept {
+#ifdef _MSC_VER
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+
+    void* countedAllocateOrThrow(std::size_t size, std::size_t alignment) {
+        if (void* memory = countedAllocate(size, alignment)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+    const std::size_t DEFAULT_ALIGNMENT = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+}
+
+void* operator new(std::size_t size) {
+    return countedAllocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size) {
+    return countedAllocateOrThrow(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return countedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, DEFAULT_ALIGNMENT);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size, DEFAULT_ALIGNMENT);
+}
+
+void operator delete(void* memory) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    countedRelease(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    countedRelease(memory);
+}
+
+namespace {
+    // Середня кількість бронювань на номер у згенерованому наборі
+    const size_t BOOKINGS_PER_ROOM = 5;
+    const size_t MEAN_ROOMS_PER_HOTEL = 22;
+
+    // Не дає компілятору викинути результати вимірюваних викликів
+    volatile std::size_t sink = 0;
+
+    struct Measurement {
+        std::string name;
+        size_t size = 0;
+        std::uint64_t iterations = 0;
+        double nsPerOp = 0.0;
+        double allocsPerOp = 0.0;
+        double opsPerSec = 0.0;
+    };
+
+    struct Dataset {
+        size_t bookingCount = 0;
+        int clientCount = 0;
+        int horizonDays = 0;
+        int lastBookedDay = 0;
+        std::vector<std::string> cities;
+        std::vector<DatasetGenerator::GeneratedRoom> rooms;
+        std::string hotelsFile;
+        std::string bookingsFile;
+    };
+
+    // Генерує каталог і бронювання тим самим генератором, що й Coursework1 --generate
+    Dataset generateDataset(size_t bookingCount, const std::filesystem::path& directory) {
+        DatasetConfig config;
+        config.seed = bookingCount;
+        config.bookingCount = bookingCount;
+        config.hotelCount = static_cast<int>(std::max<size_t>(1,
+            bookingCount / (MEAN_ROOMS_PER_HOTEL * BOOKINGS_PER_ROOM)));
+        DatasetGenerator generator(config);
+
+        Dataset dataset;
+        dataset.bookingCount = bookingCount;
+        dataset.hotelsFile = (directory / ("hotels-" + std::to_string(bookingCount) + ".csv")).string();
+        dataset.bookingsFile = (directory / ("bookings-" + std::to_string(bookingCount) + ".csv")).string();
+        if (!generator.writeHotels(dataset.hotelsFile) || !generator.writeBookings(dataset.bookingsFile)) {
+            throw std::runtime_error("не вдалося записати набір даних");
+        }
+
+        dataset.clientCount = generator.getConfig().clientCount;
+        dataset.horizonDays = generator.getConfig().horizonDays;
+        dataset.lastBookedDay = generator.getLastBookedDay();
+        dataset.cities = generator.getCities();
+        dataset.rooms = generator.getRooms();
+        return dataset;
+    }
+
+    /**
+     * @brief Вимірює операцію, подвоюючи кількість ітерацій до мінімального часу
+     * @param operation Виклик з номером ітерації
+     * @param maxIterations Верхня межа ітерацій (для повільних операцій)
+     */
+    template <typename Operation>
+    Measurement measure(const std::string& name, size_t size, double minSeconds,
+        std::uint64_t maxIterations, Operation operation) {
+        Measurement result;
+        result.name = name;
+        result.size = size;
+
+        std::uint64_t iterations = 1;
+        while (true) {
+            std::uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                operation(i);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::uint64_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+            if (seconds >= minSeconds || iterations >= maxIterations) {
+                result.iterations = iterations;
+                result.nsPerOp = seconds * 1e9 / iterations;
+                result.allocsPerOp = static_cast<double>(allocations) / iterations;
+                result.opsPerSec = seconds > 0 ? iterations / seconds : 0.0;
+                return result;
+            }
+            iterations = std::min(iterations * 2, maxIterations);
+        }
+    }
+
+    void runSuite(size_t bookingCount, double minSeconds, const std::filesystem::path& directory,
+        std::vector<Measurement>& results) {
+        Dataset dataset = generateDataset(bookingCount, directory);
+
+        HotelManager hotelManager(dataset.hotelsFile);
+        BookingManager bookingManager(dataset.bookingsFile, &hotelManager);
+        bookingManager.setAutoSave(false);
+
+        // Завантаження та збереження вимірюються окремими прогонами цілого файлу
+        results.push_back(measure("loadHotels", bookingCount, minSeconds, 3, [&](std::uint64_t) {
+            sink = sink + hotelManager.loadHotels();
+        }));
+        results.push_back(measure("loadBookings", bookingCount, minSeconds, 3, [&](std::uint64_t) {
+            sink = sink + bookingManager.loadBookings();
+        }));
+
+        std::mt19937_64 random(bookingCount + 1);
+        const std::vector<DatasetGenerator::GeneratedRoom>& rooms = dataset.rooms;
+        int hotelCount = rooms.back().hotelId;
+        auto randomHotel = [&]() { return static_cast<int>(random() % hotelCount) + 1; };
+        auto randomDay = [&]() { return static_cast<int>(random() % dataset.horizonDays); };
+
+        results.push_back(measure("checkAvailability", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            const DatasetGenerator::GeneratedRoom& room = rooms[random() % rooms.size()];
+            int start = randomDay();
+            sink = sink + bookingManager.checkAvailability(room.hotelId, room.roomNumber,
+                DatasetGenerator::formatDate(start), DatasetGenerator::formatDate(start + 3));
+        }));
+
+        results.push_back(measure("findBookingsByPassport", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            int client = static_cast<int>(random() % dataset.clientCount);
+            sink = sink + bookingManager.findBookingsByPassport(DatasetGenerator::passportFor(client)).size();
+        }));
+
+        results.push_back(measure("filterByDateRange", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            int start = randomDay();
+            sink = sink + bookingManager.filterByDateRange(DatasetGenerator::formatDate(start),
+                DatasetGenerator::formatDate(start + 7)).size();
+        }));
+
+        results.push_back(measure("findAvailableRooms", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            sink = sink + hotelManager.findAvailableRooms(dataset.cities[random() % dataset.cities.size()],
+                ROOM_CLASS_STANDARD, 2, 3000.0).size();
+        }));
+
+        results.push_back(measure("sortByPrice", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            sink = sink + hotelManager.sortByPrice().size();
+        }));
+
+        results.push_back(measure("findHotel", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            sink = sink + (hotelManager.findHotel(randomHotel()) != nullptr);
+        }));
+
+        // Нові бронювання йдуть після останньої згенерованої дати: по одній ночі на
+        // номер, день за днем (зокрема через межі місяців). Лічильник спільний для
+        // всіх прогонів measure, щоб повторний прогін не натрапляв на вже створені
+        // бронювання
+        std::uint64_t created = 0;
+        results.push_back(measure("createBooking", bookingCount, minSeconds, 1u << 24, [&](std::uint64_t) {
+            std::uint64_t i = created++;
+            const DatasetGenerator::GeneratedRoom& room = rooms[i % rooms.size()];
+            int day = dataset.lastBookedDay + 1 + static_cast<int>(i / rooms.size());
+            sink = sink + bookingManager.createBooking(room.hotelId, room.roomNumber, "Bench Client",
+                DatasetGenerator::passportFor(static_cast<int>(i % 1000000)),
+                DatasetGenerator::formatDate(day), DatasetGenerator::formatDate(day + 1));
+        }));
+
+        results.push_back(measure("saveBookings", bookingCount, minSeconds, 3, [&](std::uint64_t) {
+            sink = sink + bookingManager.saveBookings();
+        }));
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Measurement>& results, double minSeconds) {
+        out << "{\n  \"minTimeSeconds\": " << minSeconds << ",\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Measurement& m = results[i];
+            char line[256];
+            std::snprintf(line, sizeof(line),
+                "    {\"name\": \"%s\", \"size\": %zu, \"iterations\": %llu, \"nsPerOp\": %.1f, "
+                "\"allocsPerOp\": %.2f, \"opsPerSec\": %.1f}%s\n",
+                m.name.c_str(), m.size, static_cast<unsigned long long>(m.iterations), m.nsPerOp,
+                m.allocsPerOp, m.opsPerSec, i + 1 < results.size() ? "," : "");
+            out << line;
+        }
+        out << "  ]\n}" << std::endl;
+    }
+
+    bool parseSizes(const std::string& text, std::vector<size_t>& sizes) {
+        sizes.clear();
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            try {
+                long long value = std::stoll(item);
+                if (value <= 0) {
+                    return false;
+                }
+                sizes.push_back(static_cast<size_t>(value));
+            }
+            catch (const std::exception&) {
+                return false;
+            }
+        }
+        return !sizes.empty();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<size_t> sizes = { 1000, 10000, 100000 };
+    double minSeconds = 0.2;
+    std::string outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--sizes" && i + 1 < argc) {
+            if (!parseSizes(argv[++i], sizes)) {
+                std::cerr << "Некоректний перелік розмірів: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (argument == "--min-time" && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]);
+        }
+        else if (argument == "--out" && i + 1 < argc) {
+            outputPath = argv[++i];
+        }
+        else {
+            std::cerr << "Використання: Benchmark [--sizes 1000,10000,100000] [--min-time 0.2] [--out файл.json]" << std::endl;
+            std::cerr << "Розмір 10000000 вимірюється лише на запит: --sizes 1000,100000,10000000" << std::endl;
+            return 1;
+        }
+    }
+
+    // Діагностика менеджерів (відхилені бронювання, деструктори) іде через журнал -
+    // вимикаємо його, щоб не спотворювати вимірювання; решту виводу в std::cout
+    // і std::cerr приглушуємо, щоб stdout містив лише JSON
+    Logger::setLevel(LogLevel::Off);
+    std::ostream results(std::cout.rdbuf());
+    std::ostream progress(std::cerr.rdbuf());
+    std::cout.setstate(std::ios_base::badbit);
+    std::cerr.setstate(std::ios_base::badbit);
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "coursework1-benchmark";
+    std::filesystem::create_directories(directory);
+
+    std::vector<Measurement> measurements;
+    try {
+        for (size_t size : sizes) {
+            progress << "Розмір " << size << "..." << std::endl;
+            runSuite(size, minSeconds, directory, measurements);
+        }
+    }
+    catch (const std::exception& e) {
+        progress << "Помилка бенчмарку: " << e.what() << std::endl;
+        std::filesystem::remove_all(directory);
+        return 1;
+    }
+    std::filesystem::remove_all(directory);
+
+    if (outputPath.empty()) {
+        writeJson(results, measurements, minSeconds);
+    }
+    else {
+        std::ofstream file(outputPath);
+        writeJson(file, measurements, minSeconds);
+    }
+
+    std::cout.clear();
+    std::cerr.clear();
+    return 0;
+}
@@ -0,0 +1,114 @@
+﻿#include "Amenity.h"
+#include <cctype>
+
+namespace {
+    const std::string AMENITY_NAMES[static_cast<int>(Amenity::Count)] = {
+        "WiFi",
+        "Parking",
+        "Breakfast",
+        "SPA",
+        "Pool",
+        "Restaurant",
+        "Gym",
+        "Bar",
+        "Transfer",
+        "Conference",
+        "Laundry",
+        "RoomService"
+    };
+
+    bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) !=
+                std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+AmenityMask AmenityDictionary::bit(Amenity amenity) {
+    return AmenityMask(1) << static_cast<int>(amenity);
+}
+
+const std::string& AmenityDictionary::nameOf(Amenity amenity) {
+    static const std::string unknown = "Unknown";
+    int index = static_cast<int>(amenity);
+    return index < static_cast<int>(Amenity::Count) ? AMENITY_NAMES[index] : unknown;
+}
+
+bool AmenityDictionary::lookup(const std::string& name, Amenity& amenity) {
+    for (int i = 0; i < static_cast<int>(Amenity::Count); ++i) {
+        if (equalsIgnoreCase(name, AMENITY_NAMES[i])) {
+            amenity = static_cast<Amenity>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+AmenityMask AmenityDictionary::parseList(const std::string& list, char delimiter) {
+    AmenityMask mask = 0;
+    size_t start = 0;
+
+    while (start <= list.size()) {
+        size_t end = list.find(delimiter, start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+
+        Amenity amenity;
+        if (end > start && lookup(list.substr(start, end - start), amenity)) {
+            mask |= bit(amenity);
+        }
+
+        start = end + 1;
+    }
+
+    return mask;
+}
+
+std::vector<std::string> AmenityDictionary::names(AmenityMask mask) {
+    std::vector<std::string> result;
+    for (int i = 0; i < static_cast<int>(Amenity::Count); ++i) {
+        if (mask & (AmenityMask(1) << i)) {
+            result.push_back(AMENITY_NAMES[i]);
+        }
+    }
+    return result;
+}
+
+std::string AmenityDictionary::toHex(AmenityMask mask) {
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+
+    do {
+        result.insert(result.begin(), digits[mask & 0xF]);
+        mask >>= 4;
+    } while (mask != 0);
+
+    return "0x" + result;
+}
+
+bool AmenityDictionary::fromHex(const std::string& text, AmenityMask& mask) {
+    if (text.size() < 3 || text.size() > 18 || text[0] != '0' || (text[1] != 'x' && text[1] != 'X')) {
+        return false;
+    }
+
+    AmenityMask value = 0;
+    for (size_t i = 2; i < text.size(); ++i) {
+        char ch = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+        int digit;
+        if (ch >= '0' && ch <= '9') digit = ch - '0';
+        else if (ch >= 'a' && ch <= 'f') digit = ch - 'a' + 10;
+        else return false;
+        value = (value << 4) | static_cast<AmenityMask>(digit);
+    }
+
+    mask = value;
+    return true;
+}
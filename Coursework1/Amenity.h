@@ -0,0 +1,95 @@
+﻿#ifndef AMENITY_H
+#define AMENITY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Набір зручностей готелю як бітова маска фіксованої ширини
+ */
+typedef std::uint64_t AmenityMask;
+
+/**
+ * @enum Amenity
+ * @brief Зручності з єдиного словника (значення - номер біта в масці)
+ */
+enum class Amenity : std::uint8_t {
+    WiFi,
+    Parking,
+    Breakfast,
+    Spa,
+    Pool,
+    Restaurant,
+    Gym,
+    Bar,
+    Transfer,
+    Conference,
+    Laundry,
+    RoomService,
+    Count
+};
+
+/**
+ * @class AmenityDictionary
+ * @brief Єдиний словник зручностей для всіх типів готелів
+ *
+ * Перетворює назви на біти маски і назад; маска зберігається у файлі
+ * каталогу як шістнадцяткове число замість текстового переліку.
+ */
+class AmenityDictionary {
+public:
+    /**
+     * @brief Отримує біт маски для зручності
+     * @param amenity Зручність
+     * @return Маска з одним встановленим бітом
+     */
+    static AmenityMask bit(Amenity amenity);
+
+    /**
+     * @brief Отримує назву зручності
+     * @param amenity Зручність
+     * @return Назва (WiFi, SPA, Pool...)
+     */
+    static const std::string& nameOf(Amenity amenity);
+
+    /**
+     * @brief Шукає зручність за назвою (без урахування регістру латиниці)
+     * @param name Назва
+     * @param amenity Знайдена зручність
+     * @return true якщо назву знайдено у словнику
+     */
+    static bool lookup(const std::string& name, Amenity& amenity);
+
+    /**
+     * @brief Розбирає перелік назв через роздільник у маску
+     * @param list Перелік, напр. "SPA;Pool;Restaurant"
+     * @param delimiter Роздільник
+     * @return Маска (невідомі назви пропускаються)
+     */
+    static AmenityMask parseList(const std::string& list, char delimiter = ';');
+
+    /**
+     * @brief Отримує назви зручностей з маски у порядку словника
+     * @param mask Маска
+     * @return Вектор назв
+     */
+    static std::vector<std::string> names(AmenityMask mask);
+
+    /**
+     * @brief Форматує маску як шістнадцяткове число (напр. 0x38)
+     * @param mask Маска
+     * @return Рядок
+     */
+    static std::string toHex(AmenityMask mask);
+
+    /**
+     * @brief Розбирає шістнадцяткову маску
+     * @param text Рядок виду 0x...
+     * @param mask Результат
+     * @return true якщо рядок коректний
+     */
+    static bool fromHex(const std::string& text, AmenityMask& mask);
+};
+
+#endif // AMENITY_H
@@ -0,0 +1,359 @@
+﻿#include "BatchRunner.h"
+#include "Amenity.h"
+#include "Json.h"
+#include "Constants.hpp"
+#include <sstream>
+#include <charconv>
+
+namespace {
+    // Розбиває рядок команди за комами (порожні поля зберігаються)
+    void splitCommand(const std::string& line, std::vector<std::string>& tokens) {
+        tokens.clear();
+        size_t start = 0;
+        while (true) {
+            size_t comma = line.find(',', start);
+            tokens.push_back(line.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+            if (comma == std::string::npos) {
+                break;
+            }
+            start = comma + 1;
+        }
+    }
+
+    bool parseInt(const std::string& text, int& value) {
+        const char* last = text.data() + text.size();
+        std::from_chars_result parsed = std::from_chars(text.data(), last, value);
+        return parsed.ec == std::errc() && parsed.ptr == last;
+    }
+
+    template <typename T, typename IdGetter>
+    std::string idList(const std::vector<T>& items, IdGetter getId) {
+        std::string result = "\"count\":" + std::to_string(items.size()) + ",\"ids\":[";
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (i > 0) {
+                result += ',';
+            }
+            result += std::to_string(getId(items[i]));
+        }
+        result += ']';
+        return result;
+    }
+}
+
+// Конструктор з параметрами
+BatchRunner::BatchRunner(UserAccountManager& userManager, HotelManager& hotelManager,
+    BookingManager& bookingManager, std::ostream& out)
+    : userManager(userManager), hotelManager(hotelManager), bookingManager(bookingManager),
+    out(out), commandCount(0), failedCount(0) {
+}
+
+// Деструктор
+BatchRunner::~BatchRunner() {
+}
+
+// Getters
+std::uint64_t BatchRunner::getCommandCount() const {
+    return commandCount;
+}
+
+std::uint64_t BatchRunner::getFailedCount() const {
+    return failedCount;
+}
+
+// Власні методи
+
+bool BatchRunner::run(std::istream& input) {
+    bool previousAutoSave = bookingManager.getAutoSave();
+    bookingManager.setAutoSave(false);
+
+    std::string line;
+    std::vector<std::string> tokens;
+    size_t lineNumber = 0;
+
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        splitCommand(line, tokens);
+
+        auto start = std::chrono::steady_clock::now();
+        Result result;
+        try {
+            result = execute(tokens);
+        }
+        catch (const std::exception& e) {
+            result.ok = false;
+            result.error = "exception";
+            result.fields = "\"message\":" + Json::quote(e.what());
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        writeResult(lineNumber, tokens[0], result, elapsed);
+    }
+
+    bookingManager.setAutoSave(previousAutoSave);
+    bool saved = bookingManager.saveBookings();
+    return saved && failedCount == 0;
+}
+
+BatchRunner::Result BatchRunner::execute(const std::vector<std::string>& tokens) {
+    const std::string& command = tokens[0];
+
+    if (command == "login") {
+        return login(tokens);
+    }
+
+    Result result;
+    if (!userManager.getCurrentUser()) {
+        result.error = "not_authenticated";
+        return result;
+    }
+
+    if (command == "create") return create(tokens);
+    if (command == "cancel") return changeStatus(tokens, false);
+    if (command == "complete") return changeStatus(tokens, true);
+    if (command == "search") return searchHotels(tokens);
+    if (command == "bookings") return searchBookings(tokens);
+    if (command == "revenue") return revenue();
+    if (command == "save") return save();
+
+    result.error = "unknown_command";
+    return result;
+}
+
+BatchRunner::Result BatchRunner::login(const std::vector<std::string>& tokens) {
+    Result result;
+    if (tokens.size() != 3) {
+        result.error = "syntax";
+        return result;
+    }
+
+    result.ok = userManager.login(tokens[1], tokens[2]);
+    if (result.ok) {
+        result.fields = "\"admin\":" + std::string(userManager.isCurrentUserAdmin() ? "true" : "false");
+    }
+    else {
+        result.error = "login_failed";
+    }
+    return result;
+}
+
+BatchRunner::Result BatchRunner::create(const std::vector<std::string>& tokens) {
+    Result result;
+    int hotelId = 0;
+    int roomNumber = 0;
+
+    if (tokens.size() != 7 || !parseInt(tokens[1], hotelId) || !parseInt(tokens[2], roomNumber)) {
+        result.error = "syntax";
+        return result;
+    }
+
+    int bookingId = bookingManager.getNextBookingId();
+    result.ok = bookingManager.createBooking(hotelId, roomNumber,
+        tokens[3], tokens[4], tokens[5], tokens[6]);
+
+    if (result.ok) {
+        Booking* booking = bookingManager.findBooking(bookingId);
+        result.fields = "\"id\":" + std::to_string(bookingId);
+        if (booking) {
+            result.fields += ",\"total\":\"" + booking->getTotalPrice().toString() + "\"";
+        }
+    }
+    else {
+        result.error = "rejected";
+    }
+    return result;
+}
+
+BatchRunner::Result BatchRunner::changeStatus(const std::vector<std::string>& tokens, bool complete) {
+    Result result;
+    int bookingId = 0;
+
+    if (tokens.size() != 2 || !parseInt(tokens[1], bookingId)) {
+        result.error = "syntax";
+        return result;
+    }
+
+    // Завершення бронювання - адміністративна дія, скасування доступне всім
+    if (complete && !userManager.isCurrentUserAdmin()) {
+        result.error = "access_denied";
+        return result;
+    }
+
+    result.ok = complete ? bookingManager.completeBooking(bookingId)
+        : bookingManager.cancelBooking(bookingId);
+    result.fields = "\"id\":" + std::to_string(bookingId);
+    if (!result.ok) {
+        result.error = "not_found";
+    }
+    return result;
+}
+
+BatchRunner::Result BatchRunner::searchHotels(const std::vector<std::string>& tokens) {
+    Result result;
+    if (tokens.size() < 3) {
+        result.error = "syntax";
+        return result;
+    }
+
+    const std::string& field = tokens[1];
+    std::vector<std::shared_ptr<HotelBase>> hotels;
+
+    if (field == "city" && tokens.size() == 3) {
+        hotels = hotelManager.findHotelsByCity(tokens[2]);
+    }
+    else if (field == "type" && tokens.size() == 3) {
+        hotels = hotelManager.findHotelsByType(tokens[2]);
+    }
+    else if (field == "stars" && tokens.size() == 3) {
+        int stars = 0;
+        if (!parseInt(tokens[2], stars)) {
+            result.error = "syntax";
+            return result;
+        }
+        hotels = hotelManager.findHotelsByStars(stars);
+    }
+    else if (field == "prefix" && tokens.size() == 3) {
+        hotels = hotelManager.suggestHotels(tokens[2]);
+    }
+    else if (field == "amenities" && tokens.size() == 3) {
+        AmenityMask required = AmenityDictionary::parseList(tokens[2]);
+        if (required == 0) {
+            result.error = "syntax";
+            return result;
+        }
+        hotels = hotelManager.findHotelsWithAmenities(required);
+    }
+    else if (field == "rooms" && tokens.size() == 6) {
+        int capacity = 0;
+        Money maxPrice;
+        if (!parseInt(tokens[4], capacity) || !Money::parse(tokens[5], maxPrice)) {
+            result.error = "syntax";
+            return result;
+        }
+        hotels = hotelManager.findAvailableRooms(tokens[2], tokens[3], capacity, maxPrice.toHryvnias());
+    }
+    else {
+        result.error = "syntax";
+        return result;
+    }
+
+    result.ok = true;
+    result.fields = idList(hotels, [](const std::shared_ptr<HotelBase>& hotel) {
+        return hotel->getHotelId();
+    });
+    return result;
+}
+
+BatchRunner::Result BatchRunner::searchBookings(const std::vector<std::string>& tokens) {
+    Result result;
+    if (tokens.size() != 3) {
+        result.error = "syntax";
+        return result;
+    }
+
+    const std::string& field = tokens[1];
+    std::vector<Booking> bookings;
+
+    if (field == "client") {
+        bookings = bookingManager.findBookingsByClient(tokens[2]);
+    }
+    else if (field == "passport") {
+        bookings = bookingManager.findBookingsByPassport(tokens[2]);
+    }
+    else if (field == "status") {
+        bookings = bookingManager.findBookingsByStatus(tokens[2]);
+    }
+    else if (field == "hotel") {
+        int hotelId = 0;
+        if (!parseInt(tokens[2], hotelId)) {
+            result.error = "syntax";
+            return result;
+        }
+        bookings = bookingManager.findBookingsByHotel(hotelId);
+    }
+    else {
+        result.error = "syntax";
+        return result;
+    }
+
+    result.ok = true;
+    result.fields = idList(bookings, [](const Booking& booking) {
+        return booking.getBookingId();
+    });
+    return result;
+}
+
+BatchRunner::Result BatchRunner::revenue() {
+    Result result;
+    result.ok = true;
+    result.fields = "\"revenue\":\"" + bookingManager.calculateTotalRevenue().toString() +
+        "\",\"bookings\":" + std::to_string(bookingManager.getBookingCount());
+    return result;
+}
+
+BatchRunner::Result BatchRunner::save() {
+    Result result;
+    result.ok = hotelManager.saveHotels() && bookingManager.saveBookings() && userManager.saveUsers();
+    if (!result.ok) {
+        result.error = "io";
+    }
+    return result;
+}
+
+void BatchRunner::writeResult(size_t lineNumber, const std::string& command,
+    const Result& result, std::chrono::nanoseconds elapsed) {
+    CommandStats& entry = stats[command];
+    entry.count++;
+    entry.total += elapsed;
+    if (elapsed > entry.max) {
+        entry.max = elapsed;
+    }
+
+    commandCount++;
+    if (!result.ok) {
+        entry.failed++;
+        failedCount++;
+    }
+
+    out << "{\"line\":" << lineNumber << ",\"cmd\":" << Json::quote(command)
+        << ",\"ok\":" << (result.ok ? "true" : "false");
+    if (!result.error.empty()) {
+        out << ",\"error\":\"" << result.error << "\"";
+    }
+    if (!result.fields.empty()) {
+        out << "," << result.fields;
+    }
+    out << ",\"ns\":" << elapsed.count() << "}\n";
+}
+
+void BatchRunner::writeSummary(std::chrono::nanoseconds elapsed) {
+    double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::ostringstream summary;
+    summary << "{\"summary\":{\"commands\":" << commandCount
+        << ",\"failed\":" << failedCount
+        << ",\"elapsedNs\":" << elapsed.count()
+        << ",\"opsPerSec\":" << static_cast<std::int64_t>(seconds > 0 ? commandCount / seconds : 0)
+        << ",\"byCommand\":{";
+
+    bool first = true;
+    for (const auto& entry : stats) {
+        const CommandStats& command = entry.second;
+        summary << (first ? "" : ",") << Json::quote(entry.first)
+            << ":{\"count\":" << command.count
+            << ",\"failed\":" << command.failed
+            << ",\"totalNs\":" << command.total.count()
+            << ",\"avgNs\":" << command.total.count() / static_cast<std::int64_t>(command.count)
+            << ",\"maxNs\":" << command.max.count() << "}";
+        first = false;
+    }
+    summary << "}}}";
+
+    out << summary.str() << std::endl;
+}
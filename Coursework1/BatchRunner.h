@@ -0,0 +1,112 @@
+﻿#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "UserAccountManager.h"
+#include "HotelManager.h"
+#include "BookingManager.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class BatchRunner
+ * @brief Неінтерактивне виконання сценарію команд над менеджерами
+ *
+ * Кожен рядок сценарію - одна команда, поля розділені комами:
+ *   login,<логін>,<пароль>
+ *   create,<id готелю>,<номер>,<клієнт>,<паспорт>,<заїзд>,<виїзд>
+ *   cancel,<id бронювання>
+ *   complete,<id бронювання>
+ *   search,city|type|stars|prefix|amenities,<значення>
+ *   search,rooms,<місто>,<клас>,<місткість>,<макс. ціна>
+ *   bookings,client|passport|hotel|status,<значення>
+ *   revenue
+ *   save
+ * Порожні рядки та рядки, що починаються з '#', пропускаються.
+ *
+ * На кожну команду виводиться один рядок JSON з результатом і тривалістю (нс),
+ * наприкінці - рядок "summary" з кількістю, помилками та часом за командами.
+ */
+class BatchRunner {
+private:
+    /**
+     * @struct CommandStats
+     * @brief Накопичена статистика однієї команди
+     */
+    struct CommandStats {
+        std::uint64_t count = 0;
+        std::uint64_t failed = 0;
+        std::chrono::nanoseconds total{ 0 };
+        std::chrono::nanoseconds max{ 0 };
+    };
+
+    /**
+     * @struct Result
+     * @brief Результат команди: успіх, код помилки та готові JSON-поля
+     */
+    struct Result {
+        bool ok = false;
+        std::string error;
+        std::string fields;
+    };
+
+    UserAccountManager& userManager;
+    HotelManager& hotelManager;
+    BookingManager& bookingManager;
+    std::ostream& out;
+
+    std::map<std::string, CommandStats> stats;
+    std::uint64_t commandCount;
+    std::uint64_t failedCount;
+
+    Result execute(const std::vector<std::string>& tokens);
+    Result login(const std::vector<std::string>& tokens);
+    Result create(const std::vector<std::string>& tokens);
+    Result changeStatus(const std::vector<std::string>& tokens, bool complete);
+    Result searchHotels(const std::vector<std::string>& tokens);
+    Result searchBookings(const std::vector<std::string>& tokens);
+    Result revenue();
+    Result save();
+
+    void writeResult(size_t lineNumber, const std::string& command,
+        const Result& result, std::chrono::nanoseconds elapsed);
+
+public:
+    // Конструктори
+    BatchRunner(UserAccountManager& userManager, HotelManager& hotelManager,
+        BookingManager& bookingManager, std::ostream& out);
+    BatchRunner(const BatchRunner& other) = delete;
+    BatchRunner(BatchRunner&& other) = delete;
+
+    // Деструктор
+    ~BatchRunner();
+
+    // Оператори присвоєння
+    BatchRunner& operator=(const BatchRunner& other) = delete;
+    BatchRunner& operator=(BatchRunner&& other) = delete;
+
+    // Getters
+    std::uint64_t getCommandCount() const;
+    std::uint64_t getFailedCount() const;
+
+    /**
+     * @brief Виконує всі команди з потоку
+     *
+     * Автозбереження бронювань на час виконання вимикається; файл
+     * записується командою save та один раз після останньої команди.
+     * @param input Потік сценарію (файл або стандартний ввід)
+     * @return true якщо всі команди виконано успішно, false в іншому випадку
+     */
+    bool run(std::istream& input);
+
+    /**
+     * @brief Виводить підсумковий рядок зі статистикою часу за командами
+     * @param elapsed Загальний час виконання сценарію
+     */
+    void writeSummary(std::chrono::nanoseconds elapsed);
+};
+
+#endif // BATCHRUNNER_H
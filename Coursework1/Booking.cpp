@@ -1,13 +1,13 @@
 ﻿#include "Booking.h"
 #include "Constants.hpp"
 #include <sstream>
-#include <iomanip>
 #include <algorithm>
 
 // Конструктор за замовчуванням
 Booking::Booking()
     : bookingId(0), hotelId(0), roomNumber(0), clientName(""), passport(""),
-    checkInDate(""), checkOutDate(""), status(BOOKING_STATUS_ACTIVE), totalPrice(0.0) {
+    checkInDate(""), checkOutDate(""), status(BOOKING_STATUS_ACTIVE), totalPrice(),
+    roomClass(RoomClass::Unknown) {
 }
 
 // Конструктор з параметрами
@@ -16,14 +16,16 @@ Booking::Booking(int bookingId, int hotelId, int roomNumber,
     const std::string& checkIn, const std::string& checkOut)
     : bookingId(bookingId), hotelId(hotelId), roomNumber(roomNumber),
     clientName(clientName), passport(passport), checkInDate(checkIn),
-    checkOutDate(checkOut), status(BOOKING_STATUS_ACTIVE), totalPrice(0.0) {
+    checkOutDate(checkOut), status(BOOKING_STATUS_ACTIVE), totalPrice(),
+    roomClass(RoomClass::Unknown) {
 }
 
 // Копіювальний конструктор
 Booking::Booking(const Booking& other)
     : bookingId(other.bookingId), hotelId(other.hotelId), roomNumber(other.roomNumber),
     clientName(other.clientName), passport(other.passport), checkInDate(other.checkInDate),
-    checkOutDate(other.checkOutDate), status(other.status), totalPrice(other.totalPrice) {
+    checkOutDate(other.checkOutDate), status(other.status), totalPrice(other.totalPrice),
+    roomClass(other.roomClass) {
 }
 
 // Переміщувальний конструктор
@@ -31,7 +33,7 @@ Booking::Booking(Booking&& other) noexcept
     : bookingId(other.bookingId), hotelId(other.hotelId), roomNumber(other.roomNumber),
     clientName(std::move(other.clientName)), passport(std::move(other.passport)),
     checkInDate(std::move(other.checkInDate)), checkOutDate(std::move(other.checkOutDate)),
-    status(std::move(other.status)), totalPrice(other.totalPrice) {
+    status(std::move(other.status)), totalPrice(other.totalPrice), roomClass(other.roomClass) {
 }
 
 // Деструктор
@@ -51,6 +53,7 @@ Booking& Booking::operator=(const Booking& other) {
         checkOutDate = other.checkOutDate;
         status = other.status;
         totalPrice = other.totalPrice;
+        roomClass = other.roomClass;
     }
     return *this;
 }
@@ -67,6 +70,7 @@ Booking& Booking::operator=(Booking&& other) noexcept {
         checkOutDate = std::move(other.checkOutDate);
         status = std::move(other.status);
         totalPrice = other.totalPrice;
+        roomClass = other.roomClass;
     }
     return *this;
 }
@@ -104,10 +108,14 @@ std::string Booking::getStatus() const {
     return status;
 }
 
-double Booking::getTotalPrice() const {
+Money Booking::getTotalPrice() const {
     return totalPrice;
 }
 
+RoomClass Booking::getRoomClassId() const {
+    return roomClass;
+}
+
 // Setters
 void Booking::setBookingId(int id) {
     this->bookingId = id;
@@ -141,10 +149,14 @@ void Booking::setStatus(const std::string& status) {
     this->status = status;
 }
 
-void Booking::setTotalPrice(double price) {
+void Booking::setTotalPrice(Money price) {
     this->totalPrice = price;
 }
 
+void Booking::setRoomClass(RoomClass roomClass) {
+    this->roomClass = roomClass;
+}
+
 // Власні методи
 
 void Booking::displayInfo() const {
@@ -156,8 +168,7 @@ void Booking::displayInfo() const {
     std::cout << "Заїзд: " << checkInDate << std::endl;
     std::cout << "Виїзд: " << checkOutDate << std::endl;
     std::cout << "Статус: " << status << std::endl;
-    std::cout << "Вартість: " << std::fixed << std::setprecision(2)
-        << totalPrice << " грн" << std::endl;
+    std::cout << "Вартість: " << totalPrice << " грн" << std::endl;
     std::cout << "Кількість ночей: " << calculateNights() << std::endl;
 }
 
@@ -174,11 +185,11 @@ bool Booking::validate() const {
         return false;
     }
 
-    if (checkInDate >= checkOutDate) {
+    if (dateKey(checkInDate) == 0 || dateKey(checkInDate) >= dateKey(checkOutDate)) {
         return false;
     }
 
-    if (totalPrice < 0) {
+    if (totalPrice < Money()) {
         return false;
     }
 
@@ -186,25 +197,13 @@ bool Booking::validate() const {
 }
 
 int Booking::calculateNights() const {
-    // Спрощена реалізація - в реальному проекті потрібна бібліотека для дат
-    // Припускаємо формат DD.MM.YYYY
-
-    int dayIn = 0, monthIn = 0, yearIn = 0;
-    int dayOut = 0, monthOut = 0, yearOut = 0;
-
-    // Використання std::stringstream для парсингу дат
-    std::stringstream ssIn(checkInDate);
-    std::stringstream ssOut(checkOutDate);
-    char delimiter;
-
-    ssIn >> dayIn >> delimiter >> monthIn >> delimiter >> yearIn;
-    ssOut >> dayOut >> delimiter >> monthOut >> delimiter >> yearOut;
-
-    // Приблизний розрахунок (можна покращити)
-    int totalDaysIn = yearIn * 365 + monthIn * 30 + dayIn;
-    int totalDaysOut = yearOut * 365 + monthOut * 30 + dayOut;
-
-    return totalDaysOut - totalDaysIn;
+    // Точна кількість календарних ночей - та сама, що в аналітиці й кубі
+    int dayIn = 0;
+    int dayOut = 0;
+    if (!parseDayNumber(checkInDate, dayIn) || !parseDayNumber(checkOutDate, dayOut)) {
+        return 0;
+    }
+    return dayOut - dayIn;
 }
 
 void Booking::activate() {
@@ -228,10 +227,8 @@ bool Booking::overlaps(const std::string& checkIn, const std::string& checkOut)
         return false;
     }
 
-    // Спрощена перевірка перекриття дат
-    // В реальному проекті потрібна краща логіка порівняння дат
-
-    return !(checkOut <= checkInDate || checkIn >= checkOutDate);
+    // Рядки DD.MM.YYYY не впорядковані хронологічно, тож порівнюються ключі
+    return !(dateKey(checkOut) <= dateKey(checkInDate) || dateKey(checkIn) >= dateKey(checkOutDate));
 }
 
 std::string Booking::getDetailedDescription() const {
@@ -243,4 +240,62 @@ std::string Booking::getDetailedDescription() const {
         << " | " << checkInDate << " - " << checkOutDate
         << " | Статус: " << status;
     return ss.str();
-}
\ No newline at end of file
+}
+
+int Booking::dateKey(const std::string& date) {
+    int parts[3] = { 0, 0, 0 };
+    size_t part = 0;
+    bool hasDigits = false;
+
+    for (char symbol : date) {
+        if (symbol >= '0' && symbol <= '9') {
+            parts[part] = parts[part] * 10 + (symbol - '0');
+            hasDigits = true;
+        }
+        else if (symbol == '.' && hasDigits && part < 2) {
+            ++part;
+            hasDigits = false;
+        }
+        else {
+            return 0;
+        }
+    }
+
+    if (part != 2 || !hasDigits || parts[0] < 1 || parts[0] > 31 || parts[1] < 1 || parts[1] > 12 ||
+        parts[2] > 9999) {
+        return 0;
+    }
+    return parts[2] * 10000 + parts[1] * 100 + parts[0];
+}
+
+int Booking::dayNumber(int year, int month, int day) {
+    // Алгоритм days_from_civil: рік зсунуто так, щоб лютий був останнім місяцем
+    year -= month <= 2 ? 1 : 0;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void Booking::civilDate(int dayNumber, int& year, int& month, int& day) {
+    // Алгоритм civil_from_days, обернений до dayNumber
+    dayNumber += 719468;
+    int era = (dayNumber >= 0 ? dayNumber : dayNumber - 146096) / 146097;
+    int dayOfEra = dayNumber - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+bool Booking::parseDayNumber(const std::string& date, int& day) {
+    int key = dateKey(date);
+    if (key == 0) {
+        return false;
+    }
+    day = dayNumber(key / 10000, key / 100 % 100, key % 100);
+    return true;
+}
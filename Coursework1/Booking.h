@@ -1,6 +1,8 @@
 ﻿#ifndef BOOKING_H
 #define BOOKING_H
 
+#include "Money.h"
+#include "Room.h"
 #include <string>
 #include <iostream>
 
@@ -20,7 +22,8 @@ private:
     std::string checkInDate;
     std::string checkOutDate;
     std::string status;
-    double totalPrice;
+    Money totalPrice;
+    RoomClass roomClass;        // Клас заброньованого номера (не зберігається у файлі)
 
 public:
     // Конструктори
@@ -47,7 +50,8 @@ public:
     std::string getCheckInDate() const;
     std::string getCheckOutDate() const;
     std::string getStatus() const;
-    double getTotalPrice() const;
+    Money getTotalPrice() const;
+    RoomClass getRoomClassId() const;
 
     // Setters
     void setBookingId(int id);
@@ -58,7 +62,8 @@ public:
     void setCheckInDate(const std::string& date);
     void setCheckOutDate(const std::string& date);
     void setStatus(const std::string& status);
-    void setTotalPrice(double price);
+    void setTotalPrice(Money price);
+    void setRoomClass(RoomClass roomClass);
 
     // Власні методи (мінімум 5)
 
@@ -113,6 +118,39 @@ public:
      * @return Рядок з описом
      */
     std::string getDetailedDescription() const;
+
+    /**
+     * @brief Перетворює дату DD.MM.YYYY на ключ YYYYMMDD для порівняння
+     * @param date Дата у форматі застосунку
+     * @return Ключ дати або 0, якщо дата некоректна
+     */
+    static int dateKey(const std::string& date);
+
+    /**
+     * @brief Номер календарного дня від 01.01.1970 (григоріанський календар)
+     * @param year Рік
+     * @param month Місяць (1-12)
+     * @param day День місяця
+     * @return Номер дня (різниця номерів - кількість ночей)
+     */
+    static int dayNumber(int year, int month, int day);
+
+    /**
+     * @brief Календарна дата за номером дня (обернене до dayNumber)
+     * @param dayNumber Номер дня від 01.01.1970
+     * @param year Рік
+     * @param month Місяць (1-12)
+     * @param day День місяця
+     */
+    static void civilDate(int dayNumber, int& year, int& month, int& day);
+
+    /**
+     * @brief Перетворює дату DD.MM.YYYY на номер календарного дня
+     * @param date Дата у форматі застосунку
+     * @param day Номер дня
+     * @return true якщо дата коректна
+     */
+    static bool parseDayNumber(const std::string& date, int& day);
 };
 
 #endif // BOOKING_H
\ No newline at end of file
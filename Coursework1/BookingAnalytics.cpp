@@ -0,0 +1,447 @@
+﻿#include "BookingAnalytics.h"
+#include "Constants.hpp"
+#include "Logger.h"
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <system_error>
+#include <unordered_map>
+
+namespace {
+    // Перший день місяця з індексом рік * 12 + (місяць - 1)
+    int monthStartDay(int monthIndex) {
+        return Booking::dayNumber(monthIndex / 12, monthIndex % 12 + 1, 1);
+    }
+
+    // Індекс місяця, якому належить день
+    int monthIndexOfDay(int day) {
+        int year, month, dayOfMonth;
+        Booking::civilDate(day, year, month, dayOfMonth);
+        return year * 12 + month - 1;
+    }
+
+    /**
+     * @struct Partial
+     * @brief Часткові суми одного потоку
+     */
+    struct Partial {
+        std::vector<std::int64_t> hotelNights;
+        std::vector<std::int64_t> hotelRevenue;
+        std::vector<std::int64_t> classNights;
+        std::vector<std::int64_t> classRevenue;
+        std::size_t counted = 0;
+        std::size_t skipped = 0;
+    };
+
+    // Ключ номера (ID готелю, номер кімнати) для таблиці класів
+    std::int64_t roomKey(int hotelId, int roomNumber) {
+        return static_cast<std::int64_t>(hotelId) << 32 | static_cast<std::uint32_t>(roomNumber);
+    }
+}
+
+// KpiRow
+
+double KpiRow::occupancy() const {
+    return roomNightsAvailable > 0 ? static_cast<double>(roomNightsSold) / roomNightsAvailable : 0.0;
+}
+
+Money KpiRow::averageDailyRate() const {
+    return roomNightsSold > 0 ? Money(revenue.getKopecks() / roomNightsSold) : Money();
+}
+
+Money KpiRow::revenuePerAvailableRoom() const {
+    return roomNightsAvailable > 0 ? Money(revenue.getKopecks() / roomNightsAvailable) : Money();
+}
+
+// Конструктор за замовчуванням
+BookingAnalytics::BookingAnalytics()
+    : firstMonthIndex(0), monthCount(0), classRooms{ 0, 0, 0 }, countedBookings(0), skippedBookings(0) {
+}
+
+// Getters
+int BookingAnalytics::getFromMonth() const {
+    return monthCount > 0 ? monthKey(0) : 0;
+}
+
+int BookingAnalytics::getToMonth() const {
+    return monthCount > 0 ? monthKey(monthCount - 1) : 0;
+}
+
+std::size_t BookingAnalytics::getCountedBookings() const {
+    return countedBookings;
+}
+
+std::size_t BookingAnalytics::getSkippedBookings() const {
+    return skippedBookings;
+}
+
+// Власні методи
+
+int BookingAnalytics::daysInMonth(int month) const {
+    return monthStartDay(firstMonthIndex + month + 1) - monthStartDay(firstMonthIndex + month);
+}
+
+int BookingAnalytics::monthKey(int month) const {
+    int index = firstMonthIndex + month;
+    return (index / 12) * 100 + index % 12 + 1;
+}
+
+void BookingAnalytics::loadInventory(const std::vector<std::shared_ptr<HotelBase>>& hotels) {
+    for (const auto& hotel : hotels) {
+        hotelIds.push_back(hotel->getHotelId());
+        hotelCities.push_back(hotel->getCity());
+        hotelRooms.push_back(hotel->getRoomCount());
+
+        for (const Room& room : hotel->getRooms()) {
+            RoomClass roomClass = room.getRoomClassId();
+            if (roomClass != RoomClass::Unknown) {
+                classRooms[static_cast<int>(roomClass)]++;
+            }
+        }
+    }
+}
+
+bool BookingAnalytics::setPeriod(int fromMonth, int toMonth, bool hasStays, int firstDay, int lastDay) {
+    firstMonthIndex = 0;
+    monthCount = 0;
+    if ((fromMonth == 0 || toMonth == 0) && !hasStays) {
+        return false;
+    }
+
+    int first = fromMonth > 0 ? (fromMonth / 100) * 12 + fromMonth % 100 - 1 : monthIndexOfDay(firstDay);
+    int last = toMonth > 0 ? (toMonth / 100) * 12 + toMonth % 100 - 1 : monthIndexOfDay(lastDay);
+    if (last < first) {
+        return false;
+    }
+
+    firstMonthIndex = first;
+    monthCount = last - first + 1;
+    return true;
+}
+
+BookingAnalytics BookingAnalytics::fromCube(const BookingCube& cube,
+    const std::vector<std::shared_ptr<HotelBase>>& hotels, int fromMonth, int toMonth) {
+    BookingAnalytics result;
+    result.loadInventory(hotels);
+
+    int firstDay = 0;
+    int lastDay = 0;
+    bool hasStays = cube.getStayRange(firstDay, lastDay);
+    if (!result.setPeriod(fromMonth, toMonth, hasStays, firstDay, lastDay)) {
+        return result;
+    }
+
+    const size_t monthCount = static_cast<size_t>(result.monthCount);
+    std::vector<int> boundaries(monthCount + 1);
+    for (size_t m = 0; m <= monthCount; ++m) {
+        boundaries[m] = monthStartDay(result.firstMonthIndex + static_cast<int>(m));
+    }
+
+    result.hotelNights.assign(hotels.size() * monthCount, 0);
+    result.hotelRevenue.assign(hotels.size() * monthCount, 0);
+    result.classNights.assign(static_cast<size_t>(CLASS_COUNT) * monthCount, 0);
+    result.classRevenue.assign(static_cast<size_t>(CLASS_COUNT) * monthCount, 0);
+
+    std::vector<CubeTotals> totals;
+    for (size_t h = 0; h < result.hotelIds.size(); ++h) {
+        cube.series(result.hotelIds[h], "", boundaries, totals);
+        for (size_t m = 0; m < totals.size(); ++m) {
+            result.hotelNights[h * monthCount + m] = totals[m].bookedNights;
+            result.hotelRevenue[h * monthCount + m] = totals[m].revenue.getKopecks();
+        }
+    }
+
+    for (int c = 0; c < CLASS_COUNT; ++c) {
+        cube.series(0, Room::roomClassName(static_cast<RoomClass>(c)), boundaries, totals);
+        for (size_t m = 0; m < totals.size(); ++m) {
+            result.classNights[static_cast<size_t>(c) * monthCount + m] = totals[m].bookedNights;
+            result.classRevenue[static_cast<size_t>(c) * monthCount + m] = totals[m].revenue.getKopecks();
+        }
+    }
+    return result;
+}
+
+BookingAnalytics BookingAnalytics::compute(const std::vector<Booking>& bookings,
+    const std::vector<std::shared_ptr<HotelBase>>& hotels, int fromMonth, int toMonth) {
+    BookingAnalytics result;
+    result.loadInventory(hotels);
+
+    // Позиція готелю за ID і клас кожного номера, побудовані один раз
+    std::unordered_map<int, std::uint32_t> hotelPositions;
+    std::unordered_map<std::int64_t, RoomClass> roomClasses;
+    hotelPositions.reserve(hotels.size());
+    for (size_t h = 0; h < hotels.size(); ++h) {
+        int hotelId = hotels[h]->getHotelId();
+        hotelPositions[hotelId] = static_cast<std::uint32_t>(h);
+        for (const Room& room : hotels[h]->getRooms()) {
+            roomClasses[roomKey(hotelId, room.getRoomNumber())] = room.getRoomClassId();
+        }
+    }
+
+    // Межі періоду незалежні: незадана (0) береться з найранішого заїзду
+    // або останньої ночі, і лише тоді потрібен прохід по бронюваннях
+    int firstDay = 0;
+    int lastDay = 0;
+    bool found = false;
+    if (fromMonth == 0 || toMonth == 0) {
+        for (const Booking& booking : bookings) {
+            int checkIn = 0;
+            int checkOut = 0;
+            if (booking.getStatus() == BOOKING_STATUS_CANCELLED ||
+                !Booking::parseDayNumber(booking.getCheckInDate(), checkIn) ||
+                !Booking::parseDayNumber(booking.getCheckOutDate(), checkOut) ||
+                checkOut <= checkIn) {
+                continue;
+            }
+            firstDay = found ? std::min(firstDay, checkIn) : checkIn;
+            lastDay = found ? std::max(lastDay, checkOut - 1) : checkOut - 1;
+            found = true;
+        }
+    }
+    if (!result.setPeriod(fromMonth, toMonth, found, firstDay, lastDay)) {
+        return result;
+    }
+
+    const int monthCount = result.monthCount;
+    const int rangeStart = monthStartDay(result.firstMonthIndex);
+    const int rangeEnd = monthStartDay(result.firstMonthIndex + monthCount);
+    const int firstMonthIndex = result.firstMonthIndex;
+    const size_t hotelCells = hotels.size() * static_cast<size_t>(monthCount);
+    const size_t classCells = static_cast<size_t>(CLASS_COUNT) * monthCount;
+
+    // Кожен потік пише лише у свій Partial, тож синхронізація не потрібна
+    auto accumulate = [&](size_t first, size_t last, Partial& partial) {
+        partial.hotelNights.assign(hotelCells, 0);
+        partial.hotelRevenue.assign(hotelCells, 0);
+        partial.classNights.assign(classCells, 0);
+        partial.classRevenue.assign(classCells, 0);
+
+        for (size_t i = first; i < last; ++i) {
+            const Booking& booking = bookings[i];
+            if (booking.getStatus() == BOOKING_STATUS_CANCELLED) {
+                continue;
+            }
+
+            auto position = hotelPositions.find(booking.getHotelId());
+            int checkIn = 0;
+            int checkOut = 0;
+            if (position == hotelPositions.end() ||
+                !Booking::parseDayNumber(booking.getCheckInDate(), checkIn) ||
+                !Booking::parseDayNumber(booking.getCheckOutDate(), checkOut) ||
+                checkOut <= checkIn) {
+                partial.skipped++;
+                continue;
+            }
+
+            size_t hotel = position->second;
+            auto roomClassIt = roomClasses.find(roomKey(booking.getHotelId(), booking.getRoomNumber()));
+            RoomClass roomClass = roomClassIt != roomClasses.end() ? roomClassIt->second : RoomClass::Unknown;
+            std::int64_t total = booking.getTotalPrice().getKopecks();
+            std::int64_t nights = checkOut - checkIn;
+            partial.counted++;
+
+            // Ділимо проживання по місяцях; дохід частини [a, b) - різниця
+            // округлених часток, тож сума частин дорівнює вартості точно
+            int segmentStart = std::max(checkIn, rangeStart);
+            int stayEnd = std::min(checkOut, rangeEnd);
+            while (segmentStart < stayEnd) {
+                int monthIndex = monthIndexOfDay(segmentStart);
+                int segmentEnd = std::min(stayEnd, monthStartDay(monthIndex + 1));
+                std::int64_t share = total * (segmentEnd - checkIn) / nights - total * (segmentStart - checkIn) / nights;
+                std::int64_t segmentNights = segmentEnd - segmentStart;
+                size_t month = static_cast<size_t>(monthIndex - firstMonthIndex);
+
+                size_t hotelCell = hotel * monthCount + month;
+                partial.hotelNights[hotelCell] += segmentNights;
+                partial.hotelRevenue[hotelCell] += share;
+                if (roomClass != RoomClass::Unknown) {
+                    size_t classCell = static_cast<size_t>(roomClass) * monthCount + month;
+                    partial.classNights[classCell] += segmentNights;
+                    partial.classRevenue[classCell] += share;
+                }
+                segmentStart = segmentEnd;
+            }
+        }
+    };
+
+    size_t workerCount = std::max(1u, std::thread::hardware_concurrency());
+    // Кожен потік має отримати не менше бронювань, ніж клітинок у його Partial:
+    // інакше обнулення та злиття часткових сум коштують більше за сам прохід,
+    // а пам'ять під них росте як готелі x місяці x потоки
+    size_t perWorker = std::max(static_cast<size_t>(ANALYTICS_PARALLEL_MIN_BOOKINGS), hotelCells);
+    workerCount = std::max<size_t>(1, std::min(workerCount, bookings.size() / perWorker));
+    size_t chunk = (bookings.size() + workerCount - 1) / workerCount;
+    std::vector<Partial> partials(workerCount);
+    size_t usedPartials = 1;
+
+    if (workerCount == 1) {
+        accumulate(0, bookings.size(), partials[0]);
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        size_t assigned = 0;
+        for (size_t w = 0; w < workerCount; ++w) {
+            size_t first = std::min(w * chunk, bookings.size());
+            size_t last = std::min(first + chunk, bookings.size());
+            try {
+                workers.emplace_back([&accumulate, &partials, w, first, last]() {
+                    accumulate(first, last, partials[w]);
+                });
+            }
+            catch (const std::system_error& e) {
+                LOG_WARNING("Не вдалося запустити потік аналітики: " << e.what());
+                break;
+            }
+            assigned = last;
+        }
+
+        // Бронювання без потоку обробляє поточний потік у наступний вільний Partial
+        usedPartials = workers.size();
+        if (assigned < bookings.size()) {
+            accumulate(assigned, bookings.size(), partials[usedPartials++]);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Підсумовуємо часткові суми потоків
+    result.hotelNights.assign(hotelCells, 0);
+    result.hotelRevenue.assign(hotelCells, 0);
+    result.classNights.assign(classCells, 0);
+    result.classRevenue.assign(classCells, 0);
+    for (size_t p = 0; p < usedPartials; ++p) {
+        const Partial& partial = partials[p];
+        for (size_t i = 0; i < hotelCells; ++i) {
+            result.hotelNights[i] += partial.hotelNights[i];
+            result.hotelRevenue[i] += partial.hotelRevenue[i];
+        }
+        for (size_t i = 0; i < classCells; ++i) {
+            result.classNights[i] += partial.classNights[i];
+            result.classRevenue[i] += partial.classRevenue[i];
+        }
+        result.countedBookings += partial.counted;
+        result.skippedBookings += partial.skipped;
+    }
+    return result;
+}
+
+std::vector<KpiRow> BookingAnalytics::rows(KpiDimension dimension, bool byMonth) const {
+    std::vector<KpiRow> result;
+    int outputMonths = byMonth ? monthCount : (monthCount > 0 ? 1 : 0);
+
+    // Додає до рядка місяці [month, month + span) групи з rooms номерами
+    auto addMonths = [this](KpiRow& row, const std::vector<std::int64_t>& nights,
+        const std::vector<std::int64_t>& revenue, size_t group, std::int64_t rooms, int month, int span) {
+        for (int m = month; m < month + span; ++m) {
+            size_t cell = group * monthCount + m;
+            row.roomNightsSold += nights[cell];
+            row.revenue += Money(revenue[cell]);
+            row.roomNightsAvailable += rooms * daysInMonth(m);
+        }
+    };
+
+    for (int out = 0; out < outputMonths; ++out) {
+        int month = byMonth ? out : 0;
+        int span = byMonth ? 1 : monthCount;
+        int key = byMonth ? monthKey(out) : 0;
+
+        switch (dimension) {
+        case KpiDimension::Hotel:
+            for (size_t h = 0; h < hotelIds.size(); ++h) {
+                KpiRow row{ std::to_string(hotelIds[h]), key, 0, 0, Money() };
+                addMonths(row, hotelNights, hotelRevenue, h, hotelRooms[h], month, span);
+                result.push_back(row);
+            }
+            break;
+
+        case KpiDimension::City: {
+            std::map<std::string, KpiRow> cities;
+            for (size_t h = 0; h < hotelIds.size(); ++h) {
+                auto inserted = cities.emplace(hotelCities[h], KpiRow{ hotelCities[h], key, 0, 0, Money() });
+                addMonths(inserted.first->second, hotelNights, hotelRevenue, h, hotelRooms[h], month, span);
+            }
+            for (const auto& city : cities) {
+                result.push_back(city.second);
+            }
+            break;
+        }
+
+        case KpiDimension::RoomClass:
+            for (int c = 0; c < CLASS_COUNT; ++c) {
+                KpiRow row{ Room::roomClassName(static_cast<RoomClass>(c)), key, 0, 0, Money() };
+                addMonths(row, classNights, classRevenue, static_cast<size_t>(c), classRooms[c], month, span);
+                result.push_back(row);
+            }
+            break;
+
+        case KpiDimension::Total: {
+            KpiRow row{ "Усього", key, 0, 0, Money() };
+            for (size_t h = 0; h < hotelIds.size(); ++h) {
+                addMonths(row, hotelNights, hotelRevenue, h, hotelRooms[h], month, span);
+            }
+            result.push_back(row);
+            break;
+        }
+        }
+    }
+    return result;
+}
+
+std::vector<ReportColumn> BookingAnalytics::reportColumns() {
+    return {
+        { "key", "Група", 16 },
+        { "month", "Місяць", 7 },
+        { "room_nights_sold", "Продано", 9 },
+        { "room_nights_available", "Доступно", 9 },
+        { "occupancy_percent", "Завант.%", 8 },
+        { "adr", "ADR", 10 },
+        { "revpar", "RevPAR", 10 },
+        { "revenue", "Дохід", 14 }
+    };
+}
+
+void BookingAnalytics::writeReport(const std::vector<KpiRow>& rows, ReportWriter& writer) {
+    for (const KpiRow& row : rows) {
+        char month[8] = "";
+        if (row.month > 0) {
+            month[0] = static_cast<char>('0' + row.month / 100000 % 10);
+            month[1] = static_cast<char>('0' + row.month / 10000 % 10);
+            month[2] = static_cast<char>('0' + row.month / 1000 % 10);
+            month[3] = static_cast<char>('0' + row.month / 100 % 10);
+            month[4] = '-';
+            month[5] = static_cast<char>('0' + row.month / 10 % 10);
+            month[6] = static_cast<char>('0' + row.month % 10);
+        }
+
+        writer.field(row.key);
+        writer.field(std::string(month));
+        writer.field(row.roomNightsSold);
+        writer.field(row.roomNightsAvailable);
+        writer.field(row.occupancy() * 100.0, 2);
+        writer.field(row.averageDailyRate());
+        writer.field(row.revenuePerAvailableRoom());
+        writer.field(row.revenue);
+        writer.endRow();
+    }
+}
+
+bool BookingAnalytics::parseDimension(const std::string& name, KpiDimension& dimension) {
+    if (name == "hotel") {
+        dimension = KpiDimension::Hotel;
+    }
+    else if (name == "city") {
+        dimension = KpiDimension::City;
+    }
+    else if (name == "class") {
+        dimension = KpiDimension::RoomClass;
+    }
+    else if (name == "total") {
+        dimension = KpiDimension::Total;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+﻿#ifndef BOOKINGANALYTICS_H
+#define BOOKINGANALYTICS_H
+
+#include "Booking.h"
+#include "HotelBase.h"
+#include "ReportWriter.h"
+#include "BookingCube.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @enum KpiDimension
+ * @brief Розріз, за яким групуються показники
+ */
+enum class KpiDimension {
+    Hotel,
+    City,
+    RoomClass,
+    Total
+};
+
+/**
+ * @struct KpiRow
+ * @brief Показники однієї групи (готелю, міста, класу) за місяць або період
+ */
+struct KpiRow {
+    std::string key;                    // ID готелю, місто, клас номера або "Усього"
+    int month;                          // YYYYMM або 0 - весь період
+    std::int64_t roomNightsSold;
+    std::int64_t roomNightsAvailable;
+    Money revenue;
+
+    /**
+     * @brief Завантаженість: продані номеро-ночі / доступні (0..1)
+     */
+    double occupancy() const;
+
+    /**
+     * @brief ADR - середня ціна проданої номеро-ночі
+     */
+    Money averageDailyRate() const;
+
+    /**
+     * @brief RevPAR - дохід на доступну номеро-ніч
+     */
+    Money revenuePerAvailableRoom() const;
+};
+
+/**
+ * @class BookingAnalytics
+ * @brief Показники завантаженості, ADR та RevPAR за готелями, містами, класами й місяцями
+ *
+ * compute() за один паралельний прохід по бронюваннях накопичує продані
+ * номеро-ночі та дохід у локальних для потоку масивах "готель x місяць" і
+ * "клас x місяць", які потім підсумовуються. Проживання, що перетинає
+ * межу місяця, ділиться за календарними ночами, дохід - пропорційно ночам
+ * з точністю до копійки. Міста та загальні підсумки виводяться з масиву
+ * готелів, тож rows() для будь-якого розрізу не потребує нового проходу.
+ *
+ * Скасовані бронювання не враховуються. Доступні номеро-ночі рахуються за
+ * поточним складом номерів готелю для кожного дня місяця.
+ */
+class BookingAnalytics {
+private:
+    static const int CLASS_COUNT = 3;
+
+    int firstMonthIndex;                        // рік * 12 + (місяць - 1)
+    int monthCount;
+    std::vector<int> hotelIds;
+    std::vector<std::string> hotelCities;
+    std::vector<std::int64_t> hotelRooms;
+    std::int64_t classRooms[CLASS_COUNT];
+    std::vector<std::int64_t> hotelNights;      // готель x місяць
+    std::vector<std::int64_t> hotelRevenue;
+    std::vector<std::int64_t> classNights;      // клас x місяць
+    std::vector<std::int64_t> classRevenue;
+    std::size_t countedBookings;
+    std::size_t skippedBookings;
+
+    int daysInMonth(int month) const;
+    int monthKey(int month) const;
+
+    /**
+     * @brief Заповнює ID, міста, кількість номерів готелів і номерів за класами
+     */
+    void loadInventory(const std::vector<std::shared_ptr<HotelBase>>& hotels);
+
+    /**
+     * @brief Встановлює період; незадана межа (0) береться з днів [firstDay, lastDay]
+     * @return false якщо період порожній або fromMonth > toMonth
+     */
+    bool setPeriod(int fromMonth, int toMonth, bool hasStays, int firstDay, int lastDay);
+
+public:
+    // Конструктори
+    BookingAnalytics();
+
+    // Getters
+    int getFromMonth() const;
+    int getToMonth() const;
+    std::size_t getCountedBookings() const;
+    std::size_t getSkippedBookings() const;
+
+    /**
+     * @brief Обчислює показники
+     * @param bookings Бронювання
+     * @param hotels Каталог готелів (джерело міст, класів і кількості номерів)
+     * @param fromMonth Перший місяць YYYYMM (0 - відкритий початок: від найранішого заїзду)
+     * @param toMonth Останній місяць YYYYMM (0 - відкритий кінець: до останньої ночі)
+     * @return Накопичені показники (порожні, якщо fromMonth > toMonth)
+     */
+    static BookingAnalytics compute(const std::vector<Booking>& bookings,
+        const std::vector<std::shared_ptr<HotelBase>>& hotels,
+        int fromMonth = 0, int toMonth = 0);
+
+    /**
+     * @brief Будує ті самі показники з куба бронювань без проходу по бронюваннях
+     *
+     * Кожен готель і клас - одна префіксна сума на межу місяця, тож вартість
+     * залежить від кількості готелів і місяців, а не бронювань. Лічильники
+     * бронювань (getCountedBookings) куб не веде, вони лишаються нульовими.
+     * @param cube Куб бронювань
+     * @param hotels Каталог готелів
+     * @param fromMonth Перший місяць YYYYMM (0 - за найранішою ніччю в кубі)
+     * @param toMonth Останній місяць YYYYMM (0 - за найпізнішою ніччю в кубі)
+     * @return Показники (порожні, якщо період некоректний)
+     */
+    static BookingAnalytics fromCube(const BookingCube& cube,
+        const std::vector<std::shared_ptr<HotelBase>>& hotels,
+        int fromMonth = 0, int toMonth = 0);
+
+    /**
+     * @brief Формує рядки звіту для розрізу
+     * @param dimension Розріз
+     * @param byMonth true - окремий рядок на кожен місяць, false - за весь період
+     * @return Рядки у порядку каталогу (міста - за алфавітом)
+     */
+    std::vector<KpiRow> rows(KpiDimension dimension, bool byMonth) const;
+
+    /**
+     * @brief Колонки звіту показників
+     */
+    static std::vector<ReportColumn> reportColumns();
+
+    /**
+     * @brief Записує рядки показників у звіт
+     * @param rows Рядки
+     * @param writer Звіт, створений з колонками reportColumns()
+     */
+    static void writeReport(const std::vector<KpiRow>& rows, ReportWriter& writer);
+
+    /**
+     * @brief Розбирає назву розрізу (hotel, city, class, total)
+     * @param name Назва
+     * @param dimension Результат
+     * @return true якщо назва відома
+     */
+    static bool parseDimension(const std::string& name, KpiDimension& dimension);
+};
+
+#endif // BOOKINGANALYTICS_H
@@ -0,0 +1,347 @@
+﻿#include "BookingApi.h"
+#include "Amenity.h"
+#include "Json.h"
+#include "Constants.hpp"
+#include <charconv>
+
+namespace {
+    bool parseInt(const std::string& text, int& value) {
+        const char* last = text.data() + text.size();
+        std::from_chars_result parsed = std::from_chars(text.data(), last, value);
+        return parsed.ec == std::errc() && parsed.ptr == last;
+    }
+
+    HttpResponse error(int status, const std::string& code) {
+        HttpResponse response;
+        response.status = status;
+        response.body = "{\"error\":\"" + code + "\"}";
+        return response;
+    }
+
+    std::string param(const std::map<std::string, std::string>& values, const std::string& name) {
+        auto it = values.find(name);
+        return it == values.end() ? "" : it->second;
+    }
+
+    std::string hotelJson(const HotelBase& hotel) {
+        return "{\"id\":" + std::to_string(hotel.getHotelId()) +
+            ",\"name\":" + Json::quote(hotel.getName()) +
+            ",\"city\":" + Json::quote(hotel.getCity()) +
+            ",\"type\":" + Json::quote(hotel.getType()) +
+            ",\"stars\":" + std::to_string(hotel.getStars()) + "}";
+    }
+
+    std::string bookingJson(const Booking& booking) {
+        return "{\"id\":" + std::to_string(booking.getBookingId()) +
+            ",\"hotelId\":" + std::to_string(booking.getHotelId()) +
+            ",\"room\":" + std::to_string(booking.getRoomNumber()) +
+            ",\"client\":" + Json::quote(booking.getClientName()) +
+            ",\"checkIn\":" + Json::quote(booking.getCheckInDate()) +
+            ",\"checkOut\":" + Json::quote(booking.getCheckOutDate()) +
+            ",\"status\":" + Json::quote(booking.getStatus()) +
+            ",\"total\":\"" + booking.getTotalPrice().toString() + "\"}";
+    }
+
+    template <typename T, typename Formatter>
+    HttpResponse listResponse(const std::vector<T>& items, Formatter format) {
+        HttpResponse response;
+        response.body = "{\"count\":" + std::to_string(items.size()) + ",\"items\":[";
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (i > 0) {
+                response.body += ',';
+            }
+            response.body += format(items[i]);
+        }
+        response.body += "]}";
+        return response;
+    }
+}
+
+// Конструктор з параметрами
+BookingApi::BookingApi(UserAccountManager& userManager, HotelManager& hotelManager,
+    BookingManager& bookingManager)
+    : userManager(userManager), hotelManager(hotelManager), bookingManager(bookingManager) {
+}
+
+// Деструктор
+BookingApi::~BookingApi() {
+}
+
+// Власні методи
+
+HttpResponse BookingApi::handle(const HttpRequest& request) {
+    const std::string& method = request.method;
+    const std::string& path = request.path;
+
+    if (path == "/health") {
+        HttpResponse response;
+        response.body = "{\"status\":\"ok\"}";
+        return response;
+    }
+    if (path == "/login") {
+        return method == "POST" ? login(request) : error(405, "method_not_allowed");
+    }
+
+    SessionInfo session;
+    if (!authorize(request, session)) {
+        return error(401, "unauthorized");
+    }
+
+    if (path == "/logout") {
+        return method == "POST" ? logout(request) : error(405, "method_not_allowed");
+    }
+    if (path == "/availability") {
+        return method == "GET" ? availability(request) : error(405, "method_not_allowed");
+    }
+    if (path == "/hotels") {
+        return method == "GET" ? searchHotels(request) : error(405, "method_not_allowed");
+    }
+    if (path == "/rooms") {
+        return method == "GET" ? searchRooms(request) : error(405, "method_not_allowed");
+    }
+    if (path == "/bookings") {
+        if (method == "GET") return searchBookings(request);
+        if (method == "POST") return createBooking(request);
+        return error(405, "method_not_allowed");
+    }
+
+    const std::string bookingsPrefix = "/bookings/";
+    if (path.compare(0, bookingsPrefix.size(), bookingsPrefix) == 0) {
+        return method == "DELETE" ? cancelBooking(path.substr(bookingsPrefix.size()))
+            : error(405, "method_not_allowed");
+    }
+
+    return error(404, "not_found");
+}
+
+bool BookingApi::saveAll() {
+    std::lock_guard<std::mutex> engineLock(engineMutex);
+    std::lock_guard<std::mutex> userLock(userMutex);
+    return hotelManager.saveHotels() && bookingManager.saveBookings() && userManager.saveUsers();
+}
+
+bool BookingApi::authorize(const HttpRequest& request, SessionInfo& session) const {
+    const std::string scheme = "Bearer ";
+    std::string authorization = request.header("authorization");
+    if (authorization.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+
+    // Сховище сесій потокобезпечне, тож токени перевіряються без блокування менеджерів
+    return userManager.validateSession(authorization.substr(scheme.size()), session);
+}
+
+HttpResponse BookingApi::login(const HttpRequest& request) {
+    std::map<std::string, std::string> fields;
+    if (!Json::parseObject(request.body, fields)) {
+        return error(400, "bad_json");
+    }
+
+    std::string password = param(fields, "password");
+    std::optional<User> user;
+    {
+        std::lock_guard<std::mutex> lock(userMutex);
+        user = userManager.findUser(param(fields, "username"));
+    }
+
+    // PBKDF2 триває ~0,1 с, тож пароль перевіряється без блокування менеджера
+    // користувачів: інакше кожен вхід зупиняв би решту запитів до нього
+    if (!user || !user->verifyPassword(password)) {
+        return error(401, "login_failed");
+    }
+    User updated = *user;
+    if (updated.needsPasswordRehash()) {
+        updated.setPassword(password);
+    }
+
+    std::string token;
+    {
+        // Перехешований старий пароль дописується у файл користувачів
+        std::lock_guard<std::mutex> lock(userMutex);
+        token = userManager.startCheckedSession(*user, updated);
+    }
+
+    if (token.empty()) {
+        return error(401, "login_failed");
+    }
+
+    HttpResponse response;
+    response.body = "{\"token\":\"" + token + "\"}";
+    return response;
+}
+
+HttpResponse BookingApi::logout(const HttpRequest& request) {
+    userManager.endSession(request.header("authorization").substr(7));
+
+    HttpResponse response;
+    response.body = "{\"ok\":true}";
+    return response;
+}
+
+HttpResponse BookingApi::availability(const HttpRequest& request) {
+    int hotelId = 0;
+    int roomNumber = 0;
+    std::string checkIn = param(request.query, "checkIn");
+    std::string checkOut = param(request.query, "checkOut");
+
+    if (!parseInt(param(request.query, "hotel"), hotelId) ||
+        !parseInt(param(request.query, "room"), roomNumber) ||
+        checkIn.empty() || checkOut.empty()) {
+        return error(400, "bad_parameters");
+    }
+
+    bool available;
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        available = bookingManager.checkAvailability(hotelId, roomNumber, checkIn, checkOut);
+    }
+
+    HttpResponse response;
+    response.body = std::string("{\"available\":") + (available ? "true" : "false") + "}";
+    return response;
+}
+
+HttpResponse BookingApi::searchHotels(const HttpRequest& request) {
+    const auto& query = request.query;
+    std::vector<std::shared_ptr<HotelBase>> hotels;
+
+    int stars = 0;
+    AmenityMask amenities = 0;
+    if (query.count("stars") && !parseInt(param(query, "stars"), stars)) {
+        return error(400, "bad_parameters");
+    }
+    if (query.count("amenities")) {
+        amenities = AmenityDictionary::parseList(param(query, "amenities"));
+        if (amenities == 0) {
+            return error(400, "bad_parameters");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex);
+    if (query.count("city")) {
+        hotels = hotelManager.findHotelsByCity(param(query, "city"));
+    }
+    else if (query.count("type")) {
+        hotels = hotelManager.findHotelsByType(param(query, "type"));
+    }
+    else if (query.count("stars")) {
+        hotels = hotelManager.findHotelsByStars(stars);
+    }
+    else if (query.count("prefix")) {
+        hotels = hotelManager.suggestHotels(param(query, "prefix"));
+    }
+    else if (query.count("amenities")) {
+        hotels = hotelManager.findHotelsWithAmenities(amenities);
+    }
+    else {
+        hotels = hotelManager.getHotels();
+    }
+
+    return listResponse(hotels, [](const std::shared_ptr<HotelBase>& hotel) {
+        return hotelJson(*hotel);
+    });
+}
+
+HttpResponse BookingApi::searchRooms(const HttpRequest& request) {
+    const auto& query = request.query;
+    int capacity = MIN_CAPACITY;
+    Money maxPrice = Money::fromHryvnias(MAX_PRICE);
+
+    if (query.count("capacity") && !parseInt(param(query, "capacity"), capacity)) {
+        return error(400, "bad_parameters");
+    }
+    if (query.count("maxPrice") && !Money::parse(param(query, "maxPrice"), maxPrice)) {
+        return error(400, "bad_parameters");
+    }
+
+    std::lock_guard<std::mutex> lock(engineMutex);
+    std::vector<std::shared_ptr<HotelBase>> hotels = hotelManager.findAvailableRooms(
+        param(query, "city"), param(query, "class"), capacity, maxPrice.toHryvnias());
+
+    return listResponse(hotels, [](const std::shared_ptr<HotelBase>& hotel) {
+        return hotelJson(*hotel);
+    });
+}
+
+HttpResponse BookingApi::searchBookings(const HttpRequest& request) {
+    const auto& query = request.query;
+    std::vector<Booking> bookings;
+
+    int hotelId = 0;
+    if (query.count("hotel") && !parseInt(param(query, "hotel"), hotelId)) {
+        return error(400, "bad_parameters");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        if (query.count("client")) {
+            bookings = bookingManager.findBookingsByClient(param(query, "client"));
+        }
+        else if (query.count("passport")) {
+            bookings = bookingManager.findBookingsByPassport(param(query, "passport"));
+        }
+        else if (query.count("hotel")) {
+            bookings = bookingManager.findBookingsByHotel(hotelId);
+        }
+        else if (query.count("status")) {
+            bookings = bookingManager.findBookingsByStatus(param(query, "status"));
+        }
+        else {
+            return error(400, "missing_filter");
+        }
+    }
+
+    return listResponse(bookings, bookingJson);
+}
+
+HttpResponse BookingApi::createBooking(const HttpRequest& request) {
+    std::map<std::string, std::string> fields;
+    int hotelId = 0;
+    int roomNumber = 0;
+
+    if (!Json::parseObject(request.body, fields)) {
+        return error(400, "bad_json");
+    }
+    if (!parseInt(param(fields, "hotelId"), hotelId) || !parseInt(param(fields, "room"), roomNumber)) {
+        return error(400, "bad_parameters");
+    }
+
+    std::string body;
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        int bookingId = bookingManager.getNextBookingId();
+        if (!bookingManager.createBooking(hotelId, roomNumber, param(fields, "client"),
+            param(fields, "passport"), param(fields, "checkIn"), param(fields, "checkOut"))) {
+            return error(409, "rejected");
+        }
+
+        Booking* booking = bookingManager.findBooking(bookingId);
+        body = booking ? bookingJson(*booking) : "{\"id\":" + std::to_string(bookingId) + "}";
+    }
+
+    HttpResponse response;
+    response.status = 201;
+    response.body = body;
+    return response;
+}
+
+HttpResponse BookingApi::cancelBooking(const std::string& idText) {
+    int bookingId = 0;
+    if (!parseInt(idText, bookingId)) {
+        return error(400, "bad_parameters");
+    }
+
+    bool cancelled;
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        cancelled = bookingManager.cancelBooking(bookingId);
+    }
+
+    if (!cancelled) {
+        return error(404, "not_found");
+    }
+
+    HttpResponse response;
+    response.body = "{\"id\":" + std::to_string(bookingId) + ",\"status\":\"" + BOOKING_STATUS_CANCELLED + "\"}";
+    return response;
+}
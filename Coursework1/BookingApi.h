@@ -0,0 +1,80 @@
+﻿#ifndef BOOKINGAPI_H
+#define BOOKINGAPI_H
+
+#include "HttpServer.h"
+#include "UserAccountManager.h"
+#include "HotelManager.h"
+#include "BookingManager.h"
+#include <mutex>
+#include <string>
+
+/**
+ * @class BookingApi
+ * @brief JSON-ендпоінти HTTP-сервісу поверх BookingManager та HotelManager
+ *
+ * Маршрути:
+ *   GET    /health
+ *   POST   /login            {"username", "password"} -> {"token"}
+ *   POST   /logout
+ *   GET    /availability?hotel=&room=&checkIn=&checkOut=
+ *   GET    /hotels?city=|type=|stars=|prefix=|amenities=
+ *   GET    /rooms?city=&class=&capacity=&maxPrice=
+ *   GET    /bookings?client=|passport=|hotel=|status=
+ *   POST   /bookings         {"hotelId", "room", "client", "passport", "checkIn", "checkOut"}
+ *   DELETE /bookings/<id>
+ * Усі маршрути, крім /health та /login, вимагають "Authorization: Bearer <токен>".
+ *
+ * Менеджери не потокобезпечні (індекси каталогу перебудовуються ліниво
+ * навіть у const-методах), тому звернення до них серіалізуються
+ * engineMutex. Розбір HTTP, перевірка токенів та формування JSON
+ * виконуються паралельно у робочих потоках сервера.
+ */
+class BookingApi {
+private:
+    UserAccountManager& userManager;
+    HotelManager& hotelManager;
+    BookingManager& bookingManager;
+
+    std::mutex engineMutex;
+    std::mutex userMutex;
+
+    bool authorize(const HttpRequest& request, SessionInfo& session) const;
+
+    HttpResponse login(const HttpRequest& request);
+    HttpResponse logout(const HttpRequest& request);
+    HttpResponse availability(const HttpRequest& request);
+    HttpResponse searchHotels(const HttpRequest& request);
+    HttpResponse searchRooms(const HttpRequest& request);
+    HttpResponse searchBookings(const HttpRequest& request);
+    HttpResponse createBooking(const HttpRequest& request);
+    HttpResponse cancelBooking(const std::string& idText);
+
+public:
+    // Конструктори
+    BookingApi(UserAccountManager& userManager, HotelManager& hotelManager,
+        BookingManager& bookingManager);
+    BookingApi(const BookingApi& other) = delete;
+    BookingApi(BookingApi&& other) = delete;
+
+    // Деструктор
+    ~BookingApi();
+
+    // Оператори присвоєння
+    BookingApi& operator=(const BookingApi& other) = delete;
+    BookingApi& operator=(BookingApi&& other) = delete;
+
+    /**
+     * @brief Обробляє запит (викликається з робочих потоків сервера)
+     * @param request Запит
+     * @return Відповідь з JSON-тілом
+     */
+    HttpResponse handle(const HttpRequest& request);
+
+    /**
+     * @brief Зберігає всі дані (під блокуванням менеджерів)
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool saveAll();
+};
+
+#endif // BOOKINGAPI_H
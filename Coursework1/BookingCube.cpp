@@ -0,0 +1,413 @@
+﻿#include "BookingCube.h"
+#include "Constants.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+    // Запас днів з кожного боку при створенні або розширенні рядка
+    const int MIN_DAY_SLACK = 31;
+}
+
+// Конструктор за замовчуванням
+BookingCube::BookingCube()
+    : firstStayDay(1), lastStayDay(0) {
+}
+
+// Getters
+std::size_t BookingCube::getHotelCount() const {
+    return hotelIds.size();
+}
+
+bool BookingCube::getStayRange(int& firstDay, int& lastDay) const {
+    if (firstStayDay > lastStayDay) {
+        return false;
+    }
+    firstDay = firstStayDay;
+    lastDay = lastStayDay;
+    return true;
+}
+
+std::size_t BookingCube::getMemoryBytes() const {
+    std::size_t bytes = rows.capacity() * sizeof(SparseRow);
+    for (const SparseRow& row : rows) {
+        bytes += row.capacity() * sizeof(DayCell);
+    }
+    for (const Row& row : allHotels) {
+        bytes += row.tree.size() * sizeof(Cell);
+    }
+    return bytes;
+}
+
+// Власні методи
+
+BookingCube::SparseRow& BookingCube::rowFor(int hotelId, RoomClass roomClass) {
+    auto inserted = hotelPositions.emplace(hotelId, hotelIds.size());
+    if (inserted.second) {
+        hotelIds.push_back(hotelId);
+        rows.resize(hotelIds.size() * CLASS_SLOTS);
+    }
+    return rows[inserted.first->second * CLASS_SLOTS + static_cast<std::size_t>(roomClass)];
+}
+
+void BookingCube::ensureDays(Row& row, int firstDay, int lastDay) {
+    int size = static_cast<int>(row.tree.size());
+    if (size == 0) {
+        row.origin = firstDay - MIN_DAY_SLACK;
+        row.tree.assign(static_cast<std::size_t>(lastDay - firstDay + 1 + 2 * MIN_DAY_SLACK), Cell{ 0, 0, 0, 0 });
+        return;
+    }
+    if (firstDay >= row.origin && lastDay < row.origin + size) {
+        return;
+    }
+
+    // Розширюємо щонайменше на половину, щоб перебудови були рідкісними
+    int grow = std::max(MIN_DAY_SLACK, size / 2);
+    int newOrigin = firstDay < row.origin ? firstDay - grow : row.origin;
+    int newEnd = lastDay >= row.origin + size ? lastDay + 1 + grow : row.origin + size;
+
+    // Дерево -> значення днів (зворотна побудова за O(n))
+    std::vector<Cell>& tree = row.tree;
+    for (int i = size; i >= 1; --i) {
+        int parent = i + (i & -i);
+        if (parent <= size) {
+            Cell& target = tree[parent - 1];
+            const Cell& child = tree[i - 1];
+            target.nights -= child.nights;
+            target.cancellations -= child.cancellations;
+            target.revenue -= child.revenue;
+            target.completedRevenue -= child.completedRevenue;
+        }
+    }
+
+    std::vector<Cell> grown(static_cast<std::size_t>(newEnd - newOrigin), Cell{ 0, 0, 0, 0 });
+    std::copy(tree.begin(), tree.end(), grown.begin() + (row.origin - newOrigin));
+
+    // Значення днів -> дерево (побудова за O(n))
+    int newSize = static_cast<int>(grown.size());
+    for (int i = 1; i <= newSize; ++i) {
+        int parent = i + (i & -i);
+        if (parent <= newSize) {
+            Cell& target = grown[parent - 1];
+            const Cell& child = grown[i - 1];
+            target.nights += child.nights;
+            target.cancellations += child.cancellations;
+            target.revenue += child.revenue;
+            target.completedRevenue += child.completedRevenue;
+        }
+    }
+
+    row.origin = newOrigin;
+    row.tree.swap(grown);
+}
+
+void BookingCube::addToDay(Row& row, int day, const Cell& delta) {
+    int size = static_cast<int>(row.tree.size());
+    for (int i = day - row.origin + 1; i <= size; i += i & -i) {
+        Cell& cell = row.tree[i - 1];
+        cell.nights += delta.nights;
+        cell.cancellations += delta.cancellations;
+        cell.revenue += delta.revenue;
+        cell.completedRevenue += delta.completedRevenue;
+    }
+}
+
+BookingCube::Cell BookingCube::prefix(const Row& row, int endDay) {
+    Cell sum{ 0, 0, 0, 0 };
+    int size = static_cast<int>(row.tree.size());
+    for (int i = std::min(std::max(endDay - row.origin, 0), size); i > 0; i -= i & -i) {
+        const Cell& cell = row.tree[i - 1];
+        sum.nights += cell.nights;
+        sum.cancellations += cell.cancellations;
+        sum.revenue += cell.revenue;
+        sum.completedRevenue += cell.completedRevenue;
+    }
+    return sum;
+}
+
+void BookingCube::addToDays(SparseRow& row, const std::vector<DayCell>& deltas) {
+    if (deltas.empty()) {
+        return;
+    }
+    auto first = std::lower_bound(row.begin(), row.end(), deltas.front().day,
+        [](const DayCell& cell, int day) { return cell.day < day; });
+    std::size_t position = static_cast<std::size_t>(first - row.begin());
+
+    for (const DayCell& delta : deltas) {
+        if (position == row.size() || row[position].day != delta.day) {
+            row.insert(row.begin() + static_cast<std::ptrdiff_t>(position), DayCell{ delta.day, 0, 0, 0, 0 });
+        }
+        DayCell& cell = row[position];
+        cell.nights += delta.nights;
+        cell.cancellations += delta.cancellations;
+        cell.revenue += delta.revenue;
+        cell.completedRevenue += delta.completedRevenue;
+        if (cell.nights == 0 && cell.cancellations == 0 && cell.revenue == 0 && cell.completedRevenue == 0) {
+            row.erase(row.begin() + static_cast<std::ptrdiff_t>(position));
+        }
+        else {
+            ++position;
+        }
+    }
+}
+
+bool BookingCube::stayOf(const Booking& booking, int& checkIn, int& checkOut) {
+    return Booking::parseDayNumber(booking.getCheckInDate(), checkIn) &&
+        Booking::parseDayNumber(booking.getCheckOutDate(), checkOut) &&
+        checkOut > checkIn;
+}
+
+void BookingCube::spread(const Booking& booking, int checkIn, int checkOut, int sign, std::vector<DayCell>& deltas) {
+    deltas.clear();
+    std::string status = booking.getStatus();
+    if (status == BOOKING_STATUS_CANCELLED) {
+        deltas.push_back(DayCell{ checkIn, 0, sign, 0, 0 });
+        return;
+    }
+
+    std::int64_t price = booking.getTotalPrice().getKopecks();
+    std::int64_t nights = checkOut - checkIn;
+    bool completed = status == BOOKING_STATUS_COMPLETED;
+    for (std::int64_t night = 0; night < nights; ++night) {
+        std::int64_t share = sign * (price * (night + 1) / nights - price * night / nights);
+        deltas.push_back(DayCell{ checkIn + static_cast<int>(night), sign, 0, share, completed ? share : 0 });
+    }
+}
+
+void BookingCube::addToTotals(RoomClass roomClass, const std::vector<DayCell>& deltas) {
+    int firstDay = deltas.front().day;
+    int lastDay = deltas.back().day;
+    Row& total = allHotels[static_cast<std::size_t>(roomClass)];
+    ensureDays(total, firstDay, lastDay);
+    for (const DayCell& delta : deltas) {
+        addToDay(total, delta.day, Cell{ delta.nights, delta.cancellations, delta.revenue, delta.completedRevenue });
+    }
+
+    if (deltas.front().nights > 0) {
+        bool empty = firstStayDay > lastStayDay;
+        firstStayDay = empty ? firstDay : std::min(firstStayDay, firstDay);
+        lastStayDay = empty ? lastDay : std::max(lastStayDay, lastDay);
+    }
+}
+
+void BookingCube::apply(const Booking& booking, int sign) {
+    int checkIn = 0;
+    int checkOut = 0;
+    if (!stayOf(booking, checkIn, checkOut)) {
+        return;
+    }
+    std::vector<DayCell> deltas;
+    spread(booking, checkIn, checkOut, sign, deltas);
+    RoomClass roomClass = booking.getRoomClassId();
+    addToDays(rowFor(booking.getHotelId(), roomClass), deltas);
+    addToTotals(roomClass, deltas);
+}
+
+void BookingCube::build(const std::vector<Booking>& bookings) {
+    clear();
+
+    // Перший прохід: дні проживання, позиції готелів і їхні діапазони днів
+    std::vector<std::pair<int, int>> stays(bookings.size(), std::pair<int, int>(0, 0));
+    std::vector<std::size_t> hotelOf(bookings.size());
+    std::vector<std::size_t> offsets;
+    std::vector<std::pair<int, int>> hotelDays;        // (перший, останній), перший > останнього - днів немає
+    for (std::size_t i = 0; i < bookings.size(); ++i) {
+        auto inserted = hotelPositions.emplace(bookings[i].getHotelId(), hotelIds.size());
+        if (inserted.second) {
+            hotelIds.push_back(bookings[i].getHotelId());
+            offsets.push_back(0);
+            hotelDays.emplace_back(1, 0);
+        }
+        std::size_t position = inserted.first->second;
+        hotelOf[i] = position;
+        ++offsets[position];
+
+        int checkIn = 0;
+        int checkOut = 0;
+        if (!stayOf(bookings[i], checkIn, checkOut)) {
+            continue;
+        }
+        stays[i] = std::make_pair(checkIn, checkOut);
+        std::pair<int, int>& days = hotelDays[position];
+        bool empty = days.first > days.second;
+        days.first = empty ? checkIn : std::min(days.first, checkIn);
+        days.second = empty ? checkOut - 1 : std::max(days.second, checkOut - 1);
+    }
+    rows.resize(hotelIds.size() * CLASS_SLOTS);
+
+    // Групуємо бронювання за готелем (сортування підрахунком)
+    std::size_t running = 0;
+    for (std::size_t& offset : offsets) {
+        std::size_t count = offset;
+        offset = running;
+        running += count;
+    }
+    offsets.push_back(running);
+    std::vector<std::size_t> order(bookings.size());
+    std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < bookings.size(); ++i) {
+        order[next[hotelOf[i]]++] = i;
+    }
+
+    // Дні кожного готелю накопичуються в щільному буфері по його діапазону,
+    // а в рядки переносяться лише ненульові дні
+    std::vector<DayCell> deltas;
+    std::vector<DayCell> scratch;
+    for (std::size_t position = 0; position < hotelIds.size(); ++position) {
+        int firstDay = hotelDays[position].first;
+        int lastDay = hotelDays[position].second;
+        if (firstDay > lastDay) {
+            continue;
+        }
+
+        std::size_t span = static_cast<std::size_t>(lastDay - firstDay + 1);
+        scratch.assign(span * CLASS_SLOTS, DayCell{ 0, 0, 0, 0, 0 });
+        for (std::size_t k = offsets[position]; k < offsets[position + 1]; ++k) {
+            const std::pair<int, int>& stay = stays[order[k]];
+            if (stay.second <= stay.first) {
+                continue;
+            }
+            const Booking& booking = bookings[order[k]];
+            spread(booking, stay.first, stay.second, 1, deltas);
+            RoomClass roomClass = booking.getRoomClassId();
+            DayCell* days = &scratch[static_cast<std::size_t>(roomClass) * span];
+            for (const DayCell& delta : deltas) {
+                DayCell& cell = days[delta.day - firstDay];
+                cell.nights += delta.nights;
+                cell.cancellations += delta.cancellations;
+                cell.revenue += delta.revenue;
+                cell.completedRevenue += delta.completedRevenue;
+            }
+            addToTotals(roomClass, deltas);
+        }
+
+        for (std::size_t slot = 0; slot < CLASS_SLOTS; ++slot) {
+            const DayCell* days = &scratch[slot * span];
+            SparseRow& row = rows[position * CLASS_SLOTS + slot];
+            for (std::size_t d = 0; d < span; ++d) {
+                const DayCell& cell = days[d];
+                if (cell.nights != 0 || cell.cancellations != 0 || cell.revenue != 0 || cell.completedRevenue != 0) {
+                    row.push_back(DayCell{ firstDay + static_cast<int>(d),
+                        cell.nights, cell.cancellations, cell.revenue, cell.completedRevenue });
+                }
+            }
+            row.shrink_to_fit();
+        }
+    }
+}
+
+void BookingCube::clear() {
+    rows.clear();
+    hotelPositions.clear();
+    hotelIds.clear();
+    for (Row& row : allHotels) {
+        row = Row();
+    }
+    firstStayDay = 1;
+    lastStayDay = 0;
+}
+
+void BookingCube::addBooking(const Booking& booking) {
+    apply(booking, 1);
+}
+
+void BookingCube::removeBooking(const Booking& booking) {
+    apply(booking, -1);
+}
+
+bool BookingCube::selectSlots(const std::string& roomClass, std::size_t& firstSlot, std::size_t& lastSlot) {
+    firstSlot = 0;
+    lastSlot = CLASS_SLOTS;
+    if (!roomClass.empty()) {
+        RoomClass classId = Room::parseRoomClass(roomClass);
+        if (classId == RoomClass::Unknown) {
+            return false;
+        }
+        firstSlot = static_cast<std::size_t>(classId);
+        lastSlot = firstSlot + 1;
+    }
+    return true;
+}
+
+void BookingCube::accumulate(const SparseRow& row, const std::vector<int>& boundaries,
+    std::vector<CubeTotals>& totals, std::vector<std::int64_t>& revenue,
+    std::vector<std::int64_t>& completedRevenue) {
+    auto cell = std::lower_bound(row.begin(), row.end(), boundaries.front(),
+        [](const DayCell& day, int value) { return day.day < value; });
+    for (std::size_t i = 0; i < totals.size() && cell != row.end(); ++i) {
+        for (; cell != row.end() && cell->day < boundaries[i + 1]; ++cell) {
+            totals[i].bookedNights += cell->nights;
+            totals[i].cancellations += cell->cancellations;
+            revenue[i] += cell->revenue;
+            completedRevenue[i] += cell->completedRevenue;
+        }
+    }
+}
+
+bool BookingCube::series(int hotelId, const std::string& roomClass,
+    const std::vector<int>& boundaries, std::vector<CubeTotals>& totals) const {
+    totals.assign(boundaries.empty() ? 0 : boundaries.size() - 1, CubeTotals{ 0, 0, Money(), Money() });
+
+    std::size_t firstSlot = 0;
+    std::size_t lastSlot = 0;
+    if (!selectSlots(roomClass, firstSlot, lastSlot)) {
+        return false;
+    }
+    if (totals.empty()) {
+        return true;
+    }
+
+    std::vector<std::int64_t> revenue(totals.size(), 0);
+    std::vector<std::int64_t> completedRevenue(totals.size(), 0);
+    if (hotelId != 0) {
+        auto position = hotelPositions.find(hotelId);
+        if (position == hotelPositions.end()) {
+            return true;
+        }
+        for (std::size_t slot = firstSlot; slot < lastSlot; ++slot) {
+            accumulate(rows[position->second * CLASS_SLOTS + slot], boundaries, totals, revenue, completedRevenue);
+        }
+    }
+    else {
+        for (std::size_t slot = firstSlot; slot < lastSlot; ++slot) {
+            const Row& row = allHotels[slot];
+            if (row.tree.empty()) {
+                continue;
+            }
+
+            Cell lower = prefix(row, boundaries[0]);
+            for (std::size_t i = 0; i < totals.size(); ++i) {
+                Cell upper = prefix(row, boundaries[i + 1]);
+                totals[i].bookedNights += upper.nights - lower.nights;
+                totals[i].cancellations += upper.cancellations - lower.cancellations;
+                revenue[i] += upper.revenue - lower.revenue;
+                completedRevenue[i] += upper.completedRevenue - lower.completedRevenue;
+                lower = upper;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < totals.size(); ++i) {
+        totals[i].revenue = Money(revenue[i]);
+        totals[i].completedRevenue = Money(completedRevenue[i]);
+    }
+    return true;
+}
+
+bool BookingCube::query(int hotelId, const std::string& roomClass,
+    const std::string& fromDate, const std::string& toDate, CubeTotals& totals) const {
+    totals = CubeTotals{ 0, 0, Money(), Money() };
+
+    int fromDay = 0;
+    int toDay = 0;
+    if (!Booking::parseDayNumber(fromDate, fromDay) || !Booking::parseDayNumber(toDate, toDay) ||
+        toDay < fromDay) {
+        return false;
+    }
+
+    std::vector<CubeTotals> range;
+    if (!series(hotelId, roomClass, { fromDay, toDay }, range)) {
+        return false;
+    }
+    totals = range[0];
+    return true;
+}
@@ -0,0 +1,207 @@
+﻿#ifndef BOOKINGCUBE_H
+#define BOOKINGCUBE_H
+
+#include "Booking.h"
+#include "Room.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @struct CubeTotals
+ * @brief Підсумки куба за вибраними готелями, класами та днями
+ */
+struct CubeTotals {
+    std::int64_t bookedNights;      // Номеро-ночі активних і завершених бронювань
+    std::int64_t cancellations;     // Скасування (за днем заїзду)
+    Money revenue;                  // Дохід активних і завершених бронювань
+    Money completedRevenue;         // Дохід лише завершених бронювань
+};
+
+/**
+ * @class BookingCube
+ * @brief Матеріалізований куб "готель x клас номера x день" з префіксними сумами
+ *
+ * Рядок (готель, клас) зберігає лише дні, на які в нього є ночі або
+ * скасування, відсортованими за днем, тож пам'ять росте з кількістю
+ * заброньованих днів, а не з "готелі x класи x увесь діапазон дат". Сума
+ * за проміжок чи ряд за місяцями - один прохід по днях рядка.
+ *
+ * Окремі рядки "усі готелі" для кожного класу - щільні дерева Фенвіка по
+ * днях з 64-бітними мірами: їх лише CLASS_SLOTS, а запит для панелі
+ * статистики коштує O(log днів) на рядок і не залежить ні від кількості
+ * бронювань, ні від кількості готелів.
+ *
+ * Ночі та дохід розкладаються по днях проживання (дохід ночі - різниця
+ * округлених часток, тож сума по днях точно дорівнює вартості),
+ * скасування рахуються в день заїзду.
+ */
+class BookingCube {
+private:
+    static const int CLASS_SLOTS = 4;       // Luxury, Standard, Economy, Unknown
+
+    /**
+     * @struct Cell
+     * @brief Міри однієї вершини дерева Фенвіка "усі готелі" (32 байти)
+     */
+    struct Cell {
+        std::int64_t nights;
+        std::int64_t cancellations;
+        std::int64_t revenue;
+        std::int64_t completedRevenue;
+    };
+
+    /**
+     * @struct Row
+     * @brief Дерево Фенвіка по днях [origin, origin + tree.size())
+     */
+    struct Row {
+        int origin = 0;
+        std::vector<Cell> tree;
+    };
+
+    /**
+     * @struct DayCell
+     * @brief Міри одного дня рядка готелю (32 байти)
+     *
+     * Лічильники одного готелю за день обмежені кількістю його номерів,
+     * тож 32 біт досить; 64-бітні суми потрібні лише рядкам "усі готелі".
+     */
+    struct DayCell {
+        std::int32_t day;
+        std::int32_t nights;
+        std::int32_t cancellations;
+        std::int64_t revenue;
+        std::int64_t completedRevenue;
+    };
+
+    typedef std::vector<DayCell> SparseRow;             // дні за зростанням
+
+    std::vector<SparseRow> rows;                        // позиція готелю * CLASS_SLOTS + клас
+    Row allHotels[CLASS_SLOTS];                         // ті самі міри, підсумовані по всіх готелях
+    std::unordered_map<int, std::size_t> hotelPositions;
+    std::vector<int> hotelIds;
+    int firstStayDay;                                   // межі ночей, що колись потрапляли в куб
+    int lastStayDay;                                    // (firstStayDay > lastStayDay - куб порожній)
+
+    SparseRow& rowFor(int hotelId, RoomClass roomClass);
+    static void ensureDays(Row& row, int firstDay, int lastDay);
+    static void addToDay(Row& row, int day, const Cell& delta);
+    static Cell prefix(const Row& row, int endDay);
+
+    /**
+     * @brief Додає міри послідовних днів до рядка готелю
+     *
+     * Дні, що стали нульовими, видаляються з рядка.
+     * @param deltas Міри днів за зростанням, без пропусків
+     */
+    static void addToDays(SparseRow& row, const std::vector<DayCell>& deltas);
+
+    /**
+     * @brief Визначає номери днів заїзду та виїзду бронювання
+     * @return false якщо дати бронювання некоректні
+     */
+    static bool stayOf(const Booking& booking, int& checkIn, int& checkOut);
+
+    /**
+     * @brief Розкладає бронювання на міри по днях
+     * @param deltas Результат: дні проживання або день заїзду для скасованого
+     */
+    static void spread(const Booking& booking, int checkIn, int checkOut, int sign, std::vector<DayCell>& deltas);
+
+    /**
+     * @brief Додає міри днів до рядка "усі готелі" та меж проживання
+     */
+    void addToTotals(RoomClass roomClass, const std::vector<DayCell>& deltas);
+
+    /**
+     * @brief Додає до totals дні рядка готелю по проміжках boundaries
+     */
+    static void accumulate(const SparseRow& row, const std::vector<int>& boundaries,
+        std::vector<CubeTotals>& totals, std::vector<std::int64_t>& revenue,
+        std::vector<std::int64_t>& completedRevenue);
+
+    void apply(const Booking& booking, int sign);
+
+    /**
+     * @brief Перевіряє клас номера і визначає потрібні слоти класів
+     * @return false якщо клас некоректний
+     */
+    static bool selectSlots(const std::string& roomClass, std::size_t& firstSlot, std::size_t& lastSlot);
+
+public:
+    // Конструктори
+    BookingCube();
+
+    // Getters
+    std::size_t getHotelCount() const;
+
+    /**
+     * @brief Межі днів, на які припадали ночі бронювань (не звужуються при видаленні)
+     * @param firstDay Перший день
+     * @param lastDay Останній день (включно)
+     * @return false якщо куб порожній
+     */
+    bool getStayRange(int& firstDay, int& lastDay) const;
+
+    /**
+     * @brief Розмір куба в пам'яті (дні рядків готелів і вершини дерев)
+     * @return Кількість байтів
+     */
+    std::size_t getMemoryBytes() const;
+
+    /**
+     * @brief Очищає куб
+     */
+    void clear();
+
+    /**
+     * @brief Будує куб з нуля за списком бронювань
+     *
+     * Бронювання групуються за готелем, і рядки кожного готелю
+     * заповнюються за один прохід, без вставок у середину рядків.
+     * @param bookings Бронювання з уже визначеними класами номерів
+     */
+    void build(const std::vector<Booking>& bookings);
+
+    /**
+     * @brief Додає внесок бронювання відповідно до його статусу та класу номера
+     * @param booking Бронювання
+     */
+    void addBooking(const Booking& booking);
+
+    /**
+     * @brief Прибирає внесок бронювання (з тим самим статусом, з яким його додали)
+     * @param booking Бронювання
+     */
+    void removeBooking(const Booking& booking);
+
+    /**
+     * @brief Підсумовує міри за проміжком дат
+     * @param hotelId ID готелю або 0 для всіх готелів
+     * @param roomClass Клас номера або порожній рядок для всіх класів
+     * @param fromDate Перший день DD.MM.YYYY (включно)
+     * @param toDate Останній день DD.MM.YYYY (не включно)
+     * @param totals Результат
+     * @return true якщо успішно, false якщо дати чи клас некоректні
+     */
+    bool query(int hotelId, const std::string& roomClass,
+        const std::string& fromDate, const std::string& toDate, CubeTotals& totals) const;
+
+    /**
+     * @brief Підсумовує міри по послідовних проміжках [boundaries[i], boundaries[i + 1])
+     *
+     * Кожна межа коштує одну префіксну суму на рядок, тож ряд за місяцями
+     * не залежить від кількості бронювань.
+     * @param hotelId ID готелю або 0 для всіх готелів
+     * @param roomClass Клас номера або порожній рядок для всіх класів
+     * @param boundaries Зростаючі номери днів (Booking::dayNumber)
+     * @param totals Результат, boundaries.size() - 1 елементів
+     * @return true якщо успішно, false якщо клас некоректний
+     */
+    bool series(int hotelId, const std::string& roomClass,
+        const std::vector<int>& boundaries, std::vector<CubeTotals>& totals) const;
+};
+
+#endif // BOOKINGCUBE_H
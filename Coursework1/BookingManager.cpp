@@ -1,37 +1,46 @@
 ﻿#include "BookingManager.h"
 #include "Constants.hpp"
+#include "OperationMetrics.h"
+#include "Tracing.h"
+#include "Logger.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <unordered_map>
 
 // Конструктор за замовчуванням
 BookingManager::BookingManager()
-    : filename(BOOKINGS_FILE), nextBookingId(1), hotelManager(nullptr) {
+    : filename(BOOKINGS_FILE), nextBookingId(1), hotelManager(nullptr), autoSave(true),
+    cubeBuilt(false), journal(BOOKINGS_FILE + BOOKINGS_JOURNAL_SUFFIX) {
 }
 
 // Конструктор з параметрами
 BookingManager::BookingManager(const std::string& filename, HotelManager* hotelManager)
-    : filename(filename), nextBookingId(1), hotelManager(hotelManager) {
+    : filename(filename), nextBookingId(1), hotelManager(hotelManager), autoSave(true),
+    cubeBuilt(false), journal(filename + BOOKINGS_JOURNAL_SUFFIX) {
 }
 
 // Копіювальний конструктор
 BookingManager::BookingManager(const BookingManager& other)
     : bookings(other.bookings), filename(other.filename),
-    nextBookingId(other.nextBookingId), hotelManager(other.hotelManager) {
+    nextBookingId(other.nextBookingId), hotelManager(other.hotelManager),
+    autoSave(other.autoSave), cube(other.cube), cubeBuilt(other.cubeBuilt), journal(other.journal) {
 }
 
 // Переміщувальний конструктор
 BookingManager::BookingManager(BookingManager&& other) noexcept
     : bookings(std::move(other.bookings)), filename(std::move(other.filename)),
-    nextBookingId(other.nextBookingId), hotelManager(other.hotelManager) {
+    nextBookingId(other.nextBookingId), hotelManager(other.hotelManager),
+    autoSave(other.autoSave), cube(std::move(other.cube)), cubeBuilt(other.cubeBuilt),
+    journal(std::move(other.journal)) {
     other.hotelManager = nullptr;
 }
 
 // Деструктор
 BookingManager::~BookingManager() {
-    std::cout << "Об'єкт BookingManager знищено." << std::endl;
+    LOG_DEBUG("Об'єкт BookingManager знищено.");
 }
 
 // Оператор копіювального присвоєння
@@ -41,6 +50,10 @@ BookingManager& BookingManager::operator=(const BookingManager& other) {
         filename = other.filename;
         nextBookingId = other.nextBookingId;
         hotelManager = other.hotelManager;
+        autoSave = other.autoSave;
+        cube = other.cube;
+        cubeBuilt = other.cubeBuilt;
+        journal = other.journal;
     }
     return *this;
 }
@@ -52,6 +65,10 @@ BookingManager& BookingManager::operator=(BookingManager&& other) noexcept {
         filename = std::move(other.filename);
         nextBookingId = other.nextBookingId;
         hotelManager = other.hotelManager;
+        autoSave = other.autoSave;
+        cube = std::move(other.cube);
+        cubeBuilt = other.cubeBuilt;
+        journal = std::move(other.journal);
         other.hotelManager = nullptr;
     }
     return *this;
@@ -66,37 +83,75 @@ int BookingManager::getNextBookingId() const {
     return nextBookingId;
 }
 
+bool BookingManager::getAutoSave() const {
+    return autoSave;
+}
+
 // Setters
 void BookingManager::setFilename(const std::string& filename) {
     this->filename = filename;
+    journal.setPath(filename + BOOKINGS_JOURNAL_SUFFIX);
 }
 
 void BookingManager::setHotelManager(HotelManager* manager) {
     this->hotelManager = manager;
 }
 
+void BookingManager::setAutoSave(bool enabled) {
+    this->autoSave = enabled;
+}
+
+bool BookingManager::persist(const Booking& booking) {
+    if (!autoSave) {
+        return true;
+    }
+
+    std::ostringstream record;
+    record << "B,";
+    writeBookingRow(record, booking);
+    if (!journal.append({ record.str() })) {
+        LOG_ERROR("Не вдалося дописати журнал: " << journal.getPath());
+        return false;
+    }
+    return true;
+}
+
+void BookingManager::compactJournal() {
+    // Межа на довжину журналу обмежує час відтворення при запуску.
+    // Зміна вже в журналі, тож невдалий знімок її не скасовує
+    if (autoSave &&
+        journal.getRecordCount() > static_cast<size_t>(BOOKINGS_JOURNAL_COMPACT_THRESHOLD) &&
+        !saveBookings()) {
+        LOG_WARNING("Не вдалося стиснути журнал: " << journal.getPath());
+    }
+}
+
 // Реалізація методів інтерфейсу
 
 bool BookingManager::checkAvailability(int hotelId, int roomNumber,
     const std::string& checkIn,
     const std::string& checkOut) const {
+    // Зайнятий номер - звичайна відповідь, помилкою рахуються лише невідомі готель чи номер
+    OperationTimer timer(MetricOperation::CheckAvailability);
+    TraceSpan span("checkAvailability", "booking");
+
     // Перевіряємо чи існує готель
     if (!hotelManager) {
-        std::cerr << "HotelManager не встановлено!" << std::endl;
-        return false;
+        LOG_WARNING("HotelManager не встановлено!");
+        return timer.result(false);
     }
 
     auto hotel = hotelManager->findHotel(hotelId);
     if (!hotel) {
-        std::cerr << "Готель не знайдено!" << std::endl;
-        return false;
+        LOG_WARNING("Готель не знайдено!");
+        return timer.result(false);
     }
 
     // Перевіряємо чи існує номер
-    Room* room = hotel->findRoom(roomNumber);
+    const Room* room = hotel->findRoom(roomNumber);
     if (!room) {
-        std::cerr << "Номер не знайдено!" << std::endl;
-        return false;
+        LOG_WARNING("Номер не знайдено!");
+        return timer.result(false);
     }
 
     // Перевіряємо перекриття з існуючими бронюваннями
@@ -117,55 +172,126 @@ bool BookingManager::createBooking(int hotelId, int roomNumber,
     const std::string& passport,
     const std::string& checkIn,
     const std::string& checkOut) {
+    OperationTimer timer(MetricOperation::CreateBooking);
+    TraceSpan span("createBooking", "booking");
+
     // Перевіряємо доступність
-    if (!checkAvailability(hotelId, roomNumber, checkIn, checkOut)) {
-        std::cerr << "Номер недоступний на вказані дати!" << std::endl;
-        return false;
+    bool available = checkAvailability(hotelId, roomNumber, checkIn, checkOut);
+    span.lap("checkAvailability");
+    if (!available) {
+        LOG_WARNING("Номер недоступний на вказані дати!");
+        return timer.result(false);
     }
 
     // Отримуємо готель та номер для розрахунку ціни
     auto hotel = hotelManager->findHotel(hotelId);
     if (!hotel) {
-        return false;
+        return timer.result(false);
     }
 
-    Room* room = hotel->findRoom(roomNumber);
+    const Room* room = hotel->findRoom(roomNumber);
     if (!room) {
-        return false;
+        return timer.result(false);
     }
 
-    // Створюємо бронювання
-    Booking newBooking(nextBookingId++, hotelId, roomNumber,
+    // Створюємо бронювання (ID займаємо лише після успішного запису)
+    Booking newBooking(nextBookingId, hotelId, roomNumber,
         clientName, passport, checkIn, checkOut);
 
     // Розраховуємо вартість
     int nights = newBooking.calculateNights();
-    double totalPrice = room->getPricePerNight() * nights;
-    newBooking.setTotalPrice(totalPrice);
+    newBooking.setTotalPrice(room->getPrice() * nights);
+    span.lap("price");
 
     // Валідуємо
     if (!newBooking.validate()) {
-        std::cerr << "Некоректні дані бронювання!" << std::endl;
-        return false;
+        LOG_WARNING("Некоректні дані бронювання!");
+        return timer.result(false);
     }
 
+    // Спершу журнал: якщо запис не вдався, пам'ять і куб не змінюються
+    if (!persist(newBooking)) {
+        return timer.result(false);
+    }
+    span.lap("persist");
+
+    nextBookingId++;
+    newBooking.setRoomClass(room->getRoomClassId());
     bookings.push_back(newBooking);
-    return saveBookings();
+    if (cubeBuilt) {
+        cube.addBooking(newBooking);
+    }
+    span.lap("append");
+    compactJournal();
+    return timer.result(true);
 }
 
 bool BookingManager::cancelBooking(int bookingId) {
+    OperationTimer timer(MetricOperation::CancelBooking);
+    return timer.result(changeStatus(bookingId, false));
+}
+
+bool BookingManager::changeStatus(int bookingId, bool complete) {
     Booking* booking = findBooking(bookingId);
 
     if (!booking) {
-        std::cerr << "Бронювання не знайдено!" << std::endl;
+        LOG_WARNING("Бронювання не знайдено!");
         return false;
     }
 
-    booking->cancel();
-    return saveBookings();
+    // Нова версія спершу йде в журнал, пам'ять і куб змінюються лише після нього
+    Booking updated = *booking;
+    if (complete) {
+        updated.complete();
+    }
+    else {
+        updated.cancel();
+    }
+    if (!persist(updated)) {
+        return false;
+    }
+
+    // Клас номера записано в бронюванні, тож пошук готелю не потрібен
+    if (cubeBuilt) {
+        cube.removeBooking(*booking);
+    }
+    *booking = updated;
+    if (cubeBuilt) {
+        cube.addBooking(*booking);
+    }
+    compactJournal();
+    return true;
+}
+
+void BookingManager::ensureCube() {
+    if (cubeBuilt) {
+        return;
+    }
+    TraceSpan span("buildCube", "analytics");
+
+    // Таблиця (ID готелю, номер) -> клас будується один раз на весь прохід
+    std::unordered_map<std::int64_t, RoomClass> roomClasses;
+    if (hotelManager) {
+        for (const auto& hotel : hotelManager->getHotels()) {
+            for (const Room& room : hotel->getRooms()) {
+                roomClasses[static_cast<std::int64_t>(hotel->getHotelId()) << 32 |
+                    static_cast<std::uint32_t>(room.getRoomNumber())] = room.getRoomClassId();
+            }
+        }
+    }
+
+    for (Booking& booking : bookings) {
+        auto roomClass = roomClasses.find(static_cast<std::int64_t>(booking.getHotelId()) << 32 |
+            static_cast<std::uint32_t>(booking.getRoomNumber()));
+        booking.setRoomClass(roomClass != roomClasses.end() ? roomClass->second : RoomClass::Unknown);
+    }
+    cube.build(bookings);
+    cubeBuilt = true;
+    span.addArg("bytes", static_cast<std::int64_t>(cube.getMemoryBytes()));
 }
 
 std::vector<std::string> BookingManager::getAllBookings() const {
+    OperationTimer timer(MetricOperation::GetAllBookings);
     std::vector<std::string> result;
 
     for (const auto& booking : bookings) {
@@ -175,114 +301,255 @@ std::vector<std::string> BookingManager::getAllBookings() const {
     return result;
 }
 
-bool BookingManager::saveBookings() {
-    try {
-        std::ofstream file(filename);
+void BookingManager::writeBookingRow(std::ostream& out, const Booking& booking) {
+    out << booking.getBookingId() << ","
+        << booking.getHotelId() << ","
+        << booking.getRoomNumber() << ","
+        << booking.getClientName() << ","
+        << booking.getPassport() << ","
+        << booking.getCheckInDate() << ","
+        << booking.getCheckOutDate() << ","
+        << booking.getStatus() << ","
+        << booking.getTotalPrice();
+}
 
-        if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл для запису: " << filename << std::endl;
+bool BookingManager::parseBookingRow(const std::string& line, std::vector<std::string>& tokens, Booking& booking) {
+    tokens.clear();
+    size_t start = 0;
+    while (true) {
+        size_t end = line.find(',', start);
+        if (end == std::string::npos) {
+            tokens.emplace_back(line, start);
+            break;
+        }
+        tokens.emplace_back(line, start, end - start);
+        start = end + 1;
+    }
+
+    if (tokens.size() < 9) {
+        return false;
+    }
+
+    try {
+        Money totalPrice;
+        if (!Money::parse(tokens[8], totalPrice)) {
             return false;
         }
 
+        booking = Booking(std::stoi(tokens[0]), std::stoi(tokens[1]), std::stoi(tokens[2]),
+            tokens[3], tokens[4], tokens[5], tokens[6]);
+        booking.setStatus(tokens[7]);
+        booking.setTotalPrice(totalPrice);
+        return true;
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool BookingManager::saveBookings() {
+    OperationTimer timer(MetricOperation::SaveBookings);
+    TraceSpan span("saveBookings", "save");
+
+    // Знімок пишеться у тимчасовий файл, тож збій не зіпсує попередній
+    bool written = Journal::writeAtomically(filename, [&](std::ostream& file) {
         // Записуємо заголовок
-        file << "id,hotel_id,room_number,client_name,passport,check_in,check_out,status,total_price" << std::endl;
+        file << "id,hotel_id,room_number,client_name,passport,check_in,check_out,status,total_price\n";
 
         // Записуємо дані
         for (const auto& booking : bookings) {
-            file << booking.getBookingId() << ","
-                << booking.getHotelId() << ","
-                << booking.getRoomNumber() << ","
-                << booking.getClientName() << ","
-                << booking.getPassport() << ","
-                << booking.getCheckInDate() << ","
-                << booking.getCheckOutDate() << ","
-                << booking.getStatus() << ","
-                << booking.getTotalPrice() << std::endl;
+            writeBookingRow(file, booking);
+            file << '\n';
         }
-
-        file.close();
+        span.lap("write");
         return true;
+    });
+    span.lap("commit");
+    span.addArg("rows", static_cast<std::int64_t>(bookings.size()));
 
+    if (!written) {
+        LOG_ERROR("Не вдалося записати файл: " << filename);
+        return timer.result(false);
     }
-    catch (const std::exception& e) {
-        std::cerr << "Помилка збереження бронювань: " << e.what() << std::endl;
-        return false;
+
+    // Збій до очищення журналу лише повторно застосує ті самі версії бронювань
+    if (!journal.reset()) {
+        LOG_WARNING("Не вдалося очистити журнал: " << journal.getPath());
     }
+    return true;
+}
+
+bool BookingManager::replayJournal() {
+    TraceSpan span("replayJournal", "load");
+
+    // Індекс ID -> позиція будується лише якщо журнал змінює наявні бронювання
+    std::unordered_map<int, size_t> indexById;
+    std::vector<std::string> tokens;
+    Booking booking;
+    size_t skipped = 0;
+
+    bool replayed = journal.replay([&](const std::string& record) {
+        if (record.size() < 2 || record[0] != 'B' || record[1] != ',' ||
+            !parseBookingRow(record.substr(2), tokens, booking)) {
+            skipped++;
+            return;
+        }
+
+        int id = booking.getBookingId();
+        if (id >= nextBookingId) {
+            bookings.push_back(booking);
+            nextBookingId = id + 1;
+            if (!indexById.empty()) {
+                indexById[id] = bookings.size() - 1;
+            }
+            return;
+        }
+
+        if (indexById.empty()) {
+            for (size_t i = 0; i < bookings.size(); ++i) {
+                indexById[bookings[i].getBookingId()] = i;
+            }
+        }
+        auto it = indexById.find(id);
+        if (it != indexById.end()) {
+            bookings[it->second] = booking;
+        }
+        else {
+            indexById[id] = bookings.size();
+            bookings.push_back(booking);
+        }
+    });
+
+    if (skipped > 0) {
+        LOG_WARNING("Пропущено некоректних записів журналу " << journal.getPath() << ": " << skipped);
+    }
+    span.addArg("records", static_cast<std::int64_t>(journal.getRecordCount()));
+    return replayed;
 }
 
 bool BookingManager::loadBookings() {
+    OperationTimer timer(MetricOperation::LoadBookings);
+    TraceSpan span("loadBookings", "load");
     try {
         std::ifstream file(filename);
 
         if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл: " << filename << std::endl;
-            return false;
+            LOG_ERROR("Не вдалося відкрити файл: " << filename);
+            // Бронювання, створені до першого знімка, є лише в журналі
+            bookings.clear();
+            replayJournal();
+            cube.clear();
+            cubeBuilt = false;
+            return timer.result(false);
         }
 
         bookings.clear();
         std::string line;
+        std::vector<std::string> tokens;
+        Booking booking;
+        size_t skipped = 0;
 
         // Пропускаємо заголовок
         std::getline(file, line);
 
         while (std::getline(file, line)) {
+            span.lap("read");
             if (line.empty()) continue;
 
-            std::stringstream ss(line);
-            std::string token;
-            std::vector<std::string> tokens;
-
-            while (std::getline(ss, token, ',')) {
-                tokens.push_back(token);
+            if (!parseBookingRow(line, tokens, booking)) {
+                skipped++;
+                continue;
             }
-
-            if (tokens.size() < 9) continue;
-
-            int id = std::stoi(tokens[0]);
-            int hotelId = std::stoi(tokens[1]);
-            int roomNumber = std::stoi(tokens[2]);
-            std::string clientName = tokens[3];
-            std::string passport = tokens[4];
-            std::string checkIn = tokens[5];
-            std::string checkOut = tokens[6];
-            std::string status = tokens[7];
-            double totalPrice = std::stod(tokens[8]);
-
-            Booking booking(id, hotelId, roomNumber, clientName, passport, checkIn, checkOut);
-            booking.setStatus(status);
-            booking.setTotalPrice(totalPrice);
+            span.lap("parse");
 
             bookings.push_back(booking);
+            span.lap("append");
 
-            if (id >= nextBookingId) {
-                nextBookingId = id + 1;
+            if (booking.getBookingId() >= nextBookingId) {
+                nextBookingId = booking.getBookingId() + 1;
             }
         }
 
         file.close();
-        return true;
+        if (skipped > 0) {
+            LOG_WARNING("Пропущено пошкоджених рядків у " << filename << ": " << skipped);
+        }
+
+        // Відтворення коштує лише стільки, скільки записів з останнього знімка
+        bool replayed = replayJournal();
+        cube.clear();
+        cubeBuilt = false;
+        return timer.result(replayed);
 
     }
     catch (const std::exception& e) {
-        std::cerr << "Помилка завантаження бронювань: " << e.what() << std::endl;
-        return false;
+        LOG_ERROR("Помилка завантаження бронювань: " << e.what());
+        return timer.result(false);
     }
 }
 
 // Власні методи
 
-void BookingManager::displayAllBookings() const {
+void BookingManager::displayAllBookings(size_t offset, size_t limit) const {
     if (bookings.empty()) {
         std::cout << "\nНемає бронювань у базі даних." << std::endl;
         return;
     }
 
     std::cout << "\n========== СПИСОК БРОНЮВАНЬ ==========" << std::endl;
-    for (const auto& booking : bookings) {
-        booking.displayInfo();
-        std::cout << "----------------------------------------" << std::endl;
+    size_t written = 0;
+    {
+        ReportWriter writer(std::cout, ReportFormat::Table, reportColumns());
+        written = writeReport(writer, offset, limit);
+    }
+    if (written > 0) {
+        std::cout << "\nПоказано " << offset + 1 << "-" << offset + written
+            << " з " << bookings.size() << std::endl;
+    }
+    else {
+        std::cout << "\nВсього бронювань: " << bookings.size() << std::endl;
+    }
+}
+
+size_t BookingManager::writeReport(ReportWriter& writer, size_t offset, size_t limit) const {
+    size_t end = bookings.size();
+    if (offset >= end) {
+        return 0;
+    }
+    if (limit > 0 && limit < end - offset) {
+        end = offset + limit;
+    }
+
+    for (size_t i = offset; i < end; ++i) {
+        const Booking& booking = bookings[i];
+        writer.field(static_cast<std::int64_t>(booking.getBookingId()));
+        writer.field(static_cast<std::int64_t>(booking.getHotelId()));
+        writer.field(static_cast<std::int64_t>(booking.getRoomNumber()));
+        writer.field(booking.getClientName());
+        writer.field(booking.getPassport());
+        writer.field(booking.getCheckInDate());
+        writer.field(booking.getCheckOutDate());
+        writer.field(booking.getStatus());
+        writer.field(static_cast<std::int64_t>(booking.calculateNights()));
+        writer.field(booking.getTotalPrice());
+        writer.endRow();
     }
-    std::cout << "\nВсього бронювань: " << bookings.size() << std::endl;
+    return end - offset;
+}
+
+std::vector<ReportColumn> BookingManager::reportColumns() {
+    return {
+        { "id", "ID", 6 },
+        { "hotel_id", "Готель", 6 },
+        { "room", "Номер", 5 },
+        { "client", "Клієнт", 24 },
+        { "passport", "Паспорт", 8 },
+        { "check_in", "Заїзд", 10 },
+        { "check_out", "Виїзд", 10 },
+        { "status", "Статус", 9 },
+        { "nights", "Ночей", 5 },
+        { "total", "Вартість", 10 }
+    };
 }
 
 Booking* BookingManager::findBooking(int bookingId) {
@@ -295,6 +562,7 @@ Booking* BookingManager::findBooking(int bookingId) {
 }
 
 std::vector<Booking> BookingManager::findBookingsByClient(const std::string& clientName) const {
+    TraceSpan span("findBookingsByClient", "search");
     std::vector<Booking> result;
 
     std::copy_if(bookings.begin(), bookings.end(), std::back_inserter(result),
@@ -306,6 +574,7 @@ std::vector<Booking> BookingManager::findBookingsByClient(const std::string& cli
 }
 
 std::vector<Booking> BookingManager::findBookingsByPassport(const std::string& passport) const {
+    TraceSpan span("findBookingsByPassport", "search");
     std::vector<Booking> result;
 
     std::copy_if(bookings.begin(), bookings.end(), std::back_inserter(result),
@@ -317,6 +586,7 @@ std::vector<Booking> BookingManager::findBookingsByPassport(const std::string& p
 }
 
 std::vector<Booking> BookingManager::findBookingsByHotel(int hotelId) const {
+    TraceSpan span("findBookingsByHotel", "search");
     std::vector<Booking> result;
 
     std::copy_if(bookings.begin(), bookings.end(), std::back_inserter(result),
@@ -328,6 +598,7 @@ std::vector<Booking> BookingManager::findBookingsByHotel(int hotelId) const {
 }
 
 std::vector<Booking> BookingManager::findBookingsByStatus(const std::string& status) const {
+    TraceSpan span("findBookingsByStatus", "search");
     std::vector<Booking> result;
 
     std::copy_if(bookings.begin(), bookings.end(), std::back_inserter(result),
@@ -347,7 +618,7 @@ std::vector<Booking> BookingManager::sortByCheckInDate() const {
 
     std::sort(sorted.begin(), sorted.end(),
         [](const Booking& a, const Booking& b) {
-            return a.getCheckInDate() < b.getCheckInDate();
+            return Booking::dateKey(a.getCheckInDate()) < Booking::dateKey(b.getCheckInDate());
         });
 
     return sorted;
@@ -366,41 +637,65 @@ std::vector<Booking> BookingManager::sortByPrice() const {
 
 std::vector<Booking> BookingManager::filterByDateRange(const std::string& startDate,
     const std::string& endDate) const {
+    TraceSpan span("filterByDateRange", "search");
     std::vector<Booking> result;
+    int startKey = Booking::dateKey(startDate);
+    int endKey = Booking::dateKey(endDate);
 
     std::copy_if(bookings.begin(), bookings.end(), std::back_inserter(result),
-        [&startDate, &endDate](const Booking& booking) {
-            return booking.getCheckInDate() >= startDate &&
-                booking.getCheckInDate() <= endDate;
+        [startKey, endKey](const Booking& booking) {
+            int checkInKey = Booking::dateKey(booking.getCheckInDate());
+            return checkInKey >= startKey && checkInKey <= endKey;
         });
 
     return result;
 }
 
 bool BookingManager::completeBooking(int bookingId) {
-    Booking* booking = findBooking(bookingId);
-
-    if (!booking) {
-        std::cerr << "Бронювання не знайдено!" << std::endl;
-        return false;
-    }
-
-    booking->complete();
-    return saveBookings();
+    return changeStatus(bookingId, true);
 }
 
 int BookingManager::getBookingCount() const {
     return bookings.size();
 }
 
-double BookingManager::calculateTotalRevenue() const {
-    double total = 0.0;
+Money BookingManager::calculateTotalRevenue() const {
+    // Ціле накопичення в копійках точне незалежно від порядку додавання
+    std::int64_t totalKopecks = 0;
 
     for (const auto& booking : bookings) {
         if (booking.getStatus() == BOOKING_STATUS_COMPLETED) {
-            total += booking.getTotalPrice();
+            totalKopecks += booking.getTotalPrice().getKopecks();
         }
     }
 
-    return total;
+    return Money(totalKopecks);
+}
+
+bool BookingManager::queryCube(int hotelId, const std::string& roomClass,
+    const std::string& fromDate, const std::string& toDate, CubeTotals& totals) {
+    ensureCube();
+    return cube.query(hotelId, roomClass, fromDate, toDate, totals);
+}
+
+BookingAnalytics BookingManager::analyzeCube(int fromMonth, int toMonth) {
+    TraceSpan span("analyzeCube", "analytics");
+    if (!hotelManager) {
+        LOG_WARNING("HotelManager не встановлено!");
+        return BookingAnalytics();
+    }
+    ensureCube();
+    return BookingAnalytics::fromCube(cube, hotelManager->getHotels(), fromMonth, toMonth);
+}
+
+BookingAnalytics BookingManager::analyze(int fromMonth, int toMonth) const {
+    TraceSpan span("analyze", "analytics");
+    if (!hotelManager) {
+        LOG_WARNING("HotelManager не встановлено!");
+        return BookingAnalytics();
+    }
+
+    BookingAnalytics analytics = BookingAnalytics::compute(bookings, hotelManager->getHotels(), fromMonth, toMonth);
+    span.addArg("bookings", static_cast<std::int64_t>(analytics.getCountedBookings()));
+    return analytics;
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "Booking.h"
 #include "IBookingService.h"
 #include "HotelManager.h"
+#include "ReportWriter.h"
+#include "BookingAnalytics.h"
+#include "BookingCube.h"
+#include "Journal.h"
 #include <vector>
 #include <string>
 
@@ -20,6 +24,32 @@ private:
     std::string filename;
     int nextBookingId;
     HotelManager* hotelManager;
+    bool autoSave;
+    BookingCube cube;
+    bool cubeBuilt;             // куб будується при першому запиті, а не при завантаженні
+    Journal journal;
+
+    // Дописує нову версію бронювання в журнал, якщо автозбереження увімкнене.
+    // Викликається до зміни пам'яті: при невдачі стан лишається попереднім
+    bool persist(const Booking& booking);
+
+    // Робить повний знімок, коли журнал перевищив межу (після зміни пам'яті)
+    void compactJournal();
+
+    // Застосовує зафіксовані записи журналу поверх завантаженого знімка
+    bool replayJournal();
+
+    // Рядок бронювання у форматі bookings.csv (без символу нового рядка)
+    static void writeBookingRow(std::ostream& out, const Booking& booking);
+
+    // Розбирає рядок bookings.csv; false, якщо полів бракує або вони некоректні
+    static bool parseBookingRow(const std::string& line, std::vector<std::string>& tokens, Booking& booking);
+
+    // Визначає класи номерів бронювань і будує куб, якщо його ще немає
+    void ensureCube();
+
+    // Змінює статус бронювання і переносить його внесок у кубі
+    bool changeStatus(int bookingId, bool complete);
 
 public:
     // Конструктори
@@ -38,11 +68,23 @@ public:
     // Getters
     std::vector<Booking> getBookings() const;
     int getNextBookingId() const;
+    bool getAutoSave() const;
 
     // Setters
     void setFilename(const std::string& filename);
     void setHotelManager(HotelManager* manager);
 
+    /**
+     * @brief Вмикає або вимикає збереження файлу після кожної зміни
+     *
+     * Кожна зміна дописується в журнал з fsync, а повний знімок пишеться
+     * лише після BOOKINGS_JOURNAL_COMPACT_THRESHOLD записів. Пакетний режим
+     * вимикає автозбереження і зберігає знімок один раз наприкінці, щоб
+     * операції не чекали диска.
+     * @param enabled true - зберігати після кожної зміни (за замовчуванням)
+     */
+    void setAutoSave(bool enabled);
+
     // Реалізація методів інтерфейсу IBookingService
     bool checkAvailability(int hotelId, int roomNumber,
         const std::string& checkIn,
@@ -65,9 +107,25 @@ public:
     // Власні методи (мінімум 5)
 
     /**
-     * @brief Виводить всі бронювання
+     * @brief Виводить сторінку бронювань таблицею
+     * @param offset Номер першого бронювання (з 0)
+     * @param limit Кількість бронювань на сторінці (0 - до кінця)
+     */
+    void displayAllBookings(size_t offset = 0, size_t limit = 0) const;
+
+    /**
+     * @brief Записує сторінку бронювань у звіт
+     * @param writer Звіт, створений з колонками reportColumns()
+     * @param offset Номер першого бронювання (з 0)
+     * @param limit Кількість бронювань (0 - до кінця)
+     * @return Кількість записаних рядків
      */
-    void displayAllBookings() const;
+    size_t writeReport(ReportWriter& writer, size_t offset = 0, size_t limit = 0) const;
+
+    /**
+     * @brief Колонки звіту бронювань
+     */
+    static std::vector<ReportColumn> reportColumns();
 
     /**
      * @brief Знаходить бронювання за ID
@@ -146,9 +204,45 @@ public:
 
     /**
      * @brief Розраховує загальний дохід від бронювань
-     * @return Сума доходу
+     * @return Сума доходу (точна, у копійках)
+     */
+    Money calculateTotalRevenue() const;
+
+    /**
+     * @brief Обчислює завантаженість, ADR та RevPAR за готелями, містами, класами й місяцями
+     * @param fromMonth Перший місяць YYYYMM (0 - відкритий початок: від найранішого заїзду)
+     * @param toMonth Останній місяць YYYYMM (0 - відкритий кінець: до останньої ночі)
+     * @return Показники (порожні, якщо HotelManager не встановлено або fromMonth > toMonth)
+     */
+    BookingAnalytics analyze(int fromMonth = 0, int toMonth = 0) const;
+
+    /**
+     * @brief Ті самі показники, що й analyze(), але з куба бронювань
+     *
+     * Куб будується при першому виклику, далі запити не проходять по
+     * бронюваннях, тож підходить для панелі статистики, яку відкривають
+     * повторно. Лічильники бронювань у результаті нульові.
+     * @param fromMonth Перший місяць YYYYMM (0 - за найранішою ніччю)
+     * @param toMonth Останній місяць YYYYMM (0 - за найпізнішою ніччю)
+     * @return Показники (порожні, якщо HotelManager не встановлено)
+     */
+    BookingAnalytics analyzeCube(int fromMonth = 0, int toMonth = 0);
+
+    /**
+     * @brief Підсумки з куба "готель x клас x день" за проміжком дат
+     *
+     * Куб будується при першому запиті і далі оновлюється при створенні,
+     * скасуванні та завершенні бронювань, тож наступні запити не
+     * переглядають бронювання.
+     * @param hotelId ID готелю або 0 для всіх
+     * @param roomClass Клас номера або порожній рядок для всіх
+     * @param fromDate Перший день DD.MM.YYYY (включно)
+     * @param toDate Останній день DD.MM.YYYY (не включно)
+     * @param totals Результат
+     * @return true якщо успішно, false якщо параметри некоректні
      */
-    double calculateTotalRevenue() const;
+    bool queryCube(int hotelId, const std::string& roomClass,
+        const std::string& fromDate, const std::string& toDate, CubeTotals& totals);
 };
 
 #endif // BOOKINGMANAGER_H
\ No newline at end of file
@@ -1,48 +1,39 @@
 ﻿#include "BudgetHotel.h"
 #include "Constants.hpp"
+#include "Logger.h"
 #include <iostream>
 #include <iomanip>
 
 // Конструктор за замовчуванням
 BudgetHotel::BudgetHotel()
-    : HotelBase(), stars(2), hasFreeWifi(false), hasFreeParking(false),
-    hasBreakfast(false), discountPercent(0.0) {
+    : HotelBase(HotelType::Budget, 2), discountPercent(0.0) {
 }
 
 // Конструктор з параметрами
 BudgetHotel::BudgetHotel(int id, const std::string& name, const std::string& city,
     const std::string& description, int stars)
-    : HotelBase(id, name, city, description), stars(stars),
-    hasFreeWifi(false), hasFreeParking(false), hasBreakfast(false), discountPercent(0.0) {
+    : HotelBase(HotelType::Budget, id, name, city, description, stars), discountPercent(0.0) {
 }
 
 // Копіювальний конструктор
 BudgetHotel::BudgetHotel(const BudgetHotel& other)
-    : HotelBase(other), stars(other.stars), hasFreeWifi(other.hasFreeWifi),
-    hasFreeParking(other.hasFreeParking), hasBreakfast(other.hasBreakfast),
-    discountPercent(other.discountPercent) {
+    : HotelBase(other), discountPercent(other.discountPercent) {
 }
 
 // Переміщувальний конструктор
 BudgetHotel::BudgetHotel(BudgetHotel&& other) noexcept
-    : HotelBase(std::move(other)), stars(other.stars), hasFreeWifi(other.hasFreeWifi),
-    hasFreeParking(other.hasFreeParking), hasBreakfast(other.hasBreakfast),
-    discountPercent(other.discountPercent) {
+    : HotelBase(std::move(other)), discountPercent(other.discountPercent) {
 }
 
 // Деструктор
 BudgetHotel::~BudgetHotel() {
-    std::cout << "Об'єкт BudgetHotel '" << getName() << "' знищено." << std::endl;
+    LOG_DEBUG("Об'єкт BudgetHotel '" << getName() << "' знищено.");
 }
 
 // Оператор копіювального присвоєння
 BudgetHotel& BudgetHotel::operator=(const BudgetHotel& other) {
     if (this != &other) {
         HotelBase::operator=(other);
-        stars = other.stars;
-        hasFreeWifi = other.hasFreeWifi;
-        hasFreeParking = other.hasFreeParking;
-        hasBreakfast = other.hasBreakfast;
         discountPercent = other.discountPercent;
     }
     return *this;
@@ -52,30 +43,22 @@ BudgetHotel& BudgetHotel::operator=(const BudgetHotel& other) {
 BudgetHotel& BudgetHotel::operator=(BudgetHotel&& other) noexcept {
     if (this != &other) {
         HotelBase::operator=(std::move(other));
-        stars = other.stars;
-        hasFreeWifi = other.hasFreeWifi;
-        hasFreeParking = other.hasFreeParking;
-        hasBreakfast = other.hasBreakfast;
         discountPercent = other.discountPercent;
     }
     return *this;
 }
 
 // Getters
-int BudgetHotel::getStars() const {
-    return stars;
-}
-
 bool BudgetHotel::getHasFreeWifi() const {
-    return hasFreeWifi;
+    return hasAmenities(AmenityDictionary::bit(Amenity::WiFi));
 }
 
 bool BudgetHotel::getHasFreeParking() const {
-    return hasFreeParking;
+    return hasAmenities(AmenityDictionary::bit(Amenity::Parking));
 }
 
 bool BudgetHotel::getHasBreakfast() const {
-    return hasBreakfast;
+    return hasAmenities(AmenityDictionary::bit(Amenity::Breakfast));
 }
 
 double BudgetHotel::getDiscountPercent() const {
@@ -83,32 +66,25 @@ double BudgetHotel::getDiscountPercent() const {
 }
 
 // Setters
-void BudgetHotel::setStars(int stars) {
-    this->stars = stars;
-}
-
 void BudgetHotel::setHasFreeWifi(bool hasFreeWifi) {
-    this->hasFreeWifi = hasFreeWifi;
+    setAmenity(Amenity::WiFi, hasFreeWifi);
 }
 
 void BudgetHotel::setHasFreeParking(bool hasFreeParking) {
-    this->hasFreeParking = hasFreeParking;
+    setAmenity(Amenity::Parking, hasFreeParking);
 }
 
 void BudgetHotel::setHasBreakfast(bool hasBreakfast) {
-    this->hasBreakfast = hasBreakfast;
+    setAmenity(Amenity::Breakfast, hasBreakfast);
 }
 
 void BudgetHotel::setDiscountPercent(double discountPercent) {
     this->discountPercent = discountPercent;
+    markDirty();
 }
 
 // Реалізація віртуальних методів
 
-std::string BudgetHotel::getType() const {
-    return HOTEL_TYPE_BUDGET;
-}
-
 void BudgetHotel::displayInfo() const {
     std::cout << "\n========================================" << std::endl;
     std::cout << "BUDGET HOTEL" << std::endl;
@@ -126,9 +102,9 @@ void BudgetHotel::displayInfo() const {
         std::cout << "Знижка: " << discountPercent << "%" << std::endl;
     }
 
-    std::cout << "Безкоштовний WiFi: " << (hasFreeWifi ? "Так" : "Ні") << std::endl;
-    std::cout << "Безкоштовна парковка: " << (hasFreeParking ? "Так" : "Ні") << std::endl;
-    std::cout << "Сніданок: " << (hasBreakfast ? "Так" : "Ні") << std::endl;
+    std::cout << "Безкоштовний WiFi: " << (getHasFreeWifi() ? "Так" : "Ні") << std::endl;
+    std::cout << "Безкоштовна парковка: " << (getHasFreeParking() ? "Так" : "Ні") << std::endl;
+    std::cout << "Сніданок: " << (getHasBreakfast() ? "Так" : "Ні") << std::endl;
     std::cout << "========================================" << std::endl;
 }
 
@@ -137,12 +113,7 @@ double BudgetHotel::calculateAveragePrice() const {
         return 0.0;
     }
 
-    double totalPrice = 0.0;
-    for (const auto& room : rooms) {
-        totalPrice += room.getPricePerNight();
-    }
-
-    double avgPrice = totalPrice / rooms.size();
+    double avgPrice = priceStats.averagePrice();
 
     if (discountPercent > 0) {
         avgPrice = avgPrice * (1.0 - discountPercent / 100.0);
@@ -159,9 +130,9 @@ void BudgetHotel::applyDiscountToAllRooms() {
         return;
     }
 
-    for (auto& room : rooms) {
-        room.applyDiscount(discountPercent);
-    }
+    PriceAdjustment adjustment;
+    adjustment.percent = -discountPercent;
+    repriceRooms(RoomClass::Unknown, adjustment);
 
     std::cout << "Знижку " << discountPercent << "% застосовано до всіх номерів." << std::endl;
 }
@@ -171,27 +142,24 @@ double BudgetHotel::calculateSavings(int nights) const {
         return 0.0;
     }
 
-    double totalOriginalPrice = 0.0;
-    for (const auto& room : rooms) {
-        totalOriginalPrice += room.getPricePerNight();
-    }
-
-    double avgOriginalPrice = rooms.empty() ? 0.0 : totalOriginalPrice / rooms.size();
+    double avgOriginalPrice = priceStats.averagePrice();
     double savings = avgOriginalPrice * (discountPercent / 100.0) * nights;
 
     return savings;
 }
 
 bool BudgetHotel::hasFreeServices() const {
-    return hasFreeWifi || hasFreeParking || hasBreakfast;
+    const AmenityMask freeServices = AmenityDictionary::bit(Amenity::WiFi) |
+        AmenityDictionary::bit(Amenity::Parking) | AmenityDictionary::bit(Amenity::Breakfast);
+    return (amenities & freeServices) != 0;
 }
 
 std::string BudgetHotel::getFreeServicesList() const {
     std::string services;
 
-    if (hasFreeWifi) services += "WiFi, ";
-    if (hasFreeParking) services += "Парковка, ";
-    if (hasBreakfast) services += "Сніданок, ";
+    if (getHasFreeWifi()) services += "WiFi, ";
+    if (getHasFreeParking()) services += "Парковка, ";
+    if (getHasBreakfast()) services += "Сніданок, ";
 
     if (!services.empty()) {
         services = services.substr(0, services.length() - 2);
@@ -222,9 +190,9 @@ bool BudgetHotel::validate() const {
 int BudgetHotel::calculateRating() const {
     int rating = stars * 20;
 
-    if (hasFreeWifi) rating += 10;
-    if (hasFreeParking) rating += 10;
-    if (hasBreakfast) rating += 10;
+    if (getHasFreeWifi()) rating += 10;
+    if (getHasFreeParking()) rating += 10;
+    if (getHasBreakfast()) rating += 10;
 
     if (discountPercent >= 10) rating += 5;
     if (discountPercent >= 20) rating += 5;
@@ -8,14 +8,11 @@
  * @class BudgetHotel
  * @brief Клас-нащадок для бюджетних готелів (1-3 зірки)
  *
- * Додає специфічні поля та методи для готелів економ-класу
+ * Додає специфічні поля та методи для готелів економ-класу.
+ * Безкоштовні послуги (WiFi, парковка, сніданок) зберігаються у масці зручностей HotelBase.
  */
 class BudgetHotel : public HotelBase {
 private:
-    int stars;
-    bool hasFreeWifi;
-    bool hasFreeParking;
-    bool hasBreakfast;
     double discountPercent;
 
 public:
@@ -34,21 +31,18 @@ public:
     BudgetHotel& operator=(BudgetHotel&& other) noexcept;
 
     // Getters
-    int getStars() const;
     bool getHasFreeWifi() const;
     bool getHasFreeParking() const;
     bool getHasBreakfast() const;
     double getDiscountPercent() const;
 
     // Setters
-    void setStars(int stars);
     void setHasFreeWifi(bool hasFreeWifi);
     void setHasFreeParking(bool hasFreeParking);
     void setHasBreakfast(bool hasBreakfast);
     void setDiscountPercent(double discountPercent);
 
     // Реалізація віртуальних методів
-    std::string getType() const override;
     void displayInfo() const override;
     double calculateAveragePrice() const override;
 
@@ -8,6 +8,58 @@ const std::string USERS_FILE = "users.txt";
 const std::string HOTELS_FILE = "hotels.csv";
 const std::string BOOKINGS_FILE = "bookings.csv";
 
+// Маркери секцій нормалізованого каталогу готелів
+const std::string CATALOG_SECTION_HOTELS = "[hotels]";
+const std::string CATALOG_SECTION_ROOMS = "[rooms]";
+
+// Журнал інкрементальних змін каталогу (дописується до імені файлу каталогу)
+const std::string CATALOG_JOURNAL_SUFFIX = ".journal";
+const int CATALOG_JOURNAL_COMPACT_THRESHOLD = 10000;
+
+// Журнал змін бронювань: після скількох записів робити повний знімок
+const std::string BOOKINGS_JOURNAL_SUFFIX = ".journal";
+const int BOOKINGS_JOURNAL_COMPACT_THRESHOLD = 10000;
+
+// Відновлення після збою: знімки пишуться у тимчасовий файл і перейменовуються,
+// журнали починаються із заголовка формату з транзакціями під CRC32
+const std::string SNAPSHOT_TEMP_SUFFIX = ".tmp";
+const std::string JOURNAL_HEADER = "#journal v2";
+const std::string JOURNAL_CORRUPT_SUFFIX = ".corrupt";
+
+// Масова зміна цін: з якої кількості готелів розпаралелювати прохід
+const int REPRICE_PARALLEL_MIN_HOTELS = 256;
+
+// Хешування паролів (PBKDF2-HMAC-SHA256) та сесії
+const std::string PASSWORD_HASH_SCHEME = "pbkdf2-sha256";
+const int PASSWORD_HASH_ITERATIONS = 100000;
+const int PASSWORD_SALT_BYTES = 16;
+const int SESSION_TOKEN_BYTES = 32;
+const int SESSION_TTL_SECONDS = 8 * 60 * 60;
+const int SESSION_SHARD_COUNT = 16;
+
+// Інкрементальний файл користувачів: дописування записів і надгробків "-логін"
+const std::string USERS_TEMP_SUFFIX = ".tmp";
+const int USERS_COMPACT_MIN_RECORDS = 1024;
+
+// Вбудований HTTP-сервіс (лише 127.0.0.1)
+const int HTTP_DEFAULT_PORT = 8080;
+const int HTTP_DEFAULT_WORKERS = 4;
+const int HTTP_LISTEN_BACKLOG = 512;
+const size_t HTTP_MAX_HEADER_BYTES = 16 * 1024;
+const size_t HTTP_MAX_BODY_BYTES = 1024 * 1024;
+
+// Асинхронний журнал: кільцевий буфер повідомлень і обмеження частоти на місце виклику
+const size_t LOG_QUEUE_CAPACITY = 4096;     // степінь двійки
+const size_t LOG_MESSAGE_MAX_BYTES = 240;
+const unsigned LOG_RATE_LIMIT_PER_SECOND = 20;
+
+// Аналітика бронювань: з якої кількості бронювань розпаралелювати прохід
+const int ANALYTICS_PARALLEL_MIN_BOOKINGS = 50000;
+
+// Звіти: розмір буфера виведення та сторінки в інтерактивному перегляді
+const size_t REPORT_BUFFER_BYTES = 64 * 1024;
+const size_t REPORT_PAGE_SIZE = 50;
+
 // Рівні доступу користувачів
 const int ACCESS_LEVEL_ADMIN = 1;
 const int ACCESS_LEVEL_USER = 2;
@@ -1,12 +1,24 @@
 ﻿#include <iostream>
+#include <fstream>
+#include <sstream>
 #include <limits>
 #include <string>
+#include <chrono>
+#include <thread>
+#include <csignal>
 #include "Constants.hpp"
 #include "UserAccountManager.h"
 #include "HotelManager.h"
 #include "BookingManager.h"
 #include "PremiumHotel.h"
 #include "BudgetHotel.h"
+#include "BatchRunner.h"
+#include "BookingApi.h"
+#include "HttpServer.h"
+#include "DatasetGenerator.h"
+#include "OperationMetrics.h"
+#include "Logger.h"
+#include "ReportWriter.h"
 
 // Функція для очищення буфера вводу
 void clearInput() {
@@ -16,10 +28,28 @@ void clearInput() {
 
 // Функція для очікування натискання Enter
 void waitForEnter() {
+    Logger::flush();
     std::cout << "\nНатисніть Enter для продовження...";
     clearInput();
 }
 
+// Функція посторінкового перегляду (showPage виводить сторінку за offset і limit)
+template <typename ShowPage>
+void browsePages(size_t total, ShowPage showPage) {
+    for (size_t offset = 0; ; offset += REPORT_PAGE_SIZE) {
+        showPage(offset, REPORT_PAGE_SIZE);
+        if (offset + REPORT_PAGE_SIZE >= total) {
+            break;
+        }
+
+        std::cout << "\nEnter - наступна сторінка, q - повернутися до меню: ";
+        std::string answer;
+        if (!std::getline(std::cin, answer) || answer == "q") {
+            break;
+        }
+    }
+}
+
 // Функція виведення головного меню
 void displayMainMenu(bool isAdmin) {
     std::cout << "\n╔════════════════════════════════════════╗" << std::endl;
@@ -39,6 +69,7 @@ void displayMainMenu(bool isAdmin) {
         std::cout << "9.  Додати номер до готелю" << std::endl;
         std::cout << "10. Управління користувачами" << std::endl;
         std::cout << "11. Статистика" << std::endl;
+        std::cout << "13. Масова зміна цін" << std::endl;
     }
 
     std::cout << "\n12. Інструкція користувача" << std::endl;
@@ -67,6 +98,52 @@ void displayHelp() {
     std::cout << "\n=== Адміністративні функції ===" << std::endl;
     std::cout << "Доступні лише для адміністратора." << std::endl;
     std::cout << "Дозволяють додавати/видаляти готелі, керувати користувачами." << std::endl;
+    std::cout << "\n=== Пакетний режим ===" << std::endl;
+    std::cout << "Coursework1 --batch <файл сценарію> (або '-' для стандартного вводу)" << std::endl;
+    std::cout << "виконує команди без меню і виводить результати у форматі JSON." << std::endl;
+    std::cout << "Coursework1 --serve [порт] [потоки] запускає HTTP/JSON-сервіс на 127.0.0.1." << std::endl;
+    std::cout << "Coursework1 --generate <тека> [--seed N] [--hotels N] [--bookings N] [--users N]" << std::endl;
+    std::cout << "створює синтетичні hotels.csv, bookings.csv та users.txt у вказаній теці." << std::endl;
+    std::cout << "Змінна середовища COURSEWORK1_TRACE=<файл.json> вмикає запис трасування" << std::endl;
+    std::cout << "завантаження, збереження та пошуку у форматі Chrome (chrome://tracing)." << std::endl;
+    std::cout << "Coursework1 --report hotels|bookings [--format table|csv|json] [--out файл]" << std::endl;
+    std::cout << "[--offset N] [--limit N] виводить список готелів або бронювань без меню." << std::endl;
+    std::cout << "Coursework1 --report kpi [--by hotel|city|class|total] [--period all|month]" << std::endl;
+    std::cout << "[--from YYYYMM] [--to YYYYMM] виводить завантаженість, ADR та RevPAR." << std::endl;
+    std::cout << "COURSEWORK1_LOG_LEVEL=debug|info|warning|error|off задає рівень журналу в stderr." << std::endl;
+}
+
+// Функція виведення фасетів каталогу
+void displayFacets(const FacetCounts& counts) {
+    std::cout << "\n=== Огляд каталогу ===" << std::endl;
+    std::cout << "Готелів: " << counts.hotelCount << std::endl;
+
+    std::cout << "\nЗа містом:" << std::endl;
+    for (const auto& city : counts.hotelsByCity) {
+        std::cout << "  " << city.first << ": " << city.second << std::endl;
+    }
+
+    std::cout << "\nЗа зірками:" << std::endl;
+    for (int stars = MIN_STARS; stars <= MAX_STARS; ++stars) {
+        if (counts.hotelsByStars[stars] > 0) {
+            std::cout << "  " << stars << ": " << counts.hotelsByStars[stars] << std::endl;
+        }
+    }
+
+    std::cout << "\nЗа типом:" << std::endl;
+    std::cout << "  " << HOTEL_TYPE_PREMIUM << ": " << counts.hotelsByType[0] << std::endl;
+    std::cout << "  " << HOTEL_TYPE_BUDGET << ": " << counts.hotelsByType[1] << std::endl;
+
+    std::cout << "\nНомери за класом:" << std::endl;
+    std::cout << "  " << ROOM_CLASS_LUXURY << ": " << counts.roomsByClass[0] << std::endl;
+    std::cout << "  " << ROOM_CLASS_STANDARD << ": " << counts.roomsByClass[1] << std::endl;
+    std::cout << "  " << ROOM_CLASS_ECONOMY << ": " << counts.roomsByClass[2] << std::endl;
+
+    std::cout << "\nНомери за ціною (грн/ніч):" << std::endl;
+    for (int bucket = 0; bucket < FacetCounts::PRICE_BUCKET_COUNT; ++bucket) {
+        std::cout << "  " << FacetCounts::priceBucketLabel(bucket) << ": "
+            << counts.roomsByPriceBucket[bucket] << std::endl;
+    }
 }
 
 // Функція пошуку готелів
@@ -76,6 +153,9 @@ void searchHotels(HotelManager& hotelManager) {
     std::cout << "2. За типом (Premium/Budget)" << std::endl;
     std::cout << "3. За кількістю зірок" << std::endl;
     std::cout << "4. Пошук вільних номерів" << std::endl;
+    std::cout << "5. Огляд каталогу (фасети)" << std::endl;
+    std::cout << "6. Пошук за початком назви або міста" << std::endl;
+    std::cout << "7. За зручностями" << std::endl;
     std::cout << "Виберіть опцію: ";
 
     int choice;
@@ -163,6 +243,64 @@ void searchHotels(HotelManager& hotelManager) {
             }
             break;
         }
+        case 5: {
+            FacetFilter filter;
+
+            std::cout << "Введіть місто (або Enter для пропуску): ";
+            std::getline(std::cin, filter.city);
+
+            std::cout << "Введіть тип (Premium/Budget або Enter): ";
+            std::getline(std::cin, filter.type);
+
+            std::cout << "Введіть клас номера (Luxury/Standard/Economy або Enter): ";
+            std::getline(std::cin, filter.roomClass);
+
+            std::cout << "Введіть кількість зірок (0 - будь-яка): ";
+            std::cin >> filter.stars;
+            clearInput();
+
+            displayFacets(hotelManager.getFacetCounts(filter));
+            break;
+        }
+        case 6: {
+            std::cout << "Введіть початок назви або міста: ";
+            std::string prefix;
+            std::getline(std::cin, prefix);
+
+            auto results = hotelManager.suggestHotels(prefix);
+            if (results.empty()) {
+                std::cout << "Готелі не знайдено." << std::endl;
+            }
+            else {
+                for (const auto& hotel : results) {
+                    std::cout << "ID " << hotel->getHotelId() << ": " << hotel->getName()
+                        << " (" << hotel->getCity() << ")" << std::endl;
+                }
+            }
+            break;
+        }
+        case 7: {
+            std::cout << "Введіть зручності через ';' (наприклад, SPA;Pool;Restaurant): ";
+            std::string list;
+            std::getline(std::cin, list);
+
+            AmenityMask required = AmenityDictionary::parseList(list, ';');
+            if (required == 0) {
+                std::cout << "Не вказано жодної відомої зручності." << std::endl;
+                break;
+            }
+
+            auto results = hotelManager.findHotelsWithAmenities(required);
+            if (results.empty()) {
+                std::cout << "Готелі не знайдено." << std::endl;
+            }
+            else {
+                for (const auto& hotel : results) {
+                    hotel->displayInfo();
+                }
+            }
+            break;
+        }
         default:
             std::cout << "Некоректний вибір!" << std::endl;
         }
@@ -365,6 +503,52 @@ void addHotel(HotelManager& hotelManager) {
     }
 }
 
+// Функція масової зміни цін
+void repriceRooms(HotelManager& hotelManager) {
+    std::cout << "\n=== Масова зміна цін ===" << std::endl;
+
+    RepriceRule rule;
+
+    std::cout << "Введіть місто (або Enter для всіх): ";
+    std::getline(std::cin, rule.city);
+
+    std::cout << "Введіть тип (Premium/Budget або Enter): ";
+    std::getline(std::cin, rule.type);
+
+    std::cout << "Введіть клас номера (Luxury/Standard/Economy або Enter): ";
+    std::getline(std::cin, rule.roomClass);
+
+    std::cout << "Спосіб зміни:" << std::endl;
+    std::cout << "1. На відсоток" << std::endl;
+    std::cout << "2. На суму (грн)" << std::endl;
+    std::cout << "Ваш вибір: ";
+
+    int mode;
+    std::cin >> mode;
+
+    std::cout << "Введіть зміну (від'ємне значення - знижка): ";
+    double value;
+    std::cin >> value;
+    clearInput();
+
+    if (mode == 1) {
+        rule.adjustment.mode = RepriceMode::Percent;
+        rule.adjustment.percent = value;
+    }
+    else {
+        rule.adjustment.mode = RepriceMode::Absolute;
+        rule.adjustment.amount = Money::fromHryvnias(value);
+    }
+
+    int repricedRooms = 0;
+    if (hotelManager.repriceRooms(rule, repricedRooms)) {
+        std::cout << "\n✓ Ціни змінено для " << repricedRooms << " номерів." << std::endl;
+    }
+    else {
+        std::cout << "\n✗ Помилка зміни цін!" << std::endl;
+    }
+}
+
 // Функція управління користувачами
 void manageUsers(UserAccountManager& userManager) {
     std::cout << "\n=== Управління користувачами ===" << std::endl;
@@ -436,9 +620,341 @@ void displayStatistics(HotelManager& hotelManager, BookingManager& bookingManage
     std::cout << "Всього бронювань: " << bookingManager.getBookingCount() << std::endl;
     std::cout << "Активних бронювань: " << bookingManager.getActiveBookings().size() << std::endl;
     std::cout << "Загальний дохід: " << bookingManager.calculateTotalRevenue() << " грн" << std::endl;
+
+    // Панель читає куб, тож повторне відкриття не проходить по всіх бронюваннях
+    BookingAnalytics analytics = bookingManager.analyzeCube();
+    if (analytics.getFromMonth() > 0) {
+        std::cout << "\n=== Завантаженість, ADR та RevPAR (" << analytics.getFromMonth() / 100 << "."
+            << analytics.getFromMonth() % 100 << " - " << analytics.getToMonth() / 100 << "."
+            << analytics.getToMonth() % 100 << ") ===" << std::endl;
+
+        const std::pair<KpiDimension, bool> sections[] = {
+            { KpiDimension::Total, false },
+            { KpiDimension::RoomClass, false },
+            { KpiDimension::City, false },
+            { KpiDimension::Total, true }
+        };
+        for (const auto& section : sections) {
+            std::cout << std::endl;
+            ReportWriter writer(std::cout, ReportFormat::Table, BookingAnalytics::reportColumns());
+            BookingAnalytics::writeReport(analytics.rows(section.first, section.second), writer);
+        }
+    }
+
+    std::cout << "\nПеріод для зведення (DD.MM.YYYY DD.MM.YYYY, Enter - пропустити): ";
+    std::string period;
+    std::getline(std::cin, period);
+    if (!period.empty()) {
+        std::istringstream periodStream(period);
+        std::string fromDate;
+        std::string toDate;
+        std::string roomClass;
+        periodStream >> fromDate >> toDate >> roomClass;
+
+        CubeTotals totals;
+        if (bookingManager.queryCube(0, roomClass, fromDate, toDate, totals)) {
+            std::cout << "Заброньовано номеро-ночей: " << totals.bookedNights << std::endl;
+            std::cout << "Скасувань (за днем заїзду): " << totals.cancellations << std::endl;
+            std::cout << "Дохід за період: " << totals.revenue << " грн" << std::endl;
+            std::cout << "  з них завершені: " << totals.completedRevenue << " грн" << std::endl;
+        }
+        else {
+            std::cout << "✗ Некоректний період або клас номера!" << std::endl;
+        }
+    }
+
+    std::cout << "\n=== Метрики операцій ===" << std::endl;
+    OperationMetrics::printReport(std::cout);
+
+    std::cout << "\nФайл для збереження метрик (Enter - пропустити): ";
+    std::string filename;
+    std::getline(std::cin, filename);
+    if (!filename.empty()) {
+        if (OperationMetrics::writeReport(filename)) {
+            std::cout << "\n✓ Метрики збережено у " << filename << std::endl;
+        }
+        else {
+            std::cout << "\n✗ Помилка збереження метрик!" << std::endl;
+        }
+    }
+}
+
+// Функція пакетного виконання сценарію (без меню та пауз)
+int runBatch(const std::string& scriptPath) {
+    // Результати пишуться напряму у буфер stdout, а звичайний вивід менеджерів
+    // (повідомлення деструкторів тощо) приглушується, щоб не псувати JSON
+    std::ostream results(std::cout.rdbuf());
+    std::cout.setstate(std::ios_base::badbit);
+
+    int exitCode = 0;
+    try {
+        std::ifstream scriptFile;
+        if (scriptPath != "-") {
+            scriptFile.open(scriptPath);
+            if (!scriptFile.is_open()) {
+                std::cerr << "Не вдалося відкрити файл сценарію: " << scriptPath << std::endl;
+                std::cout.clear();
+                return 1;
+            }
+        }
+        std::istream& input = scriptPath == "-" ? std::cin : scriptFile;
+
+        UserAccountManager userManager;
+        HotelManager hotelManager;
+        BookingManager bookingManager(BOOKINGS_FILE, &hotelManager);
+
+        userManager.loadUsers();
+        hotelManager.loadHotels();
+        bookingManager.loadBookings();
+
+        BatchRunner runner(userManager, hotelManager, bookingManager, results);
+        auto start = std::chrono::steady_clock::now();
+        bool success = runner.run(input);
+        runner.writeSummary(std::chrono::steady_clock::now() - start);
+
+        exitCode = success ? 0 : 2;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Критична помилка: " << e.what() << std::endl;
+        exitCode = 1;
+    }
+
+    std::cout.clear();
+    return exitCode;
 }
 
-int main() {
+// Прапорець зупинки сервісу (встановлюється обробником SIGINT/SIGTERM)
+volatile std::sig_atomic_t stopRequested = 0;
+
+void requestStop(int) {
+    stopRequested = 1;
+}
+
+// Функція запуску HTTP/JSON-сервісу до сигналу зупинки
+int runServer(int port, int workerCount) {
+    try {
+        UserAccountManager userManager;
+        HotelManager hotelManager;
+        BookingManager bookingManager(BOOKINGS_FILE, &hotelManager);
+
+        userManager.loadUsers();
+        hotelManager.loadHotels();
+        bookingManager.loadBookings();
+
+        // Автозбереження лишається увімкненим: кожна зміна одразу йде в журнал
+        // бронювань, тож аварійна зупинка сервісу її не втрачає
+        BookingApi api(userManager, hotelManager, bookingManager);
+        HttpServer server(port, workerCount, [&api](const HttpRequest& request) {
+            return api.handle(request);
+        });
+
+        if (!server.start()) {
+            return 1;
+        }
+
+        std::signal(SIGINT, requestStop);
+        std::signal(SIGTERM, requestStop);
+        std::cout << "HTTP-сервіс слухає http://127.0.0.1:" << server.getPort()
+            << " (робочих потоків: " << workerCount << "). Ctrl+C - зупинка." << std::endl;
+
+        while (!stopRequested) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+
+        server.stop();
+        std::cout << "Оброблено запитів: " << server.getRequestsServed() << std::endl;
+        std::cout << "\nЗбереження даних..." << std::endl;
+        return api.saveAll() ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Критична помилка: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+// Функція генерації синтетичного набору даних у теку
+int runGenerator(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Вкажіть теку для набору даних." << std::endl;
+        return 1;
+    }
+
+    DatasetConfig config;
+    try {
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            long long value = std::stoll(argv[i + 1]);
+            if (value < 0) {
+                throw std::invalid_argument(option);
+            }
+
+            if (option == "--seed") config.seed = static_cast<std::uint64_t>(value);
+            else if (option == "--hotels") config.hotelCount = static_cast<int>(value);
+            else if (option == "--bookings") config.bookingCount = static_cast<size_t>(value);
+            else if (option == "--users") config.userCount = static_cast<int>(value);
+            else throw std::invalid_argument(option);
+        }
+        if (argc % 2 == 0) {
+            throw std::invalid_argument(argv[argc - 1]);
+        }
+    }
+    catch (const std::exception&) {
+        std::cerr << MSG_INVALID_INPUT << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DatasetGenerator generator(config);
+    if (!generator.writeAll(argv[2])) {
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Згенеровано готелів: " << generator.getConfig().hotelCount
+        << ", номерів: " << generator.getRooms().size()
+        << ", бронювань: " << generator.getConfig().bookingCount
+        << ", користувачів: " << generator.getConfig().userCount
+        << " (останній зайнятий день: " << DatasetGenerator::formatDate(generator.getLastBookedDay())
+        << ") за " << seconds << " с" << std::endl;
+    return 0;
+}
+
+// Функція експорту списку готелів або бронювань (без меню)
+int runReport(int argc, char* argv[]) {
+    std::string kind = argc > 2 ? argv[2] : "";
+    if (kind != "hotels" && kind != "bookings" && kind != "kpi") {
+        std::cerr << "Вкажіть звіт: hotels, bookings або kpi." << std::endl;
+        return 1;
+    }
+
+    ReportFormat format = ReportFormat::Table;
+    std::string outputPath;
+    size_t offset = 0;
+    size_t limit = 0;
+    KpiDimension dimension = KpiDimension::Total;
+    bool byMonth = true;
+    int fromMonth = 0;
+    int toMonth = 0;
+    try {
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            std::string value = argv[i + 1];
+
+            if (option == "--format") {
+                if (!ReportWriter::parseFormat(value, format)) {
+                    throw std::invalid_argument(value);
+                }
+            }
+            else if (option == "--out") outputPath = value;
+            else if (option == "--offset") offset = static_cast<size_t>(std::stoull(value));
+            else if (option == "--limit") limit = static_cast<size_t>(std::stoull(value));
+            else if (option == "--by") {
+                if (!BookingAnalytics::parseDimension(value, dimension)) {
+                    throw std::invalid_argument(value);
+                }
+            }
+            else if (option == "--period") {
+                if (value != "all" && value != "month") {
+                    throw std::invalid_argument(value);
+                }
+                byMonth = value == "month";
+            }
+            else if (option == "--from" || option == "--to") {
+                int month = std::stoi(value);
+                if (month % 100 < 1 || month % 100 > 12 || month < 100) {
+                    throw std::invalid_argument(value);
+                }
+                (option == "--from" ? fromMonth : toMonth) = month;
+            }
+            else throw std::invalid_argument(option);
+        }
+        if (argc % 2 == 0) {
+            throw std::invalid_argument(argv[argc - 1]);
+        }
+        if (fromMonth > 0 && toMonth > 0 && fromMonth > toMonth) {
+            throw std::invalid_argument("--from > --to");
+        }
+    }
+    catch (const std::exception&) {
+        std::cerr << MSG_INVALID_INPUT << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Не вдалося відкрити файл для запису: " << outputPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+
+    try {
+        HotelManager hotelManager;
+        BookingManager bookingManager(BOOKINGS_FILE, &hotelManager);
+        hotelManager.loadHotels();
+
+        bool success;
+        if (kind == "hotels") {
+            ReportWriter writer(out, format, HotelManager::reportColumns());
+            hotelManager.writeReport(writer, offset, limit);
+            success = writer.finish();
+        }
+        else if (kind == "kpi") {
+            bookingManager.loadBookings();
+            auto start = std::chrono::steady_clock::now();
+            BookingAnalytics analytics = bookingManager.analyze(fromMonth, toMonth);
+            std::vector<KpiRow> rows = analytics.rows(dimension, byMonth);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            ReportWriter writer(out, format, BookingAnalytics::reportColumns());
+            BookingAnalytics::writeReport(rows, writer);
+            success = writer.finish();
+            std::cerr << "Враховано бронювань: " << analytics.getCountedBookings()
+                << ", пропущено: " << analytics.getSkippedBookings() << " за " << seconds << " с" << std::endl;
+        }
+        else {
+            bookingManager.loadBookings();
+            ReportWriter writer(out, format, BookingManager::reportColumns());
+            bookingManager.writeReport(writer, offset, limit);
+            success = writer.finish();
+        }
+
+        if (!success) {
+            std::cerr << MSG_FILE_ERROR << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Критична помилка: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--generate") {
+        return runGenerator(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--report") {
+        return runReport(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        return runBatch(argc > 2 ? argv[2] : "-");
+    }
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        try {
+            int port = argc > 2 ? std::stoi(argv[2]) : HTTP_DEFAULT_PORT;
+            int workers = argc > 3 ? std::stoi(argv[3]) : HTTP_DEFAULT_WORKERS;
+            return runServer(port, workers);
+        }
+        catch (const std::exception&) {
+            std::cerr << MSG_INVALID_INPUT << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "╔════════════════════════════════════════╗" << std::endl;
     std::cout << "║   СИСТЕМА БРОНЮВАННЯ ГОТЕЛІВ          ║" << std::endl;
     std::cout << "║        Запуск програми...              ║" << std::endl;
@@ -501,7 +1017,9 @@ int main() {
             try {
                 switch (choice) {
                 case 1:
-                    hotelManager.displayAllHotels();
+                    browsePages(hotelManager.getHotelCount(), [&hotelManager](size_t offset, size_t limit) {
+                        hotelManager.displayAllHotels(offset, limit);
+                    });
                     waitForEnter();
                     break;
 
@@ -511,7 +1029,9 @@ int main() {
                     break;
 
                 case 3:
-                    bookingManager.displayAllBookings();
+                    browsePages(bookingManager.getBookingCount(), [&bookingManager](size_t offset, size_t limit) {
+                        bookingManager.displayAllBookings(offset, limit);
+                    });
                     waitForEnter();
                     break;
 
@@ -606,6 +1126,16 @@ int main() {
                     waitForEnter();
                     break;
 
+                case 13:
+                    if (isAdmin) {
+                        repriceRooms(hotelManager);
+                    }
+                    else {
+                        std::cout << MSG_ACCESS_DENIED << std::endl;
+                    }
+                    waitForEnter();
+                    break;
+
                 case 0:
                     std::cout << "\nЗбереження даних..." << std::endl;
                     hotelManager.saveHotels();
@@ -0,0 +1,351 @@
+﻿#include "DatasetGenerator.h"
+#include "Constants.hpp"
+#include "Booking.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    const char* const CITY_NAMES[] = {
+        "Kyiv", "Lviv", "Odesa", "Kharkiv", "Dnipro", "Zaporizhzhia", "Vinnytsia", "Poltava",
+        "Chernihiv", "Uzhhorod", "Ivano-Frankivsk", "Ternopil", "Lutsk", "Rivne", "Zhytomyr", "Sumy",
+        "Mykolaiv", "Kherson", "Cherkasy", "Chernivtsi", "Kropyvnytskyi", "Khmelnytskyi", "Bukovel", "Truskavets"
+    };
+    const size_t CITY_NAME_COUNT = sizeof(CITY_NAMES) / sizeof(CITY_NAMES[0]);
+
+    const char* const NAME_PREFIXES[] = {
+        "Grand", "Royal", "Park", "City", "Central", "Riverside", "Old Town", "Garden", "Premier", "Comfort"
+    };
+    const char* const NAME_SUFFIXES[] = { "Hotel", "Inn", "Residence", "Suites", "Lodge", "House" };
+
+    const char* const FIRST_NAMES[] = {
+        "Олександр", "Марія", "Андрій", "Олена", "Іван", "Наталія", "Дмитро", "Ірина",
+        "Сергій", "Тетяна", "Микола", "Юлія", "Василь", "Оксана", "Петро", "Анна"
+    };
+    const char* const LAST_NAMES[] = {
+        "Шевченко", "Коваленко", "Бондаренко", "Ткаченко", "Кравченко", "Олійник", "Мельник", "Бойко",
+        "Савченко", "Руденко", "Литвиненко", "Марченко", "Поліщук", "Гончаренко", "Лисенко", "Клименко"
+    };
+    const char* const PASSPORT_LETTERS[] = {
+        "А", "В", "Е", "К", "М", "Н", "О", "Р", "С", "Т", "Х", "І"
+    };
+    const size_t PASSPORT_LETTER_COUNT = sizeof(PASSPORT_LETTERS) / sizeof(PASSPORT_LETTERS[0]);
+
+    const int CALENDAR_START_YEAR = 2026;
+    const int ROOMS_PER_FLOOR = 10;
+
+    // Ціна в копійках за сумою в гривнях, округленою до 50 грн
+    Money roundedPrice(double hryvnias) {
+        std::int64_t rounded = static_cast<std::int64_t>(std::llround(hryvnias / 50.0)) * 50;
+        return Money(std::max<std::int64_t>(50, rounded) * 100);
+    }
+}
+
+// Конструктор з параметрами
+DatasetGenerator::DatasetGenerator(const DatasetConfig& config)
+    : config(config), random(config.seed), lastBookedDay(0) {
+    this->config.hotelCount = std::max(1, this->config.hotelCount);
+    this->config.cityCount = std::max(1, std::min(this->config.cityCount, this->config.hotelCount));
+    this->config.minRoomsPerHotel = std::max(1, this->config.minRoomsPerHotel);
+    this->config.maxRoomsPerHotel = std::max(this->config.minRoomsPerHotel, this->config.maxRoomsPerHotel);
+    this->config.maxStayNights = std::max(1, this->config.maxStayNights);
+    this->config.horizonDays = std::max(31, this->config.horizonDays);
+    if (this->config.clientCount <= 0) {
+        this->config.clientCount = static_cast<int>(std::max<size_t>(1, this->config.bookingCount / 3));
+    }
+
+    generateCatalog();
+}
+
+// Деструктор
+DatasetGenerator::~DatasetGenerator() {
+}
+
+// Getters
+const DatasetConfig& DatasetGenerator::getConfig() const {
+    return config;
+}
+
+const std::vector<std::string>& DatasetGenerator::getCities() const {
+    return cities;
+}
+
+const std::vector<DatasetGenerator::GeneratedRoom>& DatasetGenerator::getRooms() const {
+    return rooms;
+}
+
+int DatasetGenerator::getLastBookedDay() const {
+    return lastBookedDay;
+}
+
+// Власні методи
+
+std::uint64_t DatasetGenerator::nextBelow(std::uint64_t bound) {
+    // Відкидання хвоста усуває зсув остачі від ділення
+    std::uint64_t limit = UINT64_MAX - UINT64_MAX % bound;
+    std::uint64_t value;
+    do {
+        value = random();
+    } while (value >= limit);
+    return value % bound;
+}
+
+double DatasetGenerator::nextUnit() {
+    return static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+bool DatasetGenerator::chance(double probability) {
+    return nextUnit() < probability;
+}
+
+int DatasetGenerator::sampleCity() {
+    double point = nextUnit() * cityCumulative.back();
+    auto it = std::upper_bound(cityCumulative.begin(), cityCumulative.end(), point);
+    return static_cast<int>(std::min<size_t>(it - cityCumulative.begin(), cityCumulative.size() - 1));
+}
+
+int DatasetGenerator::sampleStayNights() {
+    // Геометричний розподіл: кожна наступна ніч з імовірністю 0.7
+    int nights = 1;
+    while (nights < config.maxStayNights && chance(0.7)) {
+        ++nights;
+    }
+    return nights;
+}
+
+void DatasetGenerator::generateCatalog() {
+    for (int i = 0; i < config.cityCount; ++i) {
+        if (static_cast<size_t>(i) < CITY_NAME_COUNT) {
+            cities.push_back(CITY_NAMES[i]);
+        }
+        else {
+            cities.push_back("City " + std::to_string(i + 1));
+        }
+    }
+
+    // Ранг міста збігається з його позицією: Kyiv найпопулярніший
+    double total = 0.0;
+    for (int rank = 1; rank <= config.cityCount; ++rank) {
+        total += 1.0 / std::pow(rank, config.cityZipfExponent);
+        cityCumulative.push_back(total);
+    }
+
+    roomsByCity.assign(cities.size(), std::vector<size_t>());
+    const AmenityMask premiumExtras[] = {
+        AmenityDictionary::bit(Amenity::Gym), AmenityDictionary::bit(Amenity::Bar),
+        AmenityDictionary::bit(Amenity::Transfer), AmenityDictionary::bit(Amenity::Conference),
+        AmenityDictionary::bit(Amenity::Laundry), AmenityDictionary::bit(Amenity::RoomService)
+    };
+
+    for (int id = 1; id <= config.hotelCount; ++id) {
+        GeneratedHotel hotel;
+        hotel.id = id;
+        // Кожне місто отримує хоча б один готель, решта розподіляється за популярністю
+        hotel.city = id <= config.cityCount ? id - 1 : sampleCity();
+        hotel.premium = chance(config.premiumShare);
+        hotel.stars = hotel.premium ? 4 + static_cast<int>(nextBelow(2)) : 1 + static_cast<int>(nextBelow(3));
+        hotel.name = std::string(NAME_PREFIXES[nextBelow(sizeof(NAME_PREFIXES) / sizeof(NAME_PREFIXES[0]))]) +
+            " " + NAME_SUFFIXES[nextBelow(sizeof(NAME_SUFFIXES) / sizeof(NAME_SUFFIXES[0]))] +
+            " " + cities[hotel.city];
+
+        if (hotel.premium) {
+            hotel.amenities = AmenityDictionary::bit(Amenity::WiFi) | AmenityDictionary::bit(Amenity::Spa) |
+                AmenityDictionary::bit(Amenity::Pool) | AmenityDictionary::bit(Amenity::Restaurant);
+            for (AmenityMask extra : premiumExtras) {
+                if (chance(0.5)) {
+                    hotel.amenities |= extra;
+                }
+            }
+        }
+        else {
+            hotel.amenities = AmenityDictionary::bit(Amenity::WiFi);
+            if (chance(0.6)) hotel.amenities |= AmenityDictionary::bit(Amenity::Parking);
+            if (chance(0.5)) hotel.amenities |= AmenityDictionary::bit(Amenity::Breakfast);
+            if (chance(0.1)) hotel.amenities |= AmenityDictionary::bit(Amenity::Laundry);
+        }
+
+        // Популярніші міста дорожчі: множник від 1.5 (перше місто) до 1.0
+        double cityFactor = 1.0 + 0.5 * (1.0 - static_cast<double>(hotel.city) / config.cityCount);
+        int roomCount = config.minRoomsPerHotel +
+            static_cast<int>(nextBelow(config.maxRoomsPerHotel - config.minRoomsPerHotel + 1));
+
+        for (int i = 0; i < roomCount; ++i) {
+            GeneratedRoom room;
+            room.hotelId = id;
+            room.roomNumber = (i / ROOMS_PER_FLOOR + 1) * 100 + i % ROOMS_PER_FLOOR + 1;
+            room.capacity = 1;
+
+            double basePrice;
+            if (hotel.premium && chance(0.3)) {
+                room.roomClass = ROOM_CLASS_LUXURY;
+                room.capacity = 2 + static_cast<int>(nextBelow(3));
+                basePrice = 3000.0 + nextUnit() * 5000.0;
+            }
+            else if (hotel.premium || chance(0.3)) {
+                room.roomClass = ROOM_CLASS_STANDARD;
+                room.capacity = 1 + static_cast<int>(nextBelow(3));
+                basePrice = 1200.0 + nextUnit() * 1800.0;
+            }
+            else {
+                room.roomClass = ROOM_CLASS_ECONOMY;
+                room.capacity = 1 + static_cast<int>(nextBelow(4));
+                basePrice = 400.0 + nextUnit() * 800.0;
+            }
+            room.price = roundedPrice(basePrice * cityFactor);
+            roomsByCity[hotel.city].push_back(rooms.size());
+            rooms.push_back(room);
+        }
+
+        hotels.push_back(hotel);
+    }
+}
+
+bool DatasetGenerator::writeHotels(const std::string& filename) {
+    try {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Помилка: не вдалося створити файл " << filename << std::endl;
+            return false;
+        }
+
+        file << CATALOG_SECTION_HOTELS << "\n" << "id,type,name,city,description,stars,amenities\n";
+        for (const GeneratedHotel& hotel : hotels) {
+            file << hotel.id << "," << (hotel.premium ? HOTEL_TYPE_PREMIUM : HOTEL_TYPE_BUDGET)
+                << "," << hotel.name << "," << cities[hotel.city] << ","
+                << (hotel.premium ? "Преміум-готель у місті " : "Бюджетний готель у місті ") << cities[hotel.city]
+                << "," << hotel.stars << "," << AmenityDictionary::toHex(hotel.amenities) << "\n";
+        }
+
+        file << CATALOG_SECTION_ROOMS << "\n" << "hotel_id,room_number,room_class,capacity,price\n";
+        for (const GeneratedRoom& room : rooms) {
+            file << room.hotelId << "," << room.roomNumber << "," << room.roomClass << ","
+                << room.capacity << "," << room.price << "\n";
+        }
+
+        return static_cast<bool>(file);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Помилка запису каталогу: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DatasetGenerator::writeBookings(const std::string& filename) {
+    try {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Помилка: не вдалося створити файл " << filename << std::endl;
+            return false;
+        }
+
+        // Перший прохід розподіляє бронювання по номерах (місто за Ципфом,
+        // номер рівномірно серед номерів міста), другий ділить горизонт кожного
+        // номера на рівні слоти за кількістю його бронювань
+        std::vector<std::uint32_t> assignedRoom(config.bookingCount);
+        std::vector<std::uint32_t> roomBookings(rooms.size(), 0);
+        for (size_t i = 0; i < config.bookingCount; ++i) {
+            const std::vector<size_t>& cityRooms = roomsByCity[sampleCity()];
+            assignedRoom[i] = static_cast<std::uint32_t>(cityRooms[nextBelow(cityRooms.size())]);
+            ++roomBookings[assignedRoom[i]];
+        }
+
+        int today = config.horizonDays / 2;
+        std::vector<std::uint32_t> roomSeen(rooms.size(), 0);
+        std::vector<int> nextFreeDay(rooms.size(), 0);
+        lastBookedDay = 0;
+
+        file << "id,hotel_id,room_number,client_name,passport,check_in,check_out,status,total_price\n";
+        for (size_t i = 0; i < config.bookingCount; ++i) {
+            size_t roomIndex = assignedRoom[i];
+            const GeneratedRoom& room = rooms[roomIndex];
+
+            // Заїзд випадковий у межах свого слоту, але не раніше виїзду попереднього
+            // гостя; при попиті понад місткість бронювання йдуть впритул за горизонт
+            std::int64_t slot = roomSeen[roomIndex]++;
+            int slotStart = static_cast<int>(config.horizonDays * slot / roomBookings[roomIndex]);
+            int slotEnd = static_cast<int>(config.horizonDays * (slot + 1) / roomBookings[roomIndex]);
+            int nights = sampleStayNights();
+            int checkIn = std::max(slotStart, nextFreeDay[roomIndex]);
+            if (slotEnd - checkIn > nights) {
+                checkIn += static_cast<int>(nextBelow(static_cast<std::uint64_t>(slotEnd - checkIn - nights + 1)));
+            }
+
+            int checkOut = checkIn + nights;
+            nextFreeDay[roomIndex] = checkOut;
+            lastBookedDay = std::max(lastBookedDay, checkOut);
+
+            const std::string* status = checkOut <= today ? &BOOKING_STATUS_COMPLETED : &BOOKING_STATUS_ACTIVE;
+            if (chance(config.cancellationRate)) {
+                status = &BOOKING_STATUS_CANCELLED;
+            }
+
+            int client = static_cast<int>(nextBelow(static_cast<std::uint64_t>(config.clientCount)));
+            file << i + 1 << "," << room.hotelId << "," << room.roomNumber << ","
+                << clientNameFor(client) << "," << passportFor(client) << ","
+                << formatDate(checkIn) << "," << formatDate(checkOut) << ","
+                << *status << "," << room.price * nights << "\n";
+        }
+
+        return static_cast<bool>(file);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Помилка запису бронювань: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DatasetGenerator::writeUsers(const std::string& filename) {
+    try {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Помилка: не вдалося створити файл " << filename << std::endl;
+            return false;
+        }
+
+        file << "admin:admin123:" << ACCESS_LEVEL_ADMIN << "\n";
+        for (int i = 1; i <= config.userCount; ++i) {
+            // Приблизно кожен сотий користувач - адміністратор
+            file << "user" << i << ":pass" << i << ":" << (chance(0.01) ? ACCESS_LEVEL_ADMIN : ACCESS_LEVEL_USER) << "\n";
+        }
+
+        return static_cast<bool>(file);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Помилка запису користувачів: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool DatasetGenerator::writeAll(const std::string& directory) {
+    std::string prefix = directory.empty() ? "" : directory + "/";
+    return writeHotels(prefix + HOTELS_FILE) && writeBookings(prefix + BOOKINGS_FILE) &&
+        writeUsers(prefix + USERS_FILE);
+}
+
+std::string DatasetGenerator::formatDate(int dayIndex) {
+    int year, month, day;
+    Booking::civilDate(Booking::dayNumber(CALENDAR_START_YEAR, 1, 1) + dayIndex, year, month, day);
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%02d.%02d.%04d", day, month, year);
+    return buffer;
+}
+
+std::string DatasetGenerator::clientNameFor(int client) {
+    const size_t firstCount = sizeof(FIRST_NAMES) / sizeof(FIRST_NAMES[0]);
+    const size_t lastCount = sizeof(LAST_NAMES) / sizeof(LAST_NAMES[0]);
+    size_t index = static_cast<size_t>(client);
+    return std::string(FIRST_NAMES[index % firstCount]) + " " + LAST_NAMES[index / firstCount % lastCount];
+}
+
+std::string DatasetGenerator::passportFor(int client) {
+    size_t index = static_cast<size_t>(client);
+    size_t series = index / 1000000;
+
+    char digits[16];
+    std::snprintf(digits, sizeof(digits), "%06u", static_cast<unsigned>(index % 1000000));
+    return std::string(PASSPORT_LETTERS[series / PASSPORT_LETTER_COUNT % PASSPORT_LETTER_COUNT]) +
+        PASSPORT_LETTERS[series % PASSPORT_LETTER_COUNT] + digits;
+}
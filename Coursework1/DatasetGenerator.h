@@ -0,0 +1,172 @@
+﻿#ifndef DATASETGENERATOR_H
+#define DATASETGENERATOR_H
+
+#include "Money.h"
+#include "Amenity.h"
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdint>
+
+/**
+ * @struct DatasetConfig
+ * @brief Параметри синтетичного набору даних
+ */
+struct DatasetConfig {
+    std::uint64_t seed = 42;
+    int hotelCount = 1000;
+    int cityCount = 40;
+    double cityZipfExponent = 1.1;      // популярність міста ~ 1 / ранг^s
+    double premiumShare = 0.3;          // частка Premium-готелів
+    int minRoomsPerHotel = 4;
+    int maxRoomsPerHotel = 40;
+    size_t bookingCount = 100000;
+    int maxStayNights = 14;
+    double cancellationRate = 0.12;     // частка скасованих бронювань
+    int userCount = 1000;
+    int clientCount = 0;                // різні клієнти у бронюваннях; 0 - третина бронювань
+    int horizonDays = 730;              // календар бронювань від 01.01.2026
+};
+
+/**
+ * @class DatasetGenerator
+ * @brief Детермінований генератор готелів, номерів, користувачів і бронювань
+ *
+ * Файли мають ті самі формати, що й робочі (hotels.csv з секціями
+ * [hotels]/[rooms], bookings.csv, users.txt), тому завантажуються
+ * звичайними менеджерами. Випадковість береться лише з mt19937_64,
+ * вихід якого визначений стандартом, без std::*_distribution - тож
+ * той самий seed дає ті самі файли на будь-якому компіляторі.
+ *
+ * Міста обираються за законом Ципфа, тривалість перебування спадає
+ * геометрично. Бронювання одного номера йдуть послідовно з проміжками
+ * і не перекриваються, а бронювання різних номерів перекриваються
+ * вільно - календар щільний, але коректний. Проміжки в кожному місті
+ * підбираються за його попитом на номер, тож календар заповнює
+ * horizonDays і виходить за нього лише при попиті понад місткість.
+ */
+class DatasetGenerator {
+public:
+    /**
+     * @struct GeneratedRoom
+     * @brief Номер, згенерований для каталогу
+     */
+    struct GeneratedRoom {
+        int hotelId;
+        int roomNumber;
+        std::string roomClass;
+        int capacity;
+        Money price;
+    };
+
+private:
+    /**
+     * @struct GeneratedHotel
+     * @brief Готель каталогу
+     */
+    struct GeneratedHotel {
+        int id;
+        bool premium;
+        int stars;
+        int city;
+        AmenityMask amenities;
+        std::string name;
+    };
+
+    DatasetConfig config;
+    std::mt19937_64 random;
+
+    std::vector<std::string> cities;
+    std::vector<double> cityCumulative;
+    std::vector<std::vector<size_t>> roomsByCity;
+    std::vector<GeneratedHotel> hotels;
+    std::vector<GeneratedRoom> rooms;
+    int lastBookedDay;
+
+    std::uint64_t nextBelow(std::uint64_t bound);
+    double nextUnit();
+    bool chance(double probability);
+    int sampleCity();
+    int sampleStayNights();
+
+    void generateCatalog();
+
+public:
+    // Конструктори
+    explicit DatasetGenerator(const DatasetConfig& config);
+    DatasetGenerator(const DatasetGenerator& other) = delete;
+    DatasetGenerator(DatasetGenerator&& other) = delete;
+
+    // Деструктор
+    ~DatasetGenerator();
+
+    // Оператори присвоєння
+    DatasetGenerator& operator=(const DatasetGenerator& other) = delete;
+    DatasetGenerator& operator=(DatasetGenerator&& other) = delete;
+
+    // Getters
+    const DatasetConfig& getConfig() const;
+    const std::vector<std::string>& getCities() const;
+    const std::vector<GeneratedRoom>& getRooms() const;
+
+    /**
+     * @brief Останній день (від 01.01.2026), зайнятий згенерованими бронюваннями
+     * @return Номер дня; після writeBookings
+     */
+    int getLastBookedDay() const;
+
+    /**
+     * @brief Записує каталог готелів і номерів
+     * @param filename Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool writeHotels(const std::string& filename);
+
+    /**
+     * @brief Записує бронювання
+     * @param filename Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool writeBookings(const std::string& filename);
+
+    /**
+     * @brief Записує користувачів (admin/admin123 та userN/passN)
+     *
+     * Паролі записуються у старому відкритому форматі: хешування PBKDF2
+     * мільйона записів тривало б години, а при першому вході пароль
+     * все одно перехешовується.
+     * @param filename Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool writeUsers(const std::string& filename);
+
+    /**
+     * @brief Записує hotels.csv, bookings.csv та users.txt у теку
+     * @param directory Тека (має існувати)
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool writeAll(const std::string& directory);
+
+    /**
+     * @brief Форматує дату DD.MM.YYYY за номером дня від 01.01.2026
+     * @param dayIndex Номер дня (0 - 01.01.2026)
+     * @return Дата у форматі застосунку
+     */
+    static std::string formatDate(int dayIndex);
+
+    /**
+     * @brief Ім'я клієнта з номером client (однакове для всіх його бронювань)
+     * @param client Номер клієнта від 0 до clientCount - 1
+     * @return Ім'я та прізвище
+     */
+    static std::string clientNameFor(int client);
+
+    /**
+     * @brief Паспорт клієнта з номером client (дві літери та шість цифр)
+     * @param client Номер клієнта від 0 до clientCount - 1
+     * @return Серія та номер паспорта
+     */
+    static std::string passportFor(int client);
+};
+
+#endif // DATASETGENERATOR_H
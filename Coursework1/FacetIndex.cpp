@@ -0,0 +1,288 @@
+﻿#include "FacetIndex.h"
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    // Межі цінових діапазонів у копійках
+    const std::int64_t PRICE_BUCKET_BOUNDS[FacetCounts::PRICE_BUCKET_COUNT - 1] = {
+        100000, 200000, 350000, 500000
+    };
+
+    int popcount64(std::uint64_t value) {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(value));
+#else
+        return __builtin_popcountll(value);
+#endif
+    }
+
+    int countTrailingZeros(std::uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(value);
+#endif
+    }
+
+    int classSlot(RoomClass roomClass) {
+        return static_cast<int>(roomClass);
+    }
+}
+
+// FacetCounts
+
+std::string FacetCounts::priceBucketLabel(int bucket) {
+    if (bucket <= 0) {
+        return "< " + std::to_string(PRICE_BUCKET_BOUNDS[0] / 100);
+    }
+    if (bucket >= PRICE_BUCKET_COUNT - 1) {
+        return ">= " + std::to_string(PRICE_BUCKET_BOUNDS[PRICE_BUCKET_COUNT - 2] / 100);
+    }
+    return std::to_string(PRICE_BUCKET_BOUNDS[bucket - 1] / 100) + "-" +
+        std::to_string(PRICE_BUCKET_BOUNDS[bucket] / 100);
+}
+
+int FacetCounts::priceBucketOf(std::int64_t priceKopecks) {
+    int bucket = 0;
+    while (bucket < PRICE_BUCKET_COUNT - 1 && priceKopecks >= PRICE_BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    return bucket;
+}
+
+// Конструктор за замовчуванням
+FacetIndex::FacetIndex() {
+}
+
+// Деструктор
+FacetIndex::~FacetIndex() {
+}
+
+// Допоміжні методи
+
+void FacetIndex::setBit(Bitset& bits, int position) {
+    size_t word = static_cast<size_t>(position) / 64;
+    if (bits.size() <= word) {
+        bits.resize(word + 1, 0);
+    }
+    bits[word] |= (std::uint64_t(1) << (position % 64));
+}
+
+void FacetIndex::clearBit(Bitset& bits, int position) {
+    size_t word = static_cast<size_t>(position) / 64;
+    if (word < bits.size()) {
+        bits[word] &= ~(std::uint64_t(1) << (position % 64));
+    }
+}
+
+void FacetIndex::unaccount(int position) {
+    HotelFacets& old = slots[position];
+    if (!old.present) {
+        return;
+    }
+
+    clearBit(allHotels, position);
+    clearBit(byCity[old.cityId], position);
+    clearBit(byStars[old.stars], position);
+    clearBit(byType[old.type], position);
+    for (auto& bits : byClass) {
+        clearBit(bits, position);
+    }
+    positions.erase(old.hotelId);
+    freePositions.push_back(position);
+    old = HotelFacets();
+}
+
+void FacetIndex::account(const HotelFacets& facets) {
+    int position = static_cast<int>(slots.size());
+    if (!freePositions.empty()) {
+        position = freePositions.back();
+        freePositions.pop_back();
+    }
+    else {
+        slots.emplace_back();
+    }
+    slots[position] = facets;
+    positions[facets.hotelId] = position;
+
+    setBit(allHotels, position);
+    setBit(byCity[facets.cityId], position);
+    setBit(byStars[facets.stars], position);
+    setBit(byType[facets.type], position);
+
+    for (int cls = 0; cls < 3; ++cls) {
+        for (int bucket = 0; bucket < FacetCounts::PRICE_BUCKET_COUNT; ++bucket) {
+            if (facets.rooms[cls][bucket] > 0) {
+                setBit(byClass[cls], position);
+                break;
+            }
+        }
+    }
+}
+
+// Власні методи
+
+void FacetIndex::clear() {
+    slots.clear();
+    positions.clear();
+    freePositions.clear();
+    cityIds.clear();
+    cityNames.clear();
+    allHotels.clear();
+    byCity.clear();
+    for (auto& bits : byStars) bits.clear();
+    for (auto& bits : byType) bits.clear();
+    for (auto& bits : byClass) bits.clear();
+}
+
+void FacetIndex::updateHotel(const HotelBase& hotel) {
+    auto position = positions.find(hotel.getHotelId());
+    if (position != positions.end()) {
+        unaccount(position->second);
+    }
+
+    HotelFacets facets;
+    facets.present = true;
+    facets.hotelId = hotel.getHotelId();
+    facets.revision = hotel.getRevision();
+    facets.stars = std::min(std::max(hotel.getStars(), 0), MAX_STARS);
+    facets.type = hotel.getTypeId() == HotelType::Premium ? 0 : 1;
+
+    auto city = cityIds.find(hotel.getCity());
+    if (city == cityIds.end()) {
+        city = cityIds.emplace(hotel.getCity(), static_cast<int>(cityNames.size())).first;
+        cityNames.push_back(hotel.getCity());
+        byCity.emplace_back();
+    }
+    facets.cityId = city->second;
+
+    for (const auto& room : hotel.getRooms()) {
+        if (room.getRoomClassId() == RoomClass::Unknown) continue;
+        facets.rooms[classSlot(room.getRoomClassId())][FacetCounts::priceBucketOf(room.getPriceKopecks())]++;
+    }
+
+    account(facets);
+}
+
+void FacetIndex::removeHotel(int hotelId) {
+    auto position = positions.find(hotelId);
+    if (position != positions.end()) {
+        unaccount(position->second);
+    }
+}
+
+void FacetIndex::sync(const std::vector<std::shared_ptr<HotelBase>>& hotels) {
+    ++syncCount;
+
+    // Перераховуємо лише готелі, ревізія яких змінилась
+    for (const auto& hotel : hotels) {
+        auto position = positions.find(hotel->getHotelId());
+        if (position == positions.end() || slots[position->second].revision != hotel->getRevision()) {
+            updateHotel(*hotel);
+            position = positions.find(hotel->getHotelId());
+        }
+        slots[position->second].seenSync = syncCount;
+    }
+
+    // Готелі, яких немає в каталозі, прибираємо з індексу
+    for (size_t position = 0; position < slots.size(); ++position) {
+        if (slots[position].present && slots[position].seenSync != syncCount) {
+            unaccount(static_cast<int>(position));
+        }
+    }
+}
+
+FacetCounts FacetIndex::query(const FacetFilter& filter) const {
+    FacetCounts counts;
+    Bitset selected = allHotels;
+
+    // Поєднуємо бітсети обраних значень фасетів
+    auto intersect = [&selected](const Bitset& bits) {
+        for (size_t i = 0; i < selected.size(); ++i) {
+            selected[i] &= (i < bits.size()) ? bits[i] : 0;
+        }
+    };
+
+    if (!filter.city.empty()) {
+        auto city = cityIds.find(filter.city);
+        if (city == cityIds.end()) {
+            return counts;
+        }
+        intersect(byCity[city->second]);
+    }
+
+    if (filter.stars > 0) {
+        if (filter.stars > MAX_STARS) {
+            return counts;
+        }
+        intersect(byStars[filter.stars]);
+    }
+
+    if (!filter.type.empty()) {
+        if (filter.type == HOTEL_TYPE_PREMIUM) intersect(byType[0]);
+        else if (filter.type == HOTEL_TYPE_BUDGET) intersect(byType[1]);
+        else return counts;
+    }
+
+    int onlyClass = -1;
+    if (!filter.roomClass.empty()) {
+        RoomClass roomClass = Room::parseRoomClass(filter.roomClass);
+        if (roomClass == RoomClass::Unknown) {
+            return counts;
+        }
+        onlyClass = classSlot(roomClass);
+        intersect(byClass[onlyClass]);
+    }
+
+    // Лічильники готелів - popcount перетину з кожним бітсетом фасету
+    auto countWith = [&selected](const Bitset& bits) {
+        int total = 0;
+        size_t words = std::min(selected.size(), bits.size());
+        for (size_t i = 0; i < words; ++i) {
+            total += popcount64(selected[i] & bits[i]);
+        }
+        return total;
+    };
+
+    for (const auto& word : selected) {
+        counts.hotelCount += popcount64(word);
+    }
+
+    for (size_t cityId = 0; cityId < cityNames.size(); ++cityId) {
+        int count = countWith(byCity[cityId]);
+        if (count > 0) {
+            counts.hotelsByCity.emplace_back(cityNames[cityId], count);
+        }
+    }
+
+    for (int stars = 1; stars <= MAX_STARS; ++stars) {
+        counts.hotelsByStars[stars] = countWith(byStars[stars]);
+    }
+
+    counts.hotelsByType[0] = countWith(byType[0]);
+    counts.hotelsByType[1] = countWith(byType[1]);
+
+    // Кількості номерів підсумовуємо лише по вибраних готелях
+    for (size_t word = 0; word < selected.size(); ++word) {
+        std::uint64_t bits = selected[word];
+        while (bits) {
+            size_t position = word * 64 + countTrailingZeros(bits);
+            bits &= bits - 1;
+
+            const HotelFacets& facets = slots[position];
+            for (int cls = 0; cls < 3; ++cls) {
+                if (onlyClass >= 0 && cls != onlyClass) continue;
+                for (int bucket = 0; bucket < FacetCounts::PRICE_BUCKET_COUNT; ++bucket) {
+                    counts.roomsByClass[cls] += facets.rooms[cls][bucket];
+                    counts.roomsByPriceBucket[bucket] += facets.rooms[cls][bucket];
+                }
+            }
+        }
+    }
+
+    return counts;
+}
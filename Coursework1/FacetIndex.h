@@ -0,0 +1,141 @@
+﻿#ifndef FACETINDEX_H
+#define FACETINDEX_H
+
+#include "HotelBase.h"
+#include "Constants.hpp"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @struct FacetFilter
+ * @brief Фільтр фасетного запиту (порожнє поле / 0 - без обмеження)
+ */
+struct FacetFilter {
+    std::string city;
+    std::string type;
+    std::string roomClass;
+    int stars = 0;
+};
+
+/**
+ * @struct FacetCounts
+ * @brief Результат фасетного запиту
+ */
+struct FacetCounts {
+    static const int PRICE_BUCKET_COUNT = 5;
+
+    int hotelCount = 0;
+    std::vector<std::pair<std::string, int>> hotelsByCity;
+    int hotelsByStars[MAX_STARS + 1] = {};
+    int hotelsByType[2] = {};
+    int roomsByClass[3] = {};
+    int roomsByPriceBucket[PRICE_BUCKET_COUNT] = {};
+
+    /**
+     * @brief Отримує підпис цінового діапазону
+     * @param bucket Номер діапазону
+     * @return Рядок на кшталт "1000-2000"
+     */
+    static std::string priceBucketLabel(int bucket);
+
+    /**
+     * @brief Визначає ціновий діапазон для ціни
+     * @param priceKopecks Ціна в копійках
+     * @return Номер діапазону
+     */
+    static int priceBucketOf(std::int64_t priceKopecks);
+};
+
+/**
+ * @class FacetIndex
+ * @brief Інкрементальний індекс фасетів каталогу готелів
+ *
+ * Кожен готель отримує щільну позицію (звільнені позиції використовуються
+ * повторно), тож розмір бітсетів залежить від кількості готелів, а не від
+ * величини їхніх ID. Для кожного значення фасету (місто, зірки, тип,
+ * наявність класу номера) зберігається бітсет над позиціями готелів.
+ * Фільтрований запит - це AND
+ * відповідних бітсетів, а лічильники - popcount перетину. Кількості номерів
+ * за класом і ціновим діапазоном зберігаються для кожного готелю окремо.
+ */
+class FacetIndex {
+private:
+    typedef std::vector<std::uint64_t> Bitset;
+
+    /**
+     * @struct HotelFacets
+     * @brief Знімок внеску одного готелю в індекс
+     */
+    struct HotelFacets {
+        bool present = false;
+        int hotelId = 0;
+        std::uint64_t revision = 0;
+        std::uint64_t seenSync = 0;     // номер останньої синхронізації, що бачила готель
+        int cityId = -1;
+        int stars = 0;
+        int type = 0;
+        int rooms[3][FacetCounts::PRICE_BUCKET_COUNT] = {};
+    };
+
+    std::vector<HotelFacets> slots;                 // за позицією готелю
+    std::unordered_map<int, int> positions;         // ID готелю -> позиція
+    std::vector<int> freePositions;
+    std::uint64_t syncCount = 0;
+    std::unordered_map<std::string, int> cityIds;
+    std::vector<std::string> cityNames;
+
+    Bitset allHotels;
+    std::vector<Bitset> byCity;
+    Bitset byStars[MAX_STARS + 1];
+    Bitset byType[2];
+    Bitset byClass[3];
+
+    void setBit(Bitset& bits, int position);
+    void clearBit(Bitset& bits, int position);
+    void unaccount(int position);
+    void account(const HotelFacets& facets);
+
+public:
+    // Конструктори
+    FacetIndex();
+
+    // Деструктор
+    ~FacetIndex();
+
+    /**
+     * @brief Очищає індекс
+     */
+    void clear();
+
+    /**
+     * @brief Додає або оновлює внесок готелю
+     * @param hotel Готель
+     */
+    void updateHotel(const HotelBase& hotel);
+
+    /**
+     * @brief Видаляє внесок готелю
+     * @param hotelId ID готелю
+     */
+    void removeHotel(int hotelId);
+
+    /**
+     * @brief Синхронізує індекс з каталогом
+     *
+     * Перераховує лише змінені готелі та прибирає ті, яких у каталозі вже немає.
+     * @param hotels Готелі каталогу
+     */
+    void sync(const std::vector<std::shared_ptr<HotelBase>>& hotels);
+
+    /**
+     * @brief Виконує фасетний запит
+     * @param filter Фільтр
+     * @return Лічильники фасетів для готелів, що проходять фільтр
+     */
+    FacetCounts query(const FacetFilter& filter) const;
+};
+
+#endif // FACETINDEX_H
@@ -1,43 +1,72 @@
 ﻿#include "HotelBase.h"
+#include "Constants.hpp"
+#include "Logger.h"
 #include <iostream>
 #include <algorithm>
 
+int PriceStats::countOf(RoomClass roomClass) const {
+    if (roomClass == RoomClass::Unknown) {
+        return 0;
+    }
+    return classCounts[static_cast<int>(roomClass)];
+}
+
+double PriceStats::averagePrice() const {
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(sumKopecks) / count / 100.0;
+}
+
+std::atomic<std::uint64_t> HotelBase::modificationCounter(0);
+
 // Конструктор за замовчуванням
-HotelBase::HotelBase()
-    : hotelId(0), name(""), city(""), description("") {
+HotelBase::HotelBase(HotelType type, int stars)
+    : hotelId(0), type(type), stars(stars), amenities(0), name(""), city(""), description(""),
+    dirty(true), revision(++modificationCounter) {
 }
 
 // Конструктор з параметрами
-HotelBase::HotelBase(int id, const std::string& name, const std::string& city, const std::string& description)
-    : hotelId(id), name(name), city(city), description(description) {
+HotelBase::HotelBase(HotelType type, int id, const std::string& name, const std::string& city,
+    const std::string& description, int stars)
+    : hotelId(id), type(type), stars(stars), amenities(0), name(name), city(city), description(description),
+    dirty(true), revision(++modificationCounter) {
 }
 
 // Копіювальний конструктор
 HotelBase::HotelBase(const HotelBase& other)
-    : hotelId(other.hotelId), name(other.name), city(other.city),
-    description(other.description), rooms(other.rooms) {
+    : hotelId(other.hotelId), type(other.type), stars(other.stars), amenities(other.amenities),
+    name(other.name), city(other.city), description(other.description), rooms(other.rooms), priceStats(other.priceStats),
+    dirty(true), revision(++modificationCounter) {
 }
 
 // Переміщувальний конструктор
 HotelBase::HotelBase(HotelBase&& other) noexcept
-    : hotelId(other.hotelId), name(std::move(other.name)),
-    city(std::move(other.city)), description(std::move(other.description)),
-    rooms(std::move(other.rooms)) {
+    : hotelId(other.hotelId), type(other.type), stars(other.stars), amenities(other.amenities),
+    name(std::move(other.name)), city(std::move(other.city)), description(std::move(other.description)),
+    rooms(std::move(other.rooms)), priceStats(other.priceStats), dirty(other.dirty),
+    revision(other.revision) {
+    other.priceStats = PriceStats();
 }
 
 // Деструктор
 HotelBase::~HotelBase() {
-    std::cout << "Об'єкт HotelBase '" << name << "' знищено." << std::endl;
+    LOG_DEBUG("Об'єкт HotelBase '" << name << "' знищено.");
 }
 
 // Оператор копіювального присвоєння
 HotelBase& HotelBase::operator=(const HotelBase& other) {
     if (this != &other) {
         hotelId = other.hotelId;
+        type = other.type;
+        stars = other.stars;
+        amenities = other.amenities;
         name = other.name;
         city = other.city;
         description = other.description;
         rooms = other.rooms;
+        priceStats = other.priceStats;
+        markDirty();
     }
     return *this;
 }
@@ -46,10 +75,16 @@ HotelBase& HotelBase::operator=(const HotelBase& other) {
 HotelBase& HotelBase::operator=(HotelBase&& other) noexcept {
     if (this != &other) {
         hotelId = other.hotelId;
+        type = other.type;
+        stars = other.stars;
+        amenities = other.amenities;
         name = std::move(other.name);
         city = std::move(other.city);
         description = std::move(other.description);
         rooms = std::move(other.rooms);
+        priceStats = other.priceStats;
+        other.priceStats = PriceStats();
+        markDirty();
     }
     return *this;
 }
@@ -59,6 +94,26 @@ int HotelBase::getHotelId() const {
     return hotelId;
 }
 
+HotelType HotelBase::getTypeId() const {
+    return type;
+}
+
+int HotelBase::getStars() const {
+    return stars;
+}
+
+AmenityMask HotelBase::getAmenities() const {
+    return amenities;
+}
+
+bool HotelBase::hasAmenities(AmenityMask required) const {
+    return (amenities & required) == required;
+}
+
+const std::string& HotelBase::getType() const {
+    return type == HotelType::Premium ? HOTEL_TYPE_PREMIUM : HOTEL_TYPE_BUDGET;
+}
+
 std::string HotelBase::getName() const {
     return name;
 }
@@ -71,60 +126,160 @@ std::string HotelBase::getDescription() const {
     return description;
 }
 
-std::vector<Room> HotelBase::getRooms() const {
+const std::vector<Room>& HotelBase::getRooms() const {
     return rooms;
 }
 
+const PriceStats& HotelBase::getPriceStats() const {
+    return priceStats;
+}
+
+bool HotelBase::isDirty() const {
+    return dirty;
+}
+
+void HotelBase::markDirty() {
+    dirty = true;
+    revision = ++modificationCounter;
+}
+
+void HotelBase::clearDirty() {
+    dirty = false;
+}
+
+std::uint64_t HotelBase::getModificationCounter() {
+    return modificationCounter;
+}
+
+std::uint64_t HotelBase::getRevision() const {
+    return revision;
+}
+
 // Setters
 void HotelBase::setHotelId(int id) {
     this->hotelId = id;
+    markDirty();
+}
+
+void HotelBase::setStars(int stars) {
+    this->stars = stars;
+    markDirty();
+}
+
+void HotelBase::setAmenities(AmenityMask amenities) {
+    this->amenities = amenities;
+    markDirty();
+}
+
+void HotelBase::setAmenity(Amenity amenity, bool enabled) {
+    if (enabled) {
+        amenities |= AmenityDictionary::bit(amenity);
+    }
+    else {
+        amenities &= ~AmenityDictionary::bit(amenity);
+    }
+    markDirty();
 }
 
 void HotelBase::setName(const std::string& name) {
     this->name = name;
+    markDirty();
 }
 
 void HotelBase::setCity(const std::string& city) {
     this->city = city;
+    markDirty();
 }
 
 void HotelBase::setDescription(const std::string& description) {
     this->description = description;
+    markDirty();
 }
 
 void HotelBase::setRooms(const std::vector<Room>& rooms) {
     this->rooms = rooms;
+    markDirty();
+    recalculatePriceStats();
+}
+
+// Агрегати цін
+
+void HotelBase::accountRoom(const Room& room) {
+    std::int64_t price = room.getPriceKopecks();
+
+    if (priceStats.count == 0) {
+        priceStats.minKopecks = price;
+        priceStats.maxKopecks = price;
+    }
+    else {
+        priceStats.minKopecks = std::min(priceStats.minKopecks, price);
+        priceStats.maxKopecks = std::max(priceStats.maxKopecks, price);
+    }
+
+    priceStats.sumKopecks += price;
+    priceStats.count++;
+    priceStats.maxCapacity = std::max(priceStats.maxCapacity, room.getCapacity());
+
+    if (room.getRoomClassId() != RoomClass::Unknown) {
+        priceStats.classCounts[static_cast<int>(room.getRoomClassId())]++;
+    }
+}
+
+void HotelBase::recalculatePriceStats() {
+    priceStats = PriceStats();
+    for (const auto& room : rooms) {
+        accountRoom(room);
+    }
 }
 
 // Власні методи
 
 void HotelBase::addRoom(const Room& room) {
     if (!room.validate()) {
-        std::cerr << "Некоректні дані номера!" << std::endl;
+        LOG_WARNING("Некоректні дані номера!");
         return;
     }
 
     if (findRoom(room.getRoomNumber()) != nullptr) {
-        std::cerr << "Номер з таким номером вже існує!" << std::endl;
+        LOG_WARNING("Номер з таким номером вже існує!");
         return;
     }
 
     rooms.push_back(room);
+    accountRoom(room);
+    markDirty();
 }
 
 bool HotelBase::removeRoom(int roomNumber) {
-    auto it = std::remove_if(rooms.begin(), rooms.end(),
+    auto it = std::find_if(rooms.begin(), rooms.end(),
         [roomNumber](const Room& room) { return room.getRoomNumber() == roomNumber; });
 
-    if (it != rooms.end()) {
-        rooms.erase(it, rooms.end());
-        return true;
+    if (it == rooms.end()) {
+        return false;
+    }
+
+    Room removed = *it;
+    rooms.erase(it);
+    markDirty();
+
+    // Межі (мін/макс) можна відновити лише повним проходом
+    if (removed.getPriceKopecks() == priceStats.minKopecks ||
+        removed.getPriceKopecks() == priceStats.maxKopecks ||
+        removed.getCapacity() == priceStats.maxCapacity) {
+        recalculatePriceStats();
+    }
+    else {
+        priceStats.sumKopecks -= removed.getPriceKopecks();
+        priceStats.count--;
+        if (removed.getRoomClassId() != RoomClass::Unknown) {
+            priceStats.classCounts[static_cast<int>(removed.getRoomClassId())]--;
+        }
     }
 
-    return false;
+    return true;
 }
 
-Room* HotelBase::findRoom(int roomNumber) {
+Room* HotelBase::locateRoom(int roomNumber) {
     for (auto& room : rooms) {
         if (room.getRoomNumber() == roomNumber) {
             return &room;
@@ -133,6 +288,89 @@ Room* HotelBase::findRoom(int roomNumber) {
     return nullptr;
 }
 
+const Room* HotelBase::findRoom(int roomNumber) const {
+    for (const auto& room : rooms) {
+        if (room.getRoomNumber() == roomNumber) {
+            return &room;
+        }
+    }
+    return nullptr;
+}
+
+bool HotelBase::updateRoom(const Room& room) {
+    if (!room.validate()) {
+        LOG_WARNING("Некоректні дані номера!");
+        return false;
+    }
+
+    Room* existing = locateRoom(room.getRoomNumber());
+    if (!existing) {
+        return false;
+    }
+
+    // Ціна, клас і місткість можуть змінитися разом, тож агрегати перераховуємо повністю
+    *existing = room;
+    recalculatePriceStats();
+    markDirty();
+    return true;
+}
+
+bool HotelBase::setRoomAvailability(int roomNumber, bool available) {
+    Room* room = locateRoom(roomNumber);
+    if (!room) {
+        return false;
+    }
+
+    // Доступність не входить в агрегати цін, але змінює ревізію для індексу номерів
+    room->setIsAvailable(available);
+    markDirty();
+    return true;
+}
+
+bool HotelBase::applyRoomDiscount(int roomNumber, double discountPercent) {
+    Room* room = locateRoom(roomNumber);
+    if (!room) {
+        return false;
+    }
+
+    std::int64_t oldPrice = room->getPriceKopecks();
+    room->applyDiscount(discountPercent);
+    std::int64_t newPrice = room->getPriceKopecks();
+    markDirty();
+
+    if (oldPrice == priceStats.maxKopecks) {
+        recalculatePriceStats();
+    }
+    else {
+        priceStats.sumKopecks += newPrice - oldPrice;
+        priceStats.minKopecks = std::min(priceStats.minKopecks, newPrice);
+    }
+
+    return true;
+}
+
+int HotelBase::repriceRooms(RoomClass roomClass, const PriceAdjustment& adjustment) {
+    int changed = 0;
+
+    // Агрегати перебудовуємо в тому ж проході, що й ціни
+    priceStats = PriceStats();
+    for (auto& room : rooms) {
+        if (roomClass == RoomClass::Unknown || room.getRoomClassId() == roomClass) {
+            Money price = adjustment.apply(room.getPrice());
+            if (price != room.getPrice()) {
+                room.setPrice(price);
+                changed++;
+            }
+        }
+        accountRoom(room);
+    }
+
+    if (changed > 0) {
+        markDirty();
+    }
+    return changed;
+}
+
 int HotelBase::getRoomCount() const {
     return rooms.size();
 }
@@ -144,9 +382,30 @@ void HotelBase::displayRooms() const {
     }
 
     std::cout << "\n=== Номери готелю '" << name << "' ===" << std::endl;
+    ReportWriter writer(std::cout, ReportFormat::Table, roomReportColumns());
+    writeRoomsReport(writer);
+}
+
+size_t HotelBase::writeRoomsReport(ReportWriter& writer) const {
     for (const auto& room : rooms) {
-        room.displayInfo();
+        writer.field(static_cast<std::int64_t>(room.getRoomNumber()));
+        writer.field(room.getRoomClass());
+        writer.field(static_cast<std::int64_t>(room.getCapacity()));
+        writer.field(room.getPrice());
+        writer.field(std::string(room.getIsAvailable() ? "Вільний" : "Зайнятий"));
+        writer.endRow();
     }
+    return rooms.size();
+}
+
+std::vector<ReportColumn> HotelBase::roomReportColumns() {
+    return {
+        { "room", "Номер", 6 },
+        { "class", "Клас", 8 },
+        { "capacity", "Місць", 5 },
+        { "price", "Ціна/ніч", 10 },
+        { "status", "Статус", 8 }
+    };
 }
 
 bool HotelBase::hasAvailableRooms() const {
@@ -156,9 +415,10 @@ bool HotelBase::hasAvailableRooms() const {
 
 std::vector<Room> HotelBase::getRoomsByClass(const std::string& roomClass) const {
     std::vector<Room> result;
+    RoomClass classId = Room::parseRoomClass(roomClass);
 
     std::copy_if(rooms.begin(), rooms.end(), std::back_inserter(result),
-        [&roomClass](const Room& room) { return room.getRoomClass() == roomClass; });
+        [classId](const Room& room) { return room.getRoomClassId() == classId; });
 
     return result;
 }
\ No newline at end of file
@@ -2,28 +2,98 @@
 #define HOTELBASE_H
 
 #include "Room.h"
+#include "Amenity.h"
+#include "Repricing.h"
+#include "ReportWriter.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @enum HotelType
+ * @brief Тег типу готелю, що зберігається безпосередньо в базовому записі
+ */
+enum class HotelType : std::uint8_t {
+    Premium,
+    Budget
+};
+
+/**
+ * @struct PriceStats
+ * @brief Агреговані ціни номерів готелю (кешуються та оновлюються інкрементально)
+ */
+struct PriceStats {
+    std::int64_t sumKopecks = 0;
+    int count = 0;
+    std::int64_t minKopecks = 0;
+    std::int64_t maxKopecks = 0;
+    int maxCapacity = 0;
+    int classCounts[3] = { 0, 0, 0 };
+
+    /**
+     * @brief Отримує кількість номерів певного класу
+     * @param roomClass Клас номера
+     * @return Кількість номерів
+     */
+    int countOf(RoomClass roomClass) const;
+
+    /**
+     * @brief Розраховує середню ціну за ніч
+     * @return Середня ціна в гривнях або 0, якщо номерів немає
+     */
+    double averagePrice() const;
+};
 
 /**
  * @class HotelBase
  * @brief Абстрактний базовий клас для готелю
  *
- * Містить базові поля та методи для всіх типів готелів
+ * Містить базові поля та методи для всіх типів готелів.
+ * Тип і кількість зірок зберігаються в базі, тому фільтри каталогу
+ * не потребують віртуальних викликів чи dynamic_pointer_cast.
  */
 class HotelBase {
 protected:
     int hotelId;
+    HotelType type;
+    int stars;
+    AmenityMask amenities;
     std::string name;
     std::string city;
     std::string description;
     std::vector<Room> rooms;
+    PriceStats priceStats;
+    bool dirty;
+    std::uint64_t revision;
+
+    // Атомарний, бо масова зміна цін позначає готелі з кількох потоків
+    static std::atomic<std::uint64_t> modificationCounter;
+
+    /**
+     * @brief Враховує номер у кешованих агрегатах
+     * @param room Номер
+     */
+    void accountRoom(const Room& room);
+
+    /**
+     * @brief Повністю перераховує кешовані агрегати за списком номерів
+     */
+    void recalculatePriceStats();
+
+    /**
+     * @brief Знаходить номер для зміни всередині HotelBase
+     * @param roomNumber Номер кімнати
+     * @return Вказівник на номер або nullptr
+     */
+    Room* locateRoom(int roomNumber);
 
 public:
     // Конструктори
-    HotelBase();
-    HotelBase(int id, const std::string& name, const std::string& city, const std::string& description);
+    explicit HotelBase(HotelType type, int stars = 0);
+    HotelBase(HotelType type, int id, const std::string& name, const std::string& city,
+        const std::string& description, int stars);
     HotelBase(const HotelBase& other);
     HotelBase(HotelBase&& other) noexcept;
 
@@ -36,25 +106,73 @@ public:
 
     // Getters
     int getHotelId() const;
+    HotelType getTypeId() const;
+    int getStars() const;
+    AmenityMask getAmenities() const;
     std::string getName() const;
     std::string getCity() const;
     std::string getDescription() const;
-    std::vector<Room> getRooms() const;
+    const std::vector<Room>& getRooms() const;
+    const PriceStats& getPriceStats() const;
+
+    /**
+     * @brief Перевіряє чи змінювався готель після останнього збереження
+     * @return true якщо є незбережені зміни
+     */
+    bool isDirty() const;
+
+    /**
+     * @brief Позначає готель як змінений (викликається мутаторами номерів)
+     */
+    void markDirty();
+
+    /**
+     * @brief Знімає позначку змін після збереження
+     */
+    void clearDirty();
+
+    /**
+     * @brief Отримує лічильник змін усіх готелів (зростає при кожному markDirty)
+     * @return Значення лічильника
+     */
+    static std::uint64_t getModificationCounter();
+
+    /**
+     * @brief Отримує ревізію готелю (змінюється при кожному markDirty)
+     * @return Ревізія
+     */
+    std::uint64_t getRevision() const;
 
     // Setters
     void setHotelId(int id);
+    void setStars(int stars);
+    void setAmenities(AmenityMask amenities);
     void setName(const std::string& name);
     void setCity(const std::string& city);
     void setDescription(const std::string& description);
     void setRooms(const std::vector<Room>& rooms);
 
-    // Чисті віртуальні методи (для абстрактності)
+    /**
+     * @brief Перевіряє наявність усіх зручностей з маски
+     * @param required Маска потрібних зручностей
+     * @return true якщо всі зручності є
+     */
+    bool hasAmenities(AmenityMask required) const;
+
+    /**
+     * @brief Встановлює або знімає одну зручність
+     * @param amenity Зручність
+     * @param enabled true - додати, false - прибрати
+     */
+    void setAmenity(Amenity amenity, bool enabled);
 
     /**
      * @brief Отримує тип готелю
      * @return Тип готелю (Premium, Budget)
      */
-    virtual std::string getType() const = 0;
+    const std::string& getType() const;
+
+    // Чисті віртуальні методи (для абстрактності)
 
     /**
      * @brief Виводить детальну інформацію про готель
@@ -84,10 +202,47 @@ public:
 
     /**
      * @brief Знаходить номер за номером кімнати
+     *
+     * Номер лише для читання: зміни проходять через updateRoom,
+     * setRoomAvailability та інші мутатори, що оновлюють агрегати цін,
+     * позначку змін і ревізію для індексів.
      * @param roomNumber Номер кімнати
      * @return Вказівник на номер або nullptr
      */
-    Room* findRoom(int roomNumber);
+    const Room* findRoom(int roomNumber) const;
+
+    /**
+     * @brief Замінює дані номера з тим самим номером кімнати
+     * @param room Нові дані номера
+     * @return true якщо номер знайдено і дані коректні, false в іншому випадку
+     */
+    bool updateRoom(const Room& room);
+
+    /**
+     * @brief Змінює доступність номера
+     * @param roomNumber Номер кімнати
+     * @param available Чи доступний номер
+     * @return true якщо номер знайдено, false в іншому випадку
+     */
+    bool setRoomAvailability(int roomNumber, bool available);
+
+    /**
+     * @brief Застосовує знижку до одного номера та оновлює агрегати цін
+     * @param roomNumber Номер кімнати
+     * @param discountPercent Відсоток знижки (0-100)
+     * @return true якщо номер знайдено, false в іншому випадку
+     */
+    bool applyRoomDiscount(int roomNumber, double discountPercent);
+
+    /**
+     * @brief Змінює ціни номерів одним проходом, перераховуючи агрегати цін
+     *
+     * Потокобезпечний щодо інших готелів: змінює лише стан цього готелю.
+     * @param roomClass Клас номерів (RoomClass::Unknown - усі номери)
+     * @param adjustment Зміна ціни
+     * @return Кількість номерів, ціна яких змінилась
+     */
+    int repriceRooms(RoomClass roomClass, const PriceAdjustment& adjustment);
 
     /**
      * @brief Отримує кількість номерів у готелі
@@ -96,10 +251,22 @@ public:
     int getRoomCount() const;
 
     /**
-     * @brief Виводить список всіх номерів
+     * @brief Виводить список всіх номерів таблицею
      */
     void displayRooms() const;
 
+    /**
+     * @brief Записує номери готелю у звіт
+     * @param writer Звіт, створений з колонками roomReportColumns()
+     * @return Кількість записаних рядків
+     */
+    size_t writeRoomsReport(ReportWriter& writer) const;
+
+    /**
+     * @brief Колонки звіту номерів
+     */
+    static std::vector<ReportColumn> roomReportColumns();
+
     /**
      * @brief Перевіряє чи є вільні номери
      * @return true якщо є вільні, false в іншому випадку
@@ -1,34 +1,47 @@
 ﻿#include "HotelManager.h"
 #include "Constants.hpp"
+#include "OperationMetrics.h"
+#include "Tracing.h"
+#include "Logger.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <unordered_map>
+#include <stdexcept>
+#include <thread>
+#include <system_error>
 
 // Конструктор за замовчуванням
 HotelManager::HotelManager()
-    : filename(HOTELS_FILE), nextHotelId(1) {
+    : filename(HOTELS_FILE), nextHotelId(1), journal(HOTELS_FILE + CATALOG_JOURNAL_SUFFIX),
+    roomIndexStamp(0), facetStamp(0), prefixStamp(0) {
 }
 
 // Конструктор з параметром
 HotelManager::HotelManager(const std::string& filename)
-    : filename(filename), nextHotelId(1) {
+    : filename(filename), nextHotelId(1), journal(filename + CATALOG_JOURNAL_SUFFIX),
+    roomIndexStamp(0), facetStamp(0), prefixStamp(0) {
 }
 
 // Копіювальний конструктор
 HotelManager::HotelManager(const HotelManager& other)
-    : hotels(other.hotels), filename(other.filename), nextHotelId(other.nextHotelId) {
+    : hotels(other.hotels), filename(other.filename), nextHotelId(other.nextHotelId),
+    pendingRemovals(other.pendingRemovals), journal(other.journal),
+    roomIndexStamp(0), facetStamp(0), prefixStamp(0) {
 }
 
 // Переміщувальний конструктор
 HotelManager::HotelManager(HotelManager&& other) noexcept
     : hotels(std::move(other.hotels)), filename(std::move(other.filename)),
-    nextHotelId(other.nextHotelId) {
+    nextHotelId(other.nextHotelId), pendingRemovals(std::move(other.pendingRemovals)),
+    journal(std::move(other.journal)), roomIndexStamp(0),
+    facetStamp(0), prefixStamp(0) {
 }
 
 // Деструктор
 HotelManager::~HotelManager() {
-    std::cout << "Об'єкт HotelManager знищено." << std::endl;
+    LOG_DEBUG("Об'єкт HotelManager знищено.");
 }
 
 // Оператор копіювального присвоєння
@@ -37,6 +50,14 @@ HotelManager& HotelManager::operator=(const HotelManager& other) {
         hotels = other.hotels;
         filename = other.filename;
         nextHotelId = other.nextHotelId;
+        pendingRemovals = other.pendingRemovals;
+        journal = other.journal;
+        roomIndex.clear();
+        roomIndexStamp = 0;
+        facetIndex.clear();
+        facetStamp = 0;
+        prefixIndex.clear();
+        prefixStamp = 0;
     }
     return *this;
 }
@@ -47,6 +68,14 @@ HotelManager& HotelManager::operator=(HotelManager&& other) noexcept {
         hotels = std::move(other.hotels);
         filename = std::move(other.filename);
         nextHotelId = other.nextHotelId;
+        pendingRemovals = std::move(other.pendingRemovals);
+        journal = std::move(other.journal);
+        roomIndex.clear();
+        roomIndexStamp = 0;
+        facetIndex.clear();
+        facetStamp = 0;
+        prefixIndex.clear();
+        prefixStamp = 0;
     }
     return *this;
 }
@@ -63,184 +92,436 @@ int HotelManager::getNextHotelId() const {
 // Setters
 void HotelManager::setFilename(const std::string& filename) {
     this->filename = filename;
+    journal.setPath(filename + CATALOG_JOURNAL_SUFFIX);
 }
 
 // Власні методи
 
+namespace {
+    // Розбиває CSV рядок на поля, повторно використовуючи буфер tokens
+    void splitLine(const std::string& line, char delimiter, std::vector<std::string>& tokens) {
+        tokens.clear();
+        size_t start = 0;
+        while (true) {
+            size_t end = line.find(delimiter, start);
+            if (end == std::string::npos) {
+                tokens.emplace_back(line, start);
+                break;
+            }
+            tokens.emplace_back(line, start, end - start);
+            start = end + 1;
+        }
+    }
+
+    // Прибирає UTF-8 BOM та символ '\r' з рядка
+    void trimLine(std::string& line) {
+        if (line.size() >= 3 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            line.erase(0, 3);
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+    }
+
+    // Розбирає ціну номера; некоректне значення обробляється як помилка файлу
+    Money parsePrice(const std::string& text) {
+        Money price;
+        if (!Money::parse(text, price)) {
+            throw std::invalid_argument("некоректна ціна: " + text);
+        }
+        return price;
+    }
+}
+
+std::shared_ptr<HotelBase> HotelManager::createHotel(int id, const std::string& type,
+    const std::string& name, const std::string& city, const std::string& description,
+    int stars, const std::string& amenities) const {
+    std::shared_ptr<HotelBase> hotel;
+    if (type == HOTEL_TYPE_PREMIUM) {
+        hotel = std::make_shared<PremiumHotel>(id, name, city, description, stars);
+    }
+    else {
+        hotel = std::make_shared<BudgetHotel>(id, name, city, description, stars);
+    }
+
+    // Нові файли містять маску (0x...), старі - перелік назв через ';'
+    AmenityMask mask = 0;
+    if (!AmenityDictionary::fromHex(amenities, mask)) {
+        mask = AmenityDictionary::parseList(amenities, ';');
+    }
+    hotel->setAmenities(mask);
+
+    return hotel;
+}
+
 bool HotelManager::loadHotels() {
+    OperationTimer timer(MetricOperation::LoadHotels);
+    TraceSpan span("loadHotels", "load");
     try {
         std::ifstream file(filename);
 
+        hotels.clear();
+        roomIndex.clear();
+        roomIndexStamp = 0;
+        facetIndex.clear();
+        facetStamp = 0;
+        prefixIndex.clear();
+        prefixStamp = 0;
+
         if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл: " << filename << std::endl;
-            return false;
+            LOG_ERROR("Не вдалося відкрити файл: " << filename);
+            // Готелі, додані до першого повного збереження, є лише в журналі
+            replayJournal();
+            clearAllDirty();
+            return timer.result(false);
         }
 
-        hotels.clear();
         std::string line;
 
-        // Пропускаємо заголовок
+        // За першим рядком визначаємо формат файлу
         std::getline(file, line);
+        trimLine(line);
+
+        bool result = (line == CATALOG_SECTION_HOTELS) ? loadCatalog(file) : loadLegacyHotels(file);
 
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
+        file.close();
 
-            std::stringstream ss(line);
-            std::string token;
-            std::vector<std::string> tokens;
+        result = replayJournal() && result;
+        clearAllDirty();
+        pendingRemovals.clear();
+        return timer.result(result);
 
-            // Парсимо CSV рядок
-            while (std::getline(ss, token, ',')) {
-                tokens.push_back(token);
-            }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка завантаження готелів: " << e.what());
+        return timer.result(false);
+    }
+}
+
+bool HotelManager::loadCatalog(std::istream& in) {
+    std::string line;
+    std::vector<std::string> tokens;
+    std::unordered_map<int, HotelBase*> byId;
+    bool inRooms = false;
+    bool headerPending = true;
+
+    // Номери записані групами за готелем, тому зазвичай достатньо курсора
+    HotelBase* current = nullptr;
+    TraceSpan span("loadCatalog", "load");
+    std::int64_t rows = 0;
+
+    while (std::getline(in, line)) {
+        trimLine(line);
+        span.lap("read");
+        if (line.empty()) continue;
+
+        if (line == CATALOG_SECTION_ROOMS) {
+            inRooms = true;
+            headerPending = true;
+            continue;
+        }
+
+        // Кожна секція починається з рядка заголовка
+        if (headerPending) {
+            headerPending = false;
+            continue;
+        }
 
-            if (tokens.size() < 10) continue;
+        splitLine(line, ',', tokens);
+        span.lap("tokenize");
+        ++rows;
+
+        if (!inRooms) {
+            if (tokens.size() < 7) continue;
 
             int id = std::stoi(tokens[0]);
-            std::string type = tokens[1];
-            std::string name = tokens[2];
-            std::string city = tokens[3];
-            std::string description = tokens[4];
-            int stars = std::stoi(tokens[5]);
-            int roomNumber = std::stoi(tokens[7]);
-            std::string roomClass = tokens[8];
-            int capacity = std::stoi(tokens[9]);
-            double price = std::stod(tokens[10]);
-
-            // Шукаємо чи готель вже існує
+            auto hotel = createHotel(id, tokens[1], tokens[2], tokens[3], tokens[4],
+                std::stoi(tokens[5]), tokens[6]);
+            span.lap("parse");
+
+            byId[id] = hotel.get();
+            hotels.push_back(hotel);
+
+            if (id >= nextHotelId) {
+                nextHotelId = id + 1;
+            }
+            span.lap("addHotel");
+        }
+        else {
+            if (tokens.size() < 5) continue;
+
+            int hotelId = std::stoi(tokens[0]);
+            if (!current || current->getHotelId() != hotelId) {
+                auto it = byId.find(hotelId);
+                current = (it != byId.end()) ? it->second : nullptr;
+            }
+            span.lap("findHotel");
+
+            if (!current) continue;
+
+            Room room(std::stoi(tokens[1]), tokens[2], std::stoi(tokens[3]), parsePrice(tokens[4]));
+            span.lap("parse");
+            current->addRoom(room);
+            span.lap("addRoom");
+        }
+    }
+
+    span.addArg("rows", rows);
+    return true;
+}
+
+bool HotelManager::loadLegacyHotels(std::istream& in) {
+    // Старий формат: один рядок на номер з повторенням полів готелю
+    std::string line;
+    std::vector<std::string> tokens;
+    HotelBase* current = nullptr;
+    TraceSpan span("loadLegacyHotels", "load");
+
+    while (std::getline(in, line)) {
+        trimLine(line);
+        span.lap("read");
+        if (line.empty()) continue;
+
+        splitLine(line, ',', tokens);
+        span.lap("tokenize");
+
+        if (tokens.size() < 11) continue;
+
+        int id = std::stoi(tokens[0]);
+
+        if (!current || current->getHotelId() != id) {
             auto existingHotel = findHotel(id);
+            span.lap("findHotel");
 
             if (existingHotel) {
-                // Додаємо номер до існуючого готелю
-                Room room(roomNumber, roomClass, capacity, price);
-                existingHotel->addRoom(room);
+                current = existingHotel.get();
             }
             else {
-                // Створюємо новий готель
-                std::shared_ptr<HotelBase> hotel;
-
-                if (type == HOTEL_TYPE_PREMIUM) {
-                    auto premiumHotel = std::make_shared<PremiumHotel>(id, name, city, description, stars);
-
-                    // Додаткові поля для Premium
-                    if (tokens.size() > 6 && !tokens[6].empty()) {
-                        std::stringstream servicesStream(tokens[6]);
-                        std::string service;
-                        while (std::getline(servicesStream, service, ';')) {
-                            premiumHotel->addService(service);
-                        }
-                    }
-
-                    hotel = premiumHotel;
+                auto hotel = createHotel(id, tokens[1], tokens[2], tokens[3], tokens[4],
+                    std::stoi(tokens[5]), tokens[6]);
+                current = hotel.get();
+                hotels.push_back(hotel);
+
+                if (id >= nextHotelId) {
+                    nextHotelId = id + 1;
                 }
-                else {
-                    auto budgetHotel = std::make_shared<BudgetHotel>(id, name, city, description, stars);
+            }
+        }
 
-                    // Додаткові поля для Budget
-                    if (tokens.size() > 6 && !tokens[6].empty()) {
-                        if (tokens[6].find("WiFi") != std::string::npos) budgetHotel->setHasFreeWifi(true);
-                        if (tokens[6].find("Parking") != std::string::npos) budgetHotel->setHasFreeParking(true);
-                        if (tokens[6].find("Breakfast") != std::string::npos) budgetHotel->setHasBreakfast(true);
-                    }
+        Room room(std::stoi(tokens[7]), tokens[8], std::stoi(tokens[9]), parsePrice(tokens[10]));
+        span.lap("parse");
+        current->addRoom(room);
+        span.lap("addRoom");
+    }
 
-                    hotel = budgetHotel;
-                }
+    return true;
+}
 
-                // Додаємо перший номер
-                Room room(roomNumber, roomClass, capacity, price);
-                hotel->addRoom(room);
-                hotels.push_back(hotel);
+void HotelManager::writeHotelRow(std::ostream& out, const HotelBase& hotel) const {
+    out << hotel.getHotelId() << ","
+        << hotel.getType() << ","
+        << hotel.getName() << ","
+        << hotel.getCity() << ","
+        << hotel.getDescription() << ","
+        << hotel.getStars() << ","
+        << AmenityDictionary::toHex(hotel.getAmenities()) << '\n';
+}
+
+void HotelManager::writeRoomRow(std::ostream& out, int hotelId, const Room& room) const {
+    out << hotelId << ","
+        << room.getRoomNumber() << ","
+        << room.getRoomClass() << ","
+        << room.getCapacity() << ","
+        << room.getPrice() << '\n';
+}
+
+void HotelManager::clearAllDirty() {
+    for (auto& hotel : hotels) {
+        hotel->clearDirty();
+    }
+}
+
+bool HotelManager::replayJournal() {
+    TraceSpan span("replayJournal", "load");
+
+    // Індекс ID -> позиція будуємо один раз на весь журнал
+    std::unordered_map<int, size_t> indexById;
+    for (size_t i = 0; i < hotels.size(); ++i) {
+        indexById[hotels[i]->getHotelId()] = i;
+    }
+
+    std::vector<std::string> tokens;
+    HotelBase* current = nullptr;
+    bool removedAny = false;
+
+    bool replayed = journal.replay([&](const std::string& record) {
+        std::string line = record;
+        trimLine(line);
+        if (line.size() < 2 || line[1] != ',') return;
+
+        char kind = line[0];
+        splitLine(line.substr(2), ',', tokens);
+
+        try {
+            if (kind == 'H' && tokens.size() >= 7) {
+                int id = std::stoi(tokens[0]);
+                auto hotel = createHotel(id, tokens[1], tokens[2], tokens[3], tokens[4],
+                    std::stoi(tokens[5]), tokens[6]);
 
+                // Нова версія готелю повністю замінює попередню разом з номерами
+                auto it = indexById.find(id);
+                if (it != indexById.end() && hotels[it->second]) {
+                    hotels[it->second] = hotel;
+                }
+                else {
+                    indexById[id] = hotels.size();
+                    hotels.push_back(hotel);
+                }
+
+                current = hotel.get();
                 if (id >= nextHotelId) {
                     nextHotelId = id + 1;
                 }
             }
+            else if (kind == 'R' && tokens.size() >= 5) {
+                if (current && current->getHotelId() == std::stoi(tokens[0])) {
+                    current->addRoom(Room(std::stoi(tokens[1]), tokens[2],
+                        std::stoi(tokens[3]), parsePrice(tokens[4])));
+                }
+            }
+            else if (kind == 'D' && !tokens.empty()) {
+                auto it = indexById.find(std::stoi(tokens[0]));
+                if (it != indexById.end() && hotels[it->second]) {
+                    hotels[it->second] = nullptr;
+                    removedAny = true;
+                }
+                current = nullptr;
+            }
+        }
+        catch (const std::exception& e) {
+            // Недописані транзакції відкидає журнал, тут лише записи з некоректними полями
+            LOG_ERROR("Пошкоджений запис журналу каталогу: " << e.what());
         }
+    });
 
-        file.close();
+    if (removedAny) {
+        hotels.erase(std::remove(hotels.begin(), hotels.end(), nullptr), hotels.end());
+    }
+
+    return replayed;
+}
+
+bool HotelManager::saveHotels() {
+    OperationTimer timer(MetricOperation::SaveHotels);
+    TraceSpan span("saveHotels", "save");
+    try {
+        // Знімок пишеться у тимчасовий файл, тож збій не зіпсує попередній
+        bool written = Journal::writeAtomically(filename, [&](std::ostream& file) {
+            // Секція готелів: один рядок на готель
+            file << CATALOG_SECTION_HOTELS << '\n';
+            file << "id,type,name,city,description,stars,amenities\n";
+
+            for (const auto& hotel : hotels) {
+                writeHotelRow(file, *hotel);
+            }
+            span.lap("writeHotels");
+
+            // Секція номерів: згруповано за готелем, ключ - ID готелю
+            file << CATALOG_SECTION_ROOMS << '\n';
+            file << "hotel_id,room_number,room_class,capacity,price\n";
+
+            for (const auto& hotel : hotels) {
+                for (const auto& room : hotel->getRooms()) {
+                    writeRoomRow(file, hotel->getHotelId(), room);
+                }
+            }
+            span.lap("writeRooms");
+            return true;
+        });
+        span.lap("commit");
+
+        if (!written) {
+            LOG_ERROR("Не вдалося записати файл: " << filename);
+            return timer.result(false);
+        }
+
+        // Повний знімок містить усі зміни, тож журнал більше не потрібен.
+        // Збій до очищення лише повторно застосує ті самі версії готелів
+        if (!journal.reset()) {
+            LOG_WARNING("Не вдалося очистити журнал: " << journal.getPath());
+        }
+        pendingRemovals.clear();
+        clearAllDirty();
         return true;
 
     }
     catch (const std::exception& e) {
-        std::cerr << "Помилка завантаження готелів: " << e.what() << std::endl;
-        return false;
+        LOG_ERROR("Помилка збереження готелів: " << e.what());
+        return timer.result(false);
     }
 }
 
-bool HotelManager::saveHotels() {
+bool HotelManager::flushChanges() {
     try {
-        std::ofstream file(filename);
-
-        if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл для запису: " << filename << std::endl;
-            return false;
+        // Усі зміни скидаються однією транзакцією: готель з номерами не
+        // відновиться наполовину
+        std::vector<std::string> lines;
+        std::ostringstream row;
+        auto takeLine = [&lines, &row]() {
+            std::string line = row.str();
+            line.pop_back();
+            lines.push_back(line);
+            row.str("");
+        };
+
+        for (int hotelId : pendingRemovals) {
+            lines.push_back("D," + std::to_string(hotelId));
         }
 
-        // Записуємо заголовок
-        file << "id,type,name,city,description,stars,services,room_number,room_class,capacity,price" << std::endl;
-
-        // Записуємо дані
         for (const auto& hotel : hotels) {
-            std::string type = hotel->getType();
-            std::string services = "";
-            int stars = 0;
-
-            if (type == HOTEL_TYPE_PREMIUM) {
-                auto premiumHotel = std::dynamic_pointer_cast<PremiumHotel>(hotel);
-                if (premiumHotel) {
-                    stars = premiumHotel->getStars();
-                    auto servicesList = premiumHotel->getServices();
-                    for (size_t i = 0; i < servicesList.size(); ++i) {
-                        services += servicesList[i];
-                        if (i < servicesList.size() - 1) services += ";";
-                    }
-                }
-            }
-            else {
-                auto budgetHotel = std::dynamic_pointer_cast<BudgetHotel>(hotel);
-                if (budgetHotel) {
-                    stars = budgetHotel->getStars();
-                    if (budgetHotel->getHasFreeWifi()) services += "WiFi;";
-                    if (budgetHotel->getHasFreeParking()) services += "Parking;";
-                    if (budgetHotel->getHasBreakfast()) services += "Breakfast;";
-                }
-            }
+            if (!hotel->isDirty()) continue;
 
-            // Записуємо кожен номер готелю
+            row << "H,";
+            writeHotelRow(row, *hotel);
+            takeLine();
             for (const auto& room : hotel->getRooms()) {
-                file << hotel->getHotelId() << ","
-                    << type << ","
-                    << hotel->getName() << ","
-                    << hotel->getCity() << ","
-                    << hotel->getDescription() << ","
-                    << stars << ","
-                    << services << ","
-                    << room.getRoomNumber() << ","
-                    << room.getRoomClass() << ","
-                    << room.getCapacity() << ","
-                    << room.getPricePerNight() << std::endl;
+                row << "R,";
+                writeRoomRow(row, hotel->getHotelId(), room);
+                takeLine();
             }
         }
 
-        file.close();
+        if (!journal.append(lines)) {
+            LOG_ERROR("Не вдалося дописати журнал: " << journal.getPath());
+            return false;
+        }
+
+        pendingRemovals.clear();
+        clearAllDirty();
+
+        // Межа на довжину журналу обмежує час відтворення при запуску
+        if (journal.getRecordCount() > static_cast<size_t>(CATALOG_JOURNAL_COMPACT_THRESHOLD)) {
+            return saveHotels();
+        }
+
         return true;
 
     }
     catch (const std::exception& e) {
-        std::cerr << "Помилка збереження готелів: " << e.what() << std::endl;
+        LOG_ERROR("Помилка збереження змін каталогу: " << e.what());
         return false;
     }
 }
 
 bool HotelManager::addHotel(std::shared_ptr<HotelBase> hotel) {
     if (!hotel) {
-        std::cerr << "Некоректний вказівник на готель!" << std::endl;
+        LOG_WARNING("Некоректний вказівник на готель!");
         return false;
     }
 
     hotel->setHotelId(nextHotelId++);
     hotels.push_back(hotel);
-    return saveHotels();
+    return flushChanges();
 }
 
 bool HotelManager::removeHotel(int hotelId) {
@@ -251,12 +532,90 @@ bool HotelManager::removeHotel(int hotelId) {
 
     if (it != hotels.end()) {
         hotels.erase(it, hotels.end());
-        return saveHotels();
+        pendingRemovals.push_back(hotelId);
+        roomIndex.removeHotel(hotelId);
+        facetIndex.removeHotel(hotelId);
+        prefixIndex.removeHotel(hotelId);
+        return flushChanges();
     }
 
     return false;
 }
 
+bool HotelManager::repriceRooms(const RepriceRule& rule, int& repricedRooms) {
+    repricedRooms = 0;
+
+    RoomClass classId = Room::parseRoomClass(rule.roomClass);
+    if (!rule.roomClass.empty() && classId == RoomClass::Unknown) {
+        LOG_WARNING("Невідомий клас номера: " << rule.roomClass);
+        return false;
+    }
+
+    if (!rule.type.empty() && rule.type != HOTEL_TYPE_PREMIUM && rule.type != HOTEL_TYPE_BUDGET) {
+        LOG_WARNING("Невідомий тип готелю: " << rule.type);
+        return false;
+    }
+
+    std::vector<HotelBase*> targets;
+    for (const auto& hotel : hotels) {
+        if ((rule.city.empty() || hotel->getCity() == rule.city) &&
+            (rule.type.empty() || hotel->getType() == rule.type)) {
+            targets.push_back(hotel.get());
+        }
+    }
+
+    // Кожен потік змінює лише свої готелі, тому синхронізація не потрібна
+    auto repriceRange = [&targets, classId, &rule](size_t first, size_t last) {
+        int changed = 0;
+        for (size_t i = first; i < last; ++i) {
+            changed += targets[i]->repriceRooms(classId, rule.adjustment);
+        }
+        return changed;
+    };
+
+    size_t workerCount = std::max(1u, std::thread::hardware_concurrency());
+    if (targets.size() < static_cast<size_t>(REPRICE_PARALLEL_MIN_HOTELS) || workerCount == 1) {
+        repricedRooms = repriceRange(0, targets.size());
+    }
+    else {
+        size_t chunk = (targets.size() + workerCount - 1) / workerCount;
+        std::vector<int> changed(workerCount, 0);
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        size_t assigned = 0;
+
+        for (size_t w = 0; w < workerCount; ++w) {
+            size_t first = w * chunk;
+            size_t last = std::min(first + chunk, targets.size());
+            if (first >= last) break;
+            try {
+                workers.emplace_back([&changed, &repriceRange, w, first, last]() {
+                    changed[w] = repriceRange(first, last);
+                });
+            }
+            catch (const std::system_error& e) {
+                LOG_WARNING("Не вдалося запустити потік переоцінки: " << e.what());
+                break;
+            }
+            assigned = last;
+        }
+
+        // Готелі без потоку переоцінює поточний потік, запущені потоки чекаємо завжди
+        repricedRooms += repriceRange(assigned, targets.size());
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (int count : changed) {
+            repricedRooms += count;
+        }
+    }
+
+    if (repricedRooms == 0) {
+        return true;
+    }
+    return flushChanges();
+}
+
 std::shared_ptr<HotelBase> HotelManager::findHotel(int hotelId) {
     for (auto& hotel : hotels) {
         if (hotel->getHotelId() == hotelId) {
@@ -266,20 +625,76 @@ std::shared_ptr<HotelBase> HotelManager::findHotel(int hotelId) {
     return nullptr;
 }
 
-void HotelManager::displayAllHotels() const {
+void HotelManager::displayAllHotels(size_t offset, size_t limit) const {
     if (hotels.empty()) {
         std::cout << "\nНемає готелів у базі даних." << std::endl;
         return;
     }
 
     std::cout << "\n========== СПИСОК ГОТЕЛІВ ==========" << std::endl;
-    for (const auto& hotel : hotels) {
-        hotel->displayInfo();
+    size_t written = 0;
+    {
+        ReportWriter writer(std::cout, ReportFormat::Table, reportColumns());
+        written = writeReport(writer, offset, limit);
+    }
+    if (written > 0) {
+        std::cout << "\nПоказано " << offset + 1 << "-" << offset + written
+            << " з " << hotels.size() << std::endl;
+    }
+    else {
+        std::cout << "\nВсього готелів: " << hotels.size() << std::endl;
+    }
+}
+
+size_t HotelManager::writeReport(ReportWriter& writer, size_t offset, size_t limit) const {
+    size_t end = hotels.size();
+    if (offset >= end) {
+        return 0;
+    }
+    if (limit > 0 && limit < end - offset) {
+        end = offset + limit;
+    }
+
+    std::string amenities;
+    for (size_t i = offset; i < end; ++i) {
+        const HotelBase& hotel = *hotels[i];
+        amenities.clear();
+        for (const std::string& name : AmenityDictionary::names(hotel.getAmenities())) {
+            if (!amenities.empty()) {
+                amenities += ';';
+            }
+            amenities += name;
+        }
+
+        writer.field(static_cast<std::int64_t>(hotel.getHotelId()));
+        writer.field(hotel.getType());
+        writer.field(hotel.getName());
+        writer.field(hotel.getCity());
+        writer.field(static_cast<std::int64_t>(hotel.getStars()));
+        writer.field(static_cast<std::int64_t>(hotel.getRoomCount()));
+        writer.field(Money::fromHryvnias(hotel.calculateAveragePrice()));
+        writer.field(amenities);
+        writer.endRow();
     }
-    std::cout << "\nВсього готелів: " << hotels.size() << std::endl;
+    return end - offset;
+}
+
+std::vector<ReportColumn> HotelManager::reportColumns() {
+    return {
+        { "id", "ID", 6 },
+        { "type", "Тип", 7 },
+        { "name", "Назва", 24 },
+        { "city", "Місто", 14 },
+        { "stars", "Зірок", 5 },
+        { "rooms", "Номерів", 7 },
+        { "avg_price", "Сер. ціна", 10 },
+        { "amenities", "Зручності", 30 }
+    };
 }
 
 std::vector<std::shared_ptr<HotelBase>> HotelManager::findHotelsByCity(const std::string& city) const {
+    OperationTimer timer(MetricOperation::FindHotelsByCity);
+    TraceSpan span("findHotelsByCity", "search");
     std::vector<std::shared_ptr<HotelBase>> result;
 
     std::copy_if(hotels.begin(), hotels.end(), std::back_inserter(result),
@@ -291,84 +706,162 @@ std::vector<std::shared_ptr<HotelBase>> HotelManager::findHotelsByCity(const std
 }
 
 std::vector<std::shared_ptr<HotelBase>> HotelManager::findHotelsByType(const std::string& type) const {
+    OperationTimer timer(MetricOperation::FindHotelsByType);
+    TraceSpan span("findHotelsByType", "search");
     std::vector<std::shared_ptr<HotelBase>> result;
 
+    HotelType typeId;
+    if (type == HOTEL_TYPE_PREMIUM) {
+        typeId = HotelType::Premium;
+    }
+    else if (type == HOTEL_TYPE_BUDGET) {
+        typeId = HotelType::Budget;
+    }
+    else {
+        timer.result(false);
+        return result;
+    }
+
     std::copy_if(hotels.begin(), hotels.end(), std::back_inserter(result),
-        [&type](const std::shared_ptr<HotelBase>& hotel) {
-            return hotel->getType() == type;
+        [typeId](const std::shared_ptr<HotelBase>& hotel) {
+            return hotel->getTypeId() == typeId;
         });
 
     return result;
 }
 
 std::vector<std::shared_ptr<HotelBase>> HotelManager::findHotelsByStars(int stars) const {
+    OperationTimer timer(MetricOperation::FindHotelsByStars);
+    TraceSpan span("findHotelsByStars", "search");
     std::vector<std::shared_ptr<HotelBase>> result;
 
-    for (const auto& hotel : hotels) {
-        if (hotel->getType() == HOTEL_TYPE_PREMIUM) {
-            auto premiumHotel = std::dynamic_pointer_cast<PremiumHotel>(hotel);
-            if (premiumHotel && premiumHotel->getStars() == stars) {
-                result.push_back(hotel);
-            }
-        }
-        else {
-            auto budgetHotel = std::dynamic_pointer_cast<BudgetHotel>(hotel);
-            if (budgetHotel && budgetHotel->getStars() == stars) {
-                result.push_back(hotel);
-            }
-        }
-    }
+    std::copy_if(hotels.begin(), hotels.end(), std::back_inserter(result),
+        [stars](const std::shared_ptr<HotelBase>& hotel) {
+            return hotel->getStars() == stars;
+        });
 
     return result;
 }
 
+void HotelManager::ensureRoomIndex() const {
+    std::uint64_t stamp = HotelBase::getModificationCounter();
+
+    // Перераховуються лише готелі, ревізія яких змінилась
+    if (roomIndexStamp != stamp) {
+        roomIndex.sync(hotels);
+        roomIndexStamp = stamp;
+    }
+}
+
+void HotelManager::invalidateRoomIndex(int hotelId) {
+    roomIndex.refreshHotel(hotelId);
+}
+
 std::vector<std::shared_ptr<HotelBase>> HotelManager::findAvailableRooms(
     const std::string& city,
     const std::string& roomClass,
     int minCapacity,
     double maxPrice) const {
 
+    OperationTimer timer(MetricOperation::FindAvailableRooms);
+    TraceSpan span("findAvailableRooms", "search");
     std::vector<std::shared_ptr<HotelBase>> result;
 
-    for (const auto& hotel : hotels) {
+    // Клас номера перетворюємо один раз, щоб порівнювати байти, а не рядки
+    RoomClass classId = Room::parseRoomClass(roomClass);
+    if (!roomClass.empty() && classId == RoomClass::Unknown) {
+        timer.result(false);
+        return result;
+    }
+
+    std::int64_t maxPriceKopecks = Money::fromHryvnias(maxPrice).getKopecks();
+
+    // Індекс повертає лише готелі з номерами, що проходять усі три фільтри
+    ensureRoomIndex();
+    auto candidates = roomIndex.findHotels(classId, minCapacity, maxPriceKopecks);
+
+    for (auto& hotel : candidates) {
         // Фільтр по місту
         if (!city.empty() && hotel->getCity() != city) {
             continue;
         }
 
-        // Перевіряємо номери
-        bool hasMatchingRoom = false;
-        for (const auto& room : hotel->getRooms()) {
-            if (!room.getIsAvailable()) continue;
+        result.push_back(hotel);
+    }
 
-            if (!roomClass.empty() && room.getRoomClass() != roomClass) continue;
-            if (room.getCapacity() < minCapacity) continue;
-            if (room.getPricePerNight() > maxPrice) continue;
+    return result;
+}
 
-            hasMatchingRoom = true;
-            break;
-        }
+FacetCounts HotelManager::getFacetCounts(const FacetFilter& filter) const {
+    OperationTimer timer(MetricOperation::GetFacetCounts);
+    TraceSpan span("getFacetCounts", "search");
+    std::uint64_t stamp = HotelBase::getModificationCounter();
 
-        if (hasMatchingRoom) {
-            result.push_back(hotel);
-        }
+    // Без змін у каталозі повторна синхронізація не потрібна
+    if (facetStamp != stamp) {
+        facetIndex.sync(hotels);
+        facetStamp = stamp;
     }
 
+    return facetIndex.query(filter);
+}
+
+std::vector<std::shared_ptr<HotelBase>> HotelManager::findHotelsWithAmenities(
+    AmenityMask required) const {
+    OperationTimer timer(MetricOperation::FindHotelsWithAmenities);
+    TraceSpan span("findHotelsWithAmenities", "search");
+    std::vector<std::shared_ptr<HotelBase>> result;
+
+    std::copy_if(hotels.begin(), hotels.end(), std::back_inserter(result),
+        [required](const std::shared_ptr<HotelBase>& hotel) {
+            return hotel->hasAmenities(required);
+        });
+
     return result;
 }
 
+std::vector<std::shared_ptr<HotelBase>> HotelManager::suggestHotels(const std::string& prefix,
+    size_t limit) const {
+    OperationTimer timer(MetricOperation::SuggestHotels);
+    TraceSpan span("suggestHotels", "search");
+    std::uint64_t stamp = HotelBase::getModificationCounter();
+
+    if (prefixStamp != stamp) {
+        prefixIndex.sync(hotels);
+        prefixStamp = stamp;
+    }
+
+    return prefixIndex.find(prefix, limit);
+}
+
 std::vector<std::shared_ptr<HotelBase>> HotelManager::sortByPrice() const {
-    std::vector<std::shared_ptr<HotelBase>> sorted = hotels;
+    OperationTimer timer(MetricOperation::SortHotelsByPrice);
+    TraceSpan span("sortHotelsByPrice", "search");
+    // Ключ сортування обчислюємо один раз на готель з кешованих агрегатів
+    std::vector<std::pair<double, std::shared_ptr<HotelBase>>> keyed;
+    keyed.reserve(hotels.size());
+    for (const auto& hotel : hotels) {
+        keyed.emplace_back(hotel->calculateAveragePrice(), hotel);
+    }
 
-    std::sort(sorted.begin(), sorted.end(),
-        [](const std::shared_ptr<HotelBase>& a, const std::shared_ptr<HotelBase>& b) {
-            return a->calculateAveragePrice() < b->calculateAveragePrice();
+    std::stable_sort(keyed.begin(), keyed.end(),
+        [](const std::pair<double, std::shared_ptr<HotelBase>>& a,
+            const std::pair<double, std::shared_ptr<HotelBase>>& b) {
+            return a.first < b.first;
         });
 
+    std::vector<std::shared_ptr<HotelBase>> sorted;
+    sorted.reserve(keyed.size());
+    for (auto& entry : keyed) {
+        sorted.push_back(std::move(entry.second));
+    }
+
     return sorted;
 }
 
 std::vector<std::shared_ptr<HotelBase>> HotelManager::sortByName() const {
+    OperationTimer timer(MetricOperation::SortHotelsByName);
+    TraceSpan span("sortHotelsByName", "search");
     std::vector<std::shared_ptr<HotelBase>> sorted = hotels;
 
     std::sort(sorted.begin(), sorted.end(),
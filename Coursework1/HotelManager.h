@@ -4,9 +4,15 @@
 #include "HotelBase.h"
 #include "PremiumHotel.h"
 #include "BudgetHotel.h"
+#include "RoomIndex.h"
+#include "FacetIndex.h"
+#include "PrefixIndex.h"
+#include "ReportWriter.h"
+#include "Journal.h"
 #include <vector>
 #include <string>
 #include <memory>
+#include <istream>
 
 /**
  * @class HotelManager
@@ -19,6 +25,69 @@ private:
     std::vector<std::shared_ptr<HotelBase>> hotels;
     std::string filename;
     int nextHotelId;
+    std::vector<int> pendingRemovals;
+    Journal journal;
+
+    // Індекс номерів оновлюється ліниво і лише для змінених готелів
+    mutable RoomIndex roomIndex;
+    mutable std::uint64_t roomIndexStamp;
+
+    // Фасети оновлюються інкрементально лише для змінених готелів
+    mutable FacetIndex facetIndex;
+    mutable std::uint64_t facetStamp;
+
+    // Індекс автодоповнення за назвами та містами
+    mutable PrefixIndex prefixIndex;
+    mutable std::uint64_t prefixStamp;
+
+    /**
+     * @brief Оновлює індекс номерів, якщо каталог змінився
+     */
+    void ensureRoomIndex() const;
+
+    /**
+     * @brief Створює готель потрібного типу з полів файлу
+     * @param amenities Маска зручностей (0x...) або перелік назв через ';' (старий формат)
+     * @return Вказівник на новий готель
+     */
+    std::shared_ptr<HotelBase> createHotel(int id, const std::string& type,
+        const std::string& name, const std::string& city, const std::string& description,
+        int stars, const std::string& amenities) const;
+
+    /**
+     * @brief Завантажує каталог у нормалізованому форматі (секції [hotels] та [rooms])
+     * @param in Потік, позиціонований після маркера секції [hotels]
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool loadCatalog(std::istream& in);
+
+    /**
+     * @brief Завантажує старий формат hotels.csv (один рядок на номер)
+     * @param in Потік, позиціонований після заголовка
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool loadLegacyHotels(std::istream& in);
+
+    /**
+     * @brief Записує рядок готелю (без номерів) у форматі каталогу
+     */
+    void writeHotelRow(std::ostream& out, const HotelBase& hotel) const;
+
+    /**
+     * @brief Записує рядок номера у форматі каталогу
+     */
+    void writeRoomRow(std::ostream& out, int hotelId, const Room& room) const;
+
+    /**
+     * @brief Відтворює зафіксовані транзакції журналу поверх завантаженого каталогу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool replayJournal();
+
+    /**
+     * @brief Знімає позначки змін з усіх готелів
+     */
+    void clearAllDirty();
 
 public:
     // Конструктори
@@ -45,16 +114,29 @@ public:
 
     /**
      * @brief Завантажує готелі з файлу CSV
+     *
+     * Підтримує нормалізований формат і старий формат "рядок на номер";
+     * старий файл буде перезаписано в новому форматі при наступному збереженні.
      * @return true якщо успішно, false в іншому випадку
      */
     bool loadHotels();
 
     /**
-     * @brief Зберігає готелі у файл CSV
+     * @brief Зберігає готелі у файл CSV (секція готелів + секція номерів)
      * @return true якщо успішно, false в іншому випадку
      */
     bool saveHotels();
 
+    /**
+     * @brief Дописує у журнал лише змінені та видалені готелі
+     *
+     * Для кожного зміненого готелю записується його повна версія (рядок H та
+     * рядки R номерів), для видаленого - надгробок D. Коли журнал стає
+     * завеликим, виконується повне збереження (компактизація).
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool flushChanges();
+
     /**
      * @brief Додає новий готель
      * @param hotel Вказівник на готель
@@ -69,6 +151,18 @@ public:
      */
     bool removeHotel(int hotelId);
 
+    /**
+     * @brief Масово змінює ціни номерів за фільтром міста, типу та класу
+     *
+     * Готелі обробляються паралельно (кожен потік - свій діапазон готелів),
+     * агрегати цін оновлюються в тому ж проході, а зміни зберігаються одним
+     * записом у журнал.
+     * @param rule Фільтр і зміна ціни
+     * @param repricedRooms Кількість номерів, ціна яких змінилась
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool repriceRooms(const RepriceRule& rule, int& repricedRooms);
+
     /**
      * @brief Знаходить готель за ID
      * @param hotelId ID готелю
@@ -77,9 +171,25 @@ public:
     std::shared_ptr<HotelBase> findHotel(int hotelId);
 
     /**
-     * @brief Виводить всі готелі
+     * @brief Виводить сторінку готелів таблицею
+     * @param offset Номер першого готелю (з 0)
+     * @param limit Кількість готелів на сторінці (0 - до кінця)
      */
-    void displayAllHotels() const;
+    void displayAllHotels(size_t offset = 0, size_t limit = 0) const;
+
+    /**
+     * @brief Записує сторінку готелів у звіт
+     * @param writer Звіт, створений з колонками reportColumns()
+     * @param offset Номер першого готелю (з 0)
+     * @param limit Кількість готелів (0 - до кінця)
+     * @return Кількість записаних рядків
+     */
+    size_t writeReport(ReportWriter& writer, size_t offset = 0, size_t limit = 0) const;
+
+    /**
+     * @brief Колонки звіту готелів
+     */
+    static std::vector<ReportColumn> reportColumns();
 
     /**
      * @brief Шукає готелі за містом
@@ -102,6 +212,15 @@ public:
      */
     std::vector<std::shared_ptr<HotelBase>> findHotelsByStars(int stars) const;
 
+    /**
+     * @brief Перераховує записи готелю в індексі номерів
+     *
+     * Мутатори номерів HotelBase змінюють ревізію готелю, тож індекс і так
+     * оновиться при наступному пошуку; метод перераховує записи одразу.
+     * @param hotelId ID готелю
+     */
+    void invalidateRoomIndex(int hotelId);
+
     /**
      * @brief Шукає вільні номери за критеріями
      * @param city Місто (опціонально)
@@ -116,6 +235,29 @@ public:
         int minCapacity = 1,
         double maxPrice = 999999.0) const;
 
+    /**
+     * @brief Рахує фасети каталогу (міста, зірки, типи, класи та ціни номерів)
+     * @param filter Фільтр (порожні поля не обмежують вибірку)
+     * @return Лічильники фасетів
+     */
+    FacetCounts getFacetCounts(const FacetFilter& filter = FacetFilter()) const;
+
+    /**
+     * @brief Шукає готелі, що мають усі вказані зручності
+     * @param required Маска потрібних зручностей
+     * @return Вектор готелів
+     */
+    std::vector<std::shared_ptr<HotelBase>> findHotelsWithAmenities(AmenityMask required) const;
+
+    /**
+     * @brief Шукає готелі за початком назви (будь-якого слова) або міста
+     * @param prefix Префікс без урахування регістру (UTF-8)
+     * @param limit Максимальна кількість результатів
+     * @return Вектор готелів
+     */
+    std::vector<std::shared_ptr<HotelBase>> suggestHotels(const std::string& prefix,
+        size_t limit = 10) const;
+
     /**
      * @brief Сортує готелі за ціною (зростання)
      * @return Відсортований вектор готелів
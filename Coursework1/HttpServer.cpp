@@ -0,0 +1,563 @@
+﻿#include "HttpServer.h"
+#include "Constants.hpp"
+#include "Logger.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+    std::string toLower(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+            [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+        return text;
+    }
+
+    std::string trim(const std::string& text) {
+        size_t first = text.find_first_not_of(" \t");
+        if (first == std::string::npos) {
+            return "";
+        }
+        size_t last = text.find_last_not_of(" \t");
+        return text.substr(first, last - first + 1);
+    }
+
+    int hexValue(char ch) {
+        if (ch >= '0' && ch <= '9') return ch - '0';
+        if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+        if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+        return -1;
+    }
+
+    // Розкодовує %XX та '+' (пробіл у параметрах запиту)
+    std::string urlDecode(const std::string& text, bool plusAsSpace) {
+        std::string result;
+        result.reserve(text.size());
+
+        for (size_t i = 0; i < text.size(); ++i) {
+            char ch = text[i];
+            if (ch == '%' && i + 2 < text.size()) {
+                int high = hexValue(text[i + 1]);
+                int low = hexValue(text[i + 2]);
+                if (high >= 0 && low >= 0) {
+                    result += static_cast<char>(high * 16 + low);
+                    i += 2;
+                    continue;
+                }
+            }
+            result += (plusAsSpace && ch == '+') ? ' ' : ch;
+        }
+        return result;
+    }
+
+    void parseQuery(const std::string& text, std::map<std::string, std::string>& query) {
+        size_t start = 0;
+        while (start <= text.size()) {
+            size_t amp = text.find('&', start);
+            std::string pair = text.substr(start, amp == std::string::npos ? std::string::npos : amp - start);
+
+            if (!pair.empty()) {
+                size_t equals = pair.find('=');
+                if (equals == std::string::npos) {
+                    query[urlDecode(pair, true)] = "";
+                }
+                else {
+                    query[urlDecode(pair.substr(0, equals), true)] = urlDecode(pair.substr(equals + 1), true);
+                }
+            }
+
+            if (amp == std::string::npos) {
+                break;
+            }
+            start = amp + 1;
+        }
+    }
+
+    const char* statusText(int status) {
+        switch (status) {
+        case 200: return "OK";
+        case 201: return "Created";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 403: return "Forbidden";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 409: return "Conflict";
+        case 413: return "Payload Too Large";
+        default: return "Internal Server Error";
+        }
+    }
+}
+
+// HttpRequest
+
+std::string HttpRequest::header(const std::string& name) const {
+    auto it = headers.find(name);
+    return it == headers.end() ? "" : it->second;
+}
+
+// Конструктор з параметрами
+HttpServer::HttpServer(int port, size_t workerCount, Handler handler)
+    : handler(std::move(handler)), port(port), workerCount(workerCount > 0 ? workerCount : 1),
+    listenFd(-1), epollFd(-1), wakeFd(-1), running(false), requestsServed(0) {
+}
+
+// Деструктор
+HttpServer::~HttpServer() {
+    stop();
+}
+
+// Getters
+int HttpServer::getPort() const {
+    return port;
+}
+
+std::uint64_t HttpServer::getRequestsServed() const {
+    return requestsServed.load();
+}
+
+// Власні методи
+
+int HttpServer::parseRequest(const std::string& buffer, size_t offset,
+    HttpRequest& request, size_t& consumed) {
+    size_t headerEnd = buffer.find("\r\n\r\n", offset);
+    if (headerEnd == std::string::npos) {
+        return buffer.size() - offset > HTTP_MAX_HEADER_BYTES ? -1 : 0;
+    }
+    if (headerEnd - offset > HTTP_MAX_HEADER_BYTES) {
+        return -1;
+    }
+
+    // Рядок запиту: МЕТОД ціль HTTP/1.x
+    size_t lineEnd = buffer.find("\r\n", offset);
+    std::string requestLine = buffer.substr(offset, lineEnd - offset);
+    size_t firstSpace = requestLine.find(' ');
+    size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+    if (firstSpace == std::string::npos || secondSpace == std::string::npos) {
+        return -1;
+    }
+
+    std::string version = requestLine.substr(secondSpace + 1);
+    if (version.compare(0, 7, "HTTP/1.") != 0) {
+        return -1;
+    }
+
+    request = HttpRequest();
+    request.method = requestLine.substr(0, firstSpace);
+    request.keepAlive = version != "HTTP/1.0";
+
+    std::string target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    size_t question = target.find('?');
+    request.path = urlDecode(target.substr(0, question), false);
+    if (question != std::string::npos) {
+        parseQuery(target.substr(question + 1), request.query);
+    }
+
+    // Заголовки
+    size_t position = lineEnd + 2;
+    while (position < headerEnd) {
+        size_t end = buffer.find("\r\n", position);
+        std::string line = buffer.substr(position, end - position);
+        position = end + 2;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            return -1;
+        }
+        request.headers[toLower(trim(line.substr(0, colon)))] = trim(line.substr(colon + 1));
+    }
+
+    // Chunked-тіла не підтримуються: клієнти сервісу завжди знають довжину тіла
+    if (!request.header("transfer-encoding").empty()) {
+        return -1;
+    }
+
+    std::string connection = toLower(request.header("connection"));
+    if (connection == "close") {
+        request.keepAlive = false;
+    }
+    else if (connection == "keep-alive") {
+        request.keepAlive = true;
+    }
+
+    size_t contentLength = 0;
+    std::string lengthText = request.header("content-length");
+    if (!lengthText.empty()) {
+        if (lengthText.size() > 9 || lengthText.find_first_not_of("0123456789") != std::string::npos) {
+            return -1;
+        }
+        contentLength = std::stoul(lengthText);
+        if (contentLength > HTTP_MAX_BODY_BYTES) {
+            return -1;
+        }
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    if (buffer.size() - bodyStart < contentLength) {
+        return 0;
+    }
+
+    request.body = buffer.substr(bodyStart, contentLength);
+    consumed = bodyStart + contentLength - offset;
+    return 1;
+}
+
+void HttpServer::appendResponse(Connection& connection, const HttpResponse& response, bool keepAlive) {
+    std::string& out = connection.output;
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.status);
+    out += ' ';
+    out += statusText(response.status);
+    out += "\r\nContent-Type: application/json; charset=utf-8\r\nContent-Length: ";
+    out += std::to_string(response.body.size());
+    out += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    out += response.body;
+}
+
+#ifdef __linux__
+
+bool HttpServer::start() {
+    if (running) {
+        return true;
+    }
+
+    listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        std::cerr << "Не вдалося створити сокет: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenFd, HTTP_LISTEN_BACKLOG) < 0) {
+        std::cerr << "Не вдалося відкрити порт " << port << ": " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    // Порт 0 означає вибір вільного порту системою
+    socklen_t length = sizeof(address);
+    if (getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+        port = ntohs(address.sin_port);
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        std::cerr << "Не вдалося ініціалізувати epoll: " << std::strerror(errno) << std::endl;
+        stop();
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = &listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+    event.data.ptr = &wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    running = true;
+    ioThread = std::thread(&HttpServer::ioLoop, this);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&HttpServer::workerLoop, this);
+    }
+
+    return true;
+}
+
+void HttpServer::stop() {
+    bool wasRunning = running.exchange(false);
+
+    if (wasRunning) {
+        std::uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+        queueReady.notify_all();
+
+        if (ioThread.joinable()) {
+            ioThread.join();
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex);
+        for (auto& entry : connections) {
+            close(entry.first);
+        }
+        connections.clear();
+    }
+    readyConnections.clear();
+
+    for (int* fd : { &listenFd, &epollFd, &wakeFd }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void HttpServer::ioLoop() {
+    const int MAX_EVENTS = 128;
+    epoll_event events[MAX_EVENTS];
+
+    while (running) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("Помилка epoll_wait: " << std::strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            void* tag = events[i].data.ptr;
+            if (tag == &wakeFd) {
+                continue;
+            }
+            if (tag == &listenFd) {
+                acceptConnections();
+                continue;
+            }
+
+            // Завдяки EPOLLONESHOT з'єднання не повернеться, поки його не переозброять
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                readyConnections.push_back(static_cast<Connection*>(tag));
+            }
+            queueReady.notify_one();
+        }
+    }
+}
+
+void HttpServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN - черга прийому порожня; інші помилки (EMFILE тощо) не зупиняють сервер
+            return;
+        }
+
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::unique_ptr<Connection> connection(new Connection());
+        connection->fd = fd;
+        Connection* raw = connection.get();
+        {
+            std::lock_guard<std::mutex> lock(connectionsMutex);
+            connections[fd] = std::move(connection);
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = raw;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            closeConnection(*raw);
+        }
+    }
+}
+
+void HttpServer::workerLoop() {
+    while (true) {
+        Connection* connection = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return !running || !readyConnections.empty(); });
+            if (!running) {
+                return;
+            }
+            connection = readyConnections.front();
+            readyConnections.pop_front();
+        }
+
+        serviceConnection(*connection);
+    }
+}
+
+void HttpServer::serviceConnection(Connection& connection) {
+    connection.handoffs.load(std::memory_order_acquire);
+
+    // Спершу дописуємо відповіді, що не влізли у сокет минулого разу
+    if (connection.outputSent < connection.output.size()) {
+        if (!flushOutput(connection)) {
+            closeConnection(connection);
+            return;
+        }
+        if (connection.outputSent < connection.output.size()) {
+            rearm(connection, true);
+            return;
+        }
+        if (connection.closeAfterWrite) {
+            closeConnection(connection);
+            return;
+        }
+    }
+
+    bool peerClosed = false;
+    char buffer[16 * 1024];
+    while (true) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, static_cast<size_t>(received));
+            if (connection.input.size() > HTTP_MAX_HEADER_BYTES + HTTP_MAX_BODY_BYTES) {
+                break;
+            }
+            continue;
+        }
+        if (received == 0) {
+            peerClosed = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        closeConnection(connection);
+        return;
+    }
+
+    // Обробляємо всі повні запити по черзі: відповіді йдуть у порядку запитів
+    size_t offset = 0;
+    while (!connection.closeAfterWrite) {
+        HttpRequest request;
+        size_t consumed = 0;
+        int parsed = parseRequest(connection.input, offset, request, consumed);
+
+        if (parsed == 0) {
+            break;
+        }
+        if (parsed < 0) {
+            HttpResponse response;
+            response.status = 400;
+            response.body = "{\"error\":\"bad_request\"}";
+            appendResponse(connection, response, false);
+            connection.closeAfterWrite = true;
+            break;
+        }
+
+        offset += consumed;
+        HttpResponse response;
+        try {
+            response = handler(request);
+        }
+        catch (const std::exception&) {
+            response.status = 500;
+            response.body = "{\"error\":\"internal\"}";
+        }
+
+        appendResponse(connection, response, request.keepAlive);
+        requestsServed++;
+        if (!request.keepAlive) {
+            connection.closeAfterWrite = true;
+        }
+    }
+    connection.input.erase(0, offset);
+
+    if (peerClosed) {
+        connection.closeAfterWrite = true;
+    }
+
+    if (!flushOutput(connection)) {
+        closeConnection(connection);
+        return;
+    }
+    if (connection.outputSent < connection.output.size()) {
+        rearm(connection, true);
+        return;
+    }
+    if (connection.closeAfterWrite) {
+        closeConnection(connection);
+        return;
+    }
+    rearm(connection, false);
+}
+
+bool HttpServer::flushOutput(Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent,
+            connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputSent += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;
+        }
+        return false;
+    }
+
+    connection.output.clear();
+    connection.outputSent = 0;
+    return true;
+}
+
+void HttpServer::rearm(Connection& connection, bool wantWrite) {
+    int fd = connection.fd;
+    epoll_event event{};
+    event.events = (wantWrite ? EPOLLOUT : EPOLLIN) | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.ptr = &connection;
+
+    // Після переозброєння з'єднанням може одразу заволодіти інший потік
+    connection.handoffs.fetch_add(1, std::memory_order_release);
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) < 0) {
+        closeConnection(connection);
+    }
+}
+
+void HttpServer::closeConnection(Connection& connection) {
+    int fd = connection.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+
+    // Дескриптор закриваємо під блокуванням після видалення запису, інакше
+    // accept4 може повторно видати той самий номер до erase
+    std::lock_guard<std::mutex> lock(connectionsMutex);
+    connections.erase(fd);
+    close(fd);
+}
+
+#else
+
+bool HttpServer::start() {
+    std::cerr << "HTTP-сервіс потребує epoll і доступний лише у Linux." << std::endl;
+    return false;
+}
+
+void HttpServer::stop() {
+    running = false;
+}
+
+#endif
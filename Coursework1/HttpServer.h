@@ -0,0 +1,149 @@
+﻿#ifndef HTTPSERVER_H
+#define HTTPSERVER_H
+
+#include <string>
+#include <map>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @struct HttpRequest
+ * @brief Розібраний запит HTTP/1.1
+ */
+struct HttpRequest {
+    std::string method;
+    std::string path;
+    std::map<std::string, std::string> query;
+    std::map<std::string, std::string> headers;   // імена у нижньому регістрі
+    std::string body;
+    bool keepAlive = true;
+
+    /**
+     * @brief Отримує заголовок за іменем у нижньому регістрі
+     * @return Значення або порожній рядок
+     */
+    std::string header(const std::string& name) const;
+};
+
+/**
+ * @struct HttpResponse
+ * @brief Відповідь обробника (тіло - JSON)
+ */
+struct HttpResponse {
+    int status = 200;
+    std::string body;
+};
+
+/**
+ * @class HttpServer
+ * @brief Вбудований HTTP/1.1 сервер на localhost з фіксованим пулом потоків
+ *
+ * Потік вводу-виводу чекає на події epoll; готові з'єднання (EPOLLONESHOT)
+ * передаються у чергу робочих потоків. Робочий потік вичитує всі дані,
+ * обробляє всі повні запити по черзі (конвеєризація) та пише відповіді
+ * у тому ж порядку. Поки з'єднання у роботі, epoll його не повертає,
+ * тому один клієнт завжди обслуговується одним потоком.
+ *
+ * Реалізація використовує epoll і доступна лише у Linux; на інших
+ * платформах start() повідомляє про помилку.
+ */
+class HttpServer {
+public:
+    using Handler = std::function<HttpResponse(const HttpRequest&)>;
+
+private:
+    /**
+     * @struct Connection
+     * @brief Стан одного клієнтського з'єднання
+     */
+    struct Connection {
+        int fd = -1;
+        std::string input;
+        std::string output;
+        size_t outputSent = 0;
+        bool closeAfterWrite = false;
+
+        // Передача з'єднання між робочими потоками через epoll не є синхронізацією
+        // з погляду моделі пам'яті C++, тому стан публікується release/acquire
+        std::atomic<std::uint32_t> handoffs{ 0 };
+    };
+
+    Handler handler;
+    int port;
+    size_t workerCount;
+
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    std::atomic<bool> running;
+
+    std::thread ioThread;
+    std::vector<std::thread> workers;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<Connection*> readyConnections;
+
+    std::mutex connectionsMutex;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+
+    std::atomic<std::uint64_t> requestsServed;
+
+    void ioLoop();
+    void workerLoop();
+    void acceptConnections();
+    void serviceConnection(Connection& connection);
+    bool flushOutput(Connection& connection);
+    void rearm(Connection& connection, bool wantWrite);
+    void closeConnection(Connection& connection);
+    void appendResponse(Connection& connection, const HttpResponse& response, bool keepAlive);
+
+public:
+    // Конструктори
+    HttpServer(int port, size_t workerCount, Handler handler);
+    HttpServer(const HttpServer& other) = delete;
+    HttpServer(HttpServer&& other) = delete;
+
+    // Деструктор
+    ~HttpServer();
+
+    // Оператори присвоєння
+    HttpServer& operator=(const HttpServer& other) = delete;
+    HttpServer& operator=(HttpServer&& other) = delete;
+
+    // Getters
+    int getPort() const;
+    std::uint64_t getRequestsServed() const;
+
+    /**
+     * @brief Відкриває сокет на 127.0.0.1 і запускає потоки
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool start();
+
+    /**
+     * @brief Зупиняє потоки та закриває всі з'єднання
+     */
+    void stop();
+
+    /**
+     * @brief Розбирає один запит з буфера починаючи з offset
+     * @param buffer Накопичені дані з'єднання
+     * @param offset Початок запиту в буфері
+     * @param request Розібраний запит
+     * @param consumed Кількість байтів, зайнятих запитом
+     * @return 1 - запит розібрано, 0 - потрібно більше даних, -1 - некоректний запит
+     */
+    static int parseRequest(const std::string& buffer, size_t offset,
+        HttpRequest& request, size_t& consumed);
+};
+
+#endif // HTTPSERVER_H
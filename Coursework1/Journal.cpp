@@ -0,0 +1,402 @@
+﻿#include "Journal.h"
+#include "Constants.hpp"
+#include "Logger.h"
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <share.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Таблиця CRC32 для полінома 0xEDB88320 (будується один раз)
+    const std::uint32_t* crcTable() {
+        static const struct Table {
+            std::uint32_t values[256];
+            Table() {
+                for (std::uint32_t i = 0; i < 256; ++i) {
+                    std::uint32_t value = i;
+                    for (int bit = 0; bit < 8; ++bit) {
+                        value = (value & 1) ? (value >> 1) ^ 0xEDB88320u : value >> 1;
+                    }
+                    values[i] = value;
+                }
+            }
+        } table;
+        return table.values;
+    }
+
+    std::string toHex(std::uint32_t value) {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex(8, '0');
+        for (int i = 7; i >= 0; --i) {
+            hex[static_cast<size_t>(i)] = digits[value & 0xF];
+            value >>= 4;
+        }
+        return hex;
+    }
+
+    // Розбирає рядок фіксації "@<кількість>,<crc>"
+    bool parseCommit(const std::string& line, std::size_t& count, std::uint32_t& crc) {
+        size_t comma = line.find(',');
+        if (line.size() < 2 || line[0] != '@' || comma == std::string::npos ||
+            line.size() - comma - 1 != 8) {
+            return false;
+        }
+
+        char* end = nullptr;
+        std::string countText = line.substr(1, comma - 1);
+        unsigned long long parsedCount = std::strtoull(countText.c_str(), &end, 10);
+        if (countText.empty() || *end != '\0') {
+            return false;
+        }
+
+        std::string crcText = line.substr(comma + 1);
+        unsigned long parsedCrc = std::strtoul(crcText.c_str(), &end, 16);
+        if (*end != '\0') {
+            return false;
+        }
+
+        count = static_cast<std::size_t>(parsedCount);
+        crc = static_cast<std::uint32_t>(parsedCrc);
+        return true;
+    }
+
+    // Чи є після позиції from ціла зафіксована транзакція. Кожен рядок
+    // фіксації перевіряється разом із count рядками перед ним, тож
+    // пошкоджений '@' у попередній транзакції не ховає наступних
+    bool hasCommittedAfter(const std::string& data, size_t from) {
+        std::vector<size_t> lineStarts;
+        size_t position = from;
+        while (position < data.size()) {
+            size_t lineEnd = data.find('\n', position);
+            if (lineEnd == std::string::npos) {
+                break;
+            }
+
+            std::size_t count = 0;
+            std::uint32_t crc = 0;
+            if (data[position] == '@' &&
+                parseCommit(data.substr(position, lineEnd - position), count, crc) &&
+                count > 0 && count <= lineStarts.size()) {
+                size_t bodyStart = lineStarts[lineStarts.size() - count];
+                if (Journal::crc32(data.data() + bodyStart, position - bodyStart) == crc) {
+                    return true;
+                }
+            }
+            lineStarts.push_back(position);
+            position = lineEnd + 1;
+        }
+        return false;
+    }
+
+    // Фіксує на диску запис каталогу (перейменування файлу всередині нього)
+    bool syncDirectory(const std::string& path) {
+#ifdef _WIN32
+        // NTFS журналює метадані сама, окремого fsync для каталогу немає
+        (void)path;
+        return true;
+#else
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        return synced;
+#endif
+    }
+}
+
+// Конструктор за замовчуванням
+Journal::Journal()
+    : path(), records(0) {
+}
+
+// Конструктор з параметром
+Journal::Journal(const std::string& path)
+    : path(path), records(0) {
+}
+
+// Getters
+const std::string& Journal::getPath() const {
+    return path;
+}
+
+std::size_t Journal::getRecordCount() const {
+    return records;
+}
+
+// Setters
+void Journal::setPath(const std::string& path) {
+    this->path = path;
+    records = 0;
+}
+
+// Власні методи
+
+std::uint32_t Journal::crc32(const char* data, std::size_t size, std::uint32_t crc) {
+    const std::uint32_t* table = crcTable();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+bool Journal::syncFile(const std::string& path) {
+#ifdef _WIN32
+    int fd = -1;
+    if (_sopen_s(&fd, path.c_str(), _O_RDWR | _O_BINARY, _SH_DENYNO, _S_IREAD | _S_IWRITE) != 0) {
+        return false;
+    }
+    bool synced = _commit(fd) == 0;
+    _close(fd);
+    return synced;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+bool Journal::replaceFile(const std::string& tempPath, const std::string& path) {
+    // На Windows rename також замінює існуючий файл
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    return !error && syncDirectory(path);
+}
+
+bool Journal::writeAtomically(const std::string& path, const std::function<bool(std::ostream&)>& write) {
+    std::string tempPath = path + SNAPSHOT_TEMP_SUFFIX;
+    bool written = false;
+    try {
+        std::ofstream file(tempPath, std::ios::trunc | std::ios::binary);
+        if (file.is_open()) {
+            written = write(file);
+            file.close();
+            written = written && !file.fail() && syncFile(tempPath);
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка запису знімка " << path << ": " << e.what());
+        written = false;
+    }
+
+    if (!written || !replaceFile(tempPath, path)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Journal::append(const std::vector<std::string>& lines) {
+    if (lines.empty()) {
+        return true;
+    }
+
+    // Транзакція збирається в один буфер і пишеться одним викликом
+    std::string buffer;
+    std::error_code error;
+    if (!std::filesystem::exists(path, error) || std::filesystem::file_size(path, error) == 0) {
+        buffer += JOURNAL_HEADER;
+        buffer += '\n';
+    }
+
+    size_t bodyStart = buffer.size();
+    for (const auto& line : lines) {
+        buffer += line;
+        buffer += '\n';
+    }
+    std::uint32_t crc = crc32(buffer.data() + bodyStart, buffer.size() - bodyStart);
+    buffer += '@';
+    buffer += std::to_string(lines.size());
+    buffer += ',';
+    buffer += toHex(crc);
+    buffer += '\n';
+
+    try {
+        std::ofstream file(path, std::ios::app | std::ios::binary);
+        if (!file.is_open()) {
+            LOG_ERROR("Не вдалося відкрити файл для запису: " << path);
+            return false;
+        }
+
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.close();
+        if (file.fail() || !syncFile(path)) {
+            return false;
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка дописування журналу " << path << ": " << e.what());
+        return false;
+    }
+
+    records += lines.size();
+    return true;
+}
+
+bool Journal::reset() {
+    try {
+        std::ofstream file(path, std::ios::trunc | std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << JOURNAL_HEADER << '\n';
+        file.close();
+        if (file.fail() || !syncFile(path)) {
+            return false;
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка очищення журналу " << path << ": " << e.what());
+        return false;
+    }
+
+    records = 0;
+    return true;
+}
+
+bool Journal::replay(const std::function<void(const std::string&)>& apply) {
+    records = 0;
+    std::string data;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return true;
+        }
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad()) {
+            LOG_ERROR("Не вдалося прочитати журнал: " << path);
+            return false;
+        }
+    }
+
+    if (data.empty()) {
+        return true;
+    }
+    size_t headerEnd = data.find('\n');
+    if (headerEnd == std::string::npos || data.compare(0, headerEnd, JOURNAL_HEADER) != 0) {
+        return replayLegacy(data, apply);
+    }
+
+    size_t validEnd = headerEnd + 1;
+    size_t position = validEnd;
+    std::vector<std::string> pending;
+
+    while (position < data.size()) {
+        size_t lineEnd = data.find('\n', position);
+        if (lineEnd == std::string::npos) {
+            break;                                  // обірваний останній рядок
+        }
+
+        std::string line = data.substr(position, lineEnd - position);
+        if (line.empty() || line[0] != '@') {
+            pending.push_back(line);
+            position = lineEnd + 1;
+            continue;
+        }
+
+        std::size_t count = 0;
+        std::uint32_t crc = 0;
+        if (!parseCommit(line, count, crc) || count != pending.size() ||
+            crc32(data.data() + validEnd, position - validEnd) != crc) {
+            break;                                  // пошкоджена транзакція
+        }
+
+        for (const auto& record : pending) {
+            apply(record);
+        }
+        records += pending.size();
+        pending.clear();
+        position = lineEnd + 1;
+        validEnd = position;
+    }
+
+    if (validEnd < data.size() && hasCommittedAfter(data, validEnd)) {
+        // Пошкодження посередині: відрізати означало б втратити зафіксовані
+        // зміни після нього, тож файл лишається як є, а копія - для ручного розбору
+        std::string corruptPath = path + JOURNAL_CORRUPT_SUFFIX;
+        std::error_code error;
+        std::filesystem::copy_file(path, corruptPath,
+            std::filesystem::copy_options::overwrite_existing, error);
+        // Окремі короткі повідомлення, щоб шлях копії не обрізався межею довжини запису
+        LOG_ERROR("Журнал " << path << " пошкоджено на зсуві " << validEnd);
+        LOG_ERROR("Після пошкодження є зафіксовані транзакції, застосовано лише записи до нього");
+        if (error) {
+            LOG_ERROR("Не вдалося скопіювати журнал: " << error.message());
+        }
+        else {
+            LOG_ERROR("Копія журналу: " << corruptPath);
+        }
+        return false;
+    }
+
+    if (validEnd < data.size()) {
+        LOG_WARNING("Журнал " << path << ": відкинуто недописаний або пошкоджений хвіст ("
+            << data.size() - validEnd << " байт)");
+        std::error_code error;
+        std::filesystem::resize_file(path, validEnd, error);
+        if (error) {
+            LOG_ERROR("Не вдалося обрізати журнал " << path << ": " << error.message());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Journal::replayLegacy(const std::string& data, const std::function<void(const std::string&)>& apply) {
+    // Кожен завершений рядок - окремий запис, обірваний останній пропускаємо
+    std::vector<std::string> lines;
+    size_t position = 0;
+    while (position < data.size()) {
+        size_t lineEnd = data.find('\n', position);
+        if (lineEnd == std::string::npos) {
+            break;
+        }
+        std::string line = data.substr(position, lineEnd - position);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            apply(line);
+            lines.push_back(line);
+        }
+        position = lineEnd + 1;
+    }
+
+    // Переписуємо у новому форматі, щоб наступні транзакції мали суми
+    bool converted = writeAtomically(path, [&lines](std::ostream& out) {
+        out << JOURNAL_HEADER << '\n';
+        std::string body;
+        for (const auto& line : lines) {
+            body.assign(line);
+            body += '\n';
+            out << body << '@' << 1 << ',' << toHex(crc32(body.data(), body.size())) << '\n';
+        }
+        return true;
+    });
+    if (!converted) {
+        LOG_ERROR("Не вдалося перетворити журнал старого формату: " << path);
+        return false;
+    }
+
+    records = lines.size();
+    return true;
+}
@@ -0,0 +1,113 @@
+﻿#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class Journal
+ * @brief Журнал змін з контрольними сумами поверх атомарних знімків
+ *
+ * Файл починається з рядка JOURNAL_HEADER, далі йдуть транзакції: рядки
+ * записів і рядок фіксації "@<кількість рядків>,<CRC32>", де сума рахується
+ * по всіх байтах рядків транзакції. Дописування завершується fsync, тож
+ * після успішного append() транзакція переживе збій.
+ *
+ * replay() застосовує лише зафіксовані транзакції з правильною сумою.
+ * Обірваний рядок, транзакцію без фіксації або неправильну суму в кінці
+ * файлу вважаємо недописаним хвостом: він відрізається, щоб нові
+ * транзакції йшли одразу після останньої цілої. Якщо ж після пошкодження
+ * є цілі зафіксовані транзакції, файл не змінюється, його копія
+ * зберігається з суфіксом JOURNAL_CORRUPT_SUFFIX, а replay() повертає
+ * false. Старі журнали без заголовка
+ * (по запису на рядок) відтворюються і переписуються у новому форматі.
+ *
+ * Записи мають бути ідемпотентними (нова версія об'єкта цілком або його
+ * видалення): збій між заміною знімка і reset() лише повторно застосує
+ * вже врахований у знімку запис.
+ */
+class Journal {
+private:
+    std::string path;
+    std::size_t records;        // рядків записів з останнього знімка
+
+    /**
+     * @brief Відтворює журнал старого формату (без заголовка й сум)
+     */
+    bool replayLegacy(const std::string& data, const std::function<void(const std::string&)>& apply);
+
+public:
+    // Конструктори
+    Journal();
+    explicit Journal(const std::string& path);
+
+    // Getters
+    const std::string& getPath() const;
+    std::size_t getRecordCount() const;
+
+    // Setters
+    void setPath(const std::string& path);
+
+    // Власні методи
+
+    /**
+     * @brief Атомарно дописує транзакцію і чекає її запису на диск
+     * @param lines Рядки записів (без символів нового рядка)
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool append(const std::vector<std::string>& lines);
+
+    /**
+     * @brief Застосовує зафіксовані транзакції і відрізає недописаний хвіст
+     * @param apply Обробник одного рядка запису
+     * @return true якщо успішно (зокрема, якщо журналу немає), false при помилці
+     *         вводу-виводу або пошкодженні посередині журналу
+     */
+    bool replay(const std::function<void(const std::string&)>& apply);
+
+    /**
+     * @brief Очищає журнал після успішного знімка
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool reset();
+
+    /**
+     * @brief Записує файл через тимчасовий файл, fsync і перейменування
+     *
+     * Наявний файл до останнього кроку не змінюється, тож після збою на
+     * диску лишається або старий, або новий повний знімок.
+     * @param path Шлях до файлу
+     * @param write Функція, що записує вміст і повертає true при успіху
+     * @return true якщо успішно, false в іншому випадку
+     */
+    static bool writeAtomically(const std::string& path, const std::function<bool(std::ostream&)>& write);
+
+    /**
+     * @brief Замінює файл тимчасовим і фіксує перейменування на диску
+     * @param tempPath Повністю записаний тимчасовий файл
+     * @param path Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    static bool replaceFile(const std::string& tempPath, const std::string& path);
+
+    /**
+     * @brief Скидає вміст файлу з кешу ОС на диск (fsync / _commit)
+     * @param path Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    static bool syncFile(const std::string& path);
+
+    /**
+     * @brief Обчислює CRC32 (IEEE 802.3)
+     * @param data Дані
+     * @param size Кількість байтів
+     * @param crc Сума попередніх частин (для продовження)
+     */
+    static std::uint32_t crc32(const char* data, std::size_t size, std::uint32_t crc = 0);
+};
+
+#endif // JOURNAL_H
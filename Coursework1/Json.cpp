@@ -0,0 +1,208 @@
+﻿#include "Json.h"
+#include <cstdint>
+
+namespace {
+    void skipSpaces(const std::string& text, size_t& pos) {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' ||
+            text[pos] == '\n' || text[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    void appendUtf8(std::string& out, std::uint32_t code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        }
+        else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseHex4(const std::string& text, size_t pos, std::uint32_t& code) {
+        if (pos + 4 > text.size()) {
+            return false;
+        }
+
+        code = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+            char ch = text[i];
+            std::uint32_t digit;
+            if (ch >= '0' && ch <= '9') digit = ch - '0';
+            else if (ch >= 'a' && ch <= 'f') digit = ch - 'a' + 10;
+            else if (ch >= 'A' && ch <= 'F') digit = ch - 'A' + 10;
+            else return false;
+            code = code * 16 + digit;
+        }
+        return true;
+    }
+
+    // Розбирає рядковий літерал, pos вказує на відкриваючу лапку
+    bool parseString(const std::string& text, size_t& pos, std::string& value) {
+        value.clear();
+        pos++;
+
+        while (pos < text.size()) {
+            char ch = text[pos++];
+            if (ch == '"') {
+                return true;
+            }
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                return false;
+            }
+            if (ch != '\\') {
+                value += ch;
+                continue;
+            }
+
+            if (pos >= text.size()) {
+                return false;
+            }
+            char escape = text[pos++];
+            switch (escape) {
+            case '"': value += '"'; break;
+            case '\\': value += '\\'; break;
+            case '/': value += '/'; break;
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u': {
+                std::uint32_t code;
+                if (!parseHex4(text, pos, code)) {
+                    return false;
+                }
+                pos += 4;
+
+                // Сурогатна пара для символів поза базовою площиною
+                if (code >= 0xD800 && code <= 0xDBFF) {
+                    std::uint32_t low;
+                    if (pos + 6 > text.size() || text[pos] != '\\' || text[pos + 1] != 'u' ||
+                        !parseHex4(text, pos + 2, low) || low < 0xDC00 || low > 0xDFFF) {
+                        return false;
+                    }
+                    pos += 6;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if (code >= 0xDC00 && code <= 0xDFFF) {
+                    return false;
+                }
+                appendUtf8(value, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // Число, true, false або null зберігаються як текст
+    bool parseScalar(const std::string& text, size_t& pos, std::string& value) {
+        size_t start = pos;
+        while (pos < text.size() && text[pos] != ',' && text[pos] != '}' &&
+            text[pos] != ' ' && text[pos] != '\t' && text[pos] != '\n' && text[pos] != '\r') {
+            char ch = text[pos];
+            if (ch == '"' || ch == '{' || ch == '[' || ch == ']' || ch == ':') {
+                return false;
+            }
+            pos++;
+        }
+        value = text.substr(start, pos - start);
+        return !value.empty();
+    }
+}
+
+std::string Json::quote(const std::string& text) {
+    static const char DIGITS[] = "0123456789abcdef";
+
+    std::string result;
+    result.reserve(text.size() + 2);
+    result += '"';
+    for (char ch : text) {
+        unsigned char code = static_cast<unsigned char>(ch);
+        if (ch == '"' || ch == '\\') {
+            result += '\\';
+            result += ch;
+        }
+        else if (code < 0x20) {
+            result += "\\u00";
+            result += DIGITS[code >> 4];
+            result += DIGITS[code & 0x0F];
+        }
+        else {
+            result += ch;
+        }
+    }
+    result += '"';
+    return result;
+}
+
+bool Json::parseObject(const std::string& text, std::map<std::string, std::string>& fields) {
+    fields.clear();
+    size_t pos = 0;
+
+    skipSpaces(text, pos);
+    if (pos >= text.size() || text[pos] != '{') {
+        return false;
+    }
+    pos++;
+
+    skipSpaces(text, pos);
+    if (pos < text.size() && text[pos] == '}') {
+        pos++;
+        skipSpaces(text, pos);
+        return pos == text.size();
+    }
+
+    while (pos < text.size()) {
+        std::string key;
+        std::string value;
+
+        skipSpaces(text, pos);
+        if (pos >= text.size() || text[pos] != '"' || !parseString(text, pos, key)) {
+            return false;
+        }
+
+        skipSpaces(text, pos);
+        if (pos >= text.size() || text[pos] != ':') {
+            return false;
+        }
+        pos++;
+
+        skipSpaces(text, pos);
+        if (pos >= text.size()) {
+            return false;
+        }
+        bool parsed = text[pos] == '"' ? parseString(text, pos, value) : parseScalar(text, pos, value);
+        if (!parsed) {
+            return false;
+        }
+        fields[key] = value;
+
+        skipSpaces(text, pos);
+        if (pos < text.size() && text[pos] == ',') {
+            pos++;
+            continue;
+        }
+        if (pos < text.size() && text[pos] == '}') {
+            pos++;
+            skipSpaces(text, pos);
+            return pos == text.size();
+        }
+        return false;
+    }
+    return false;
+}
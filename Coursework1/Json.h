@@ -0,0 +1,35 @@
+﻿#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <map>
+
+/**
+ * @class Json
+ * @brief Мінімальні утиліти JSON для пакетного режиму та HTTP-сервісу
+ *
+ * Відповіді формуються вручну, тому потрібне лише екранування рядків.
+ * Тіла запитів - пласкі об'єкти без вкладених масивів та об'єктів.
+ */
+class Json {
+public:
+    /**
+     * @brief Бере рядок у лапки з екрануванням для JSON
+     * @param text Рядок UTF-8
+     * @return Рядковий літерал JSON
+     */
+    static std::string quote(const std::string& text);
+
+    /**
+     * @brief Розбирає плаский об'єкт {"ключ": значення, ...}
+     *
+     * Рядкові значення розекрановуються (включно з \uXXXX у UTF-8), числа
+     * та true/false/null повертаються як текст.
+     * @param text Текст JSON
+     * @param fields Поля об'єкта
+     * @return true якщо успішно, false якщо текст не є пласким об'єктом
+     */
+    static bool parseObject(const std::string& text, std::map<std::string, std::string>& fields);
+};
+
+#endif // JSON_H
@@ -0,0 +1,260 @@
+﻿#include "Logger.h"
+#include "Constants.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+    static_assert((LOG_QUEUE_CAPACITY & (LOG_QUEUE_CAPACITY - 1)) == 0,
+        "Місткість черги журналу має бути степенем двійки");
+
+    const char* const LEVEL_PREFIXES[] = { "[DEBUG] ", "[INFO] ", "[WARN] ", "[ERROR] " };
+
+    std::string environmentValue(const char* name) {
+#ifdef _MSC_VER
+        char* value = nullptr;
+        size_t length = 0;
+        std::string result;
+        if (_dupenv_s(&value, &length, name) == 0 && value) {
+            result = value;
+        }
+        std::free(value);
+        return result;
+#else
+        const char* value = std::getenv(name);
+        return value ? value : "";
+#endif
+    }
+
+    LogLevel initialLevel() {
+        std::string value = environmentValue("COURSEWORK1_LOG_LEVEL");
+        if (value == "debug") return LogLevel::Debug;
+        if (value == "warning") return LogLevel::Warning;
+        if (value == "error") return LogLevel::Error;
+        if (value == "off") return LogLevel::Off;
+        return LogLevel::Info;
+    }
+
+    std::atomic<std::uint8_t> currentLevel{ static_cast<std::uint8_t>(initialLevel()) };
+
+    /**
+     * @struct Slot
+     * @brief Комірка кільцевого буфера з номером послідовності
+     *
+     * sequence == позиція: комірка вільна для запису з цією позицією;
+     * sequence == позиція + 1: повідомлення готове до читання.
+     */
+    struct Slot {
+        std::atomic<size_t> sequence{ 0 };
+        LogLevel level = LogLevel::Info;
+        std::uint16_t length = 0;
+        char text[LOG_MESSAGE_MAX_BYTES];
+    };
+
+    /**
+     * @class AsyncWriter
+     * @brief Обмежена черга багатьох виробників і один фоновий споживач
+     */
+    class AsyncWriter {
+    private:
+        std::unique_ptr<Slot[]> slots;
+        alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+        alignas(64) size_t dequeuePosition = 0;
+        std::atomic<size_t> written{ 0 };
+        std::atomic<std::uint64_t> dropped{ 0 };
+
+        std::mutex wakeMutex;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        std::atomic<bool> sleeping{ false };
+        std::atomic<bool> stopping{ false };
+        std::thread worker;
+
+        // Одна спроба прочитати комірку; false - черга порожня
+        bool drainOne() {
+            Slot& slot = slots[dequeuePosition & (LOG_QUEUE_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+                return false;
+            }
+
+            const char* prefix = LEVEL_PREFIXES[static_cast<int>(slot.level)];
+            std::fwrite(prefix, 1, std::strlen(prefix), stderr);
+            std::fwrite(slot.text, 1, slot.length, stderr);
+            std::fputc('\n', stderr);
+
+            slot.sequence.store(dequeuePosition + LOG_QUEUE_CAPACITY, std::memory_order_release);
+            ++dequeuePosition;
+            return true;
+        }
+
+        void run() {
+            while (true) {
+                bool any = false;
+                while (drainOne()) {
+                    any = true;
+                }
+                if (any) {
+                    std::fflush(stderr);
+                }
+
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                written.store(dequeuePosition, std::memory_order_release);
+                drained.notify_all();
+                if (stopping.load(std::memory_order_acquire) &&
+                    enqueuePosition.load(std::memory_order_acquire) == dequeuePosition) {
+                    return;
+                }
+
+                // Виробники будять потік без м'ютекса, тож можлива втрачена побудка;
+                // тайм-аут обмежує затримку запису в такому разі
+                sleeping.store(true, std::memory_order_seq_cst);
+                wake.wait_for(lock, std::chrono::milliseconds(20));
+                sleeping.store(false, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        AsyncWriter() : slots(new Slot[LOG_QUEUE_CAPACITY]) {
+            for (size_t i = 0; i < LOG_QUEUE_CAPACITY; ++i) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            worker = std::thread([this]() { run(); });
+        }
+
+        ~AsyncWriter() {
+            stopping.store(true, std::memory_order_release);
+            wake.notify_one();
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+
+        void push(LogLevel level, const std::string& message) {
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot;
+            while (true) {
+                slot = &slots[position & (LOG_QUEUE_CAPACITY - 1)];
+                size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                }
+                else if (difference < 0) {
+                    // Буфер заповнений: відкидаємо, а не чекаємо на термінал
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            size_t length = message.size();
+            if (length > LOG_MESSAGE_MAX_BYTES) {
+                // Обрізаємо по межі символу UTF-8
+                length = LOG_MESSAGE_MAX_BYTES;
+                while (length > 0 && (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80) {
+                    --length;
+                }
+            }
+            std::memcpy(slot->text, message.data(), length);
+            slot->level = level;
+            slot->length = static_cast<std::uint16_t>(length);
+            slot->sequence.store(position + 1, std::memory_order_release);
+
+            if (sleeping.load(std::memory_order_seq_cst)) {
+                wake.notify_one();
+            }
+        }
+
+        void flush() {
+            size_t target = enqueuePosition.load(std::memory_order_acquire);
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+            drained.wait_for(lock, std::chrono::seconds(1), [this, target]() {
+                return written.load(std::memory_order_acquire) >= target;
+            });
+        }
+
+        std::uint64_t getDropped() const {
+            return dropped.load(std::memory_order_relaxed);
+        }
+    };
+
+    // Після знищення письменника (завершення процесу) повідомлення пишуться синхронно
+    std::atomic<bool> writerAlive{ false };
+
+    AsyncWriter& writer() {
+        static struct Holder {
+            AsyncWriter instance;
+            Holder() { writerAlive.store(true); }
+            ~Holder() { writerAlive.store(false); }
+        } holder;
+        return holder.instance;
+    }
+}
+
+bool LogSite::admit(std::uint32_t& dropped) {
+    std::int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    std::int64_t window = windowStart.load(std::memory_order_relaxed);
+    if (window != now && windowStart.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        admitted.store(0, std::memory_order_relaxed);
+        dropped = suppressed.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (admitted.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT_PER_SECOND) {
+        return true;
+    }
+
+    suppressed.fetch_add(1 + dropped, std::memory_order_relaxed);
+    dropped = 0;
+    return false;
+}
+
+// Власні методи
+
+bool Logger::isEnabled(LogLevel level) {
+    return static_cast<std::uint8_t>(level) >= currentLevel.load(std::memory_order_relaxed) &&
+        level != LogLevel::Off;
+}
+
+void Logger::setLevel(LogLevel level) {
+    currentLevel.store(static_cast<std::uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::getLevel() {
+    return static_cast<LogLevel>(currentLevel.load(std::memory_order_relaxed));
+}
+
+void Logger::write(LogLevel level, const std::string& message) {
+    if (level == LogLevel::Off) {
+        return;
+    }
+
+    AsyncWriter& instance = writer();
+    if (!writerAlive.load()) {
+        std::fprintf(stderr, "%s%s\n", LEVEL_PREFIXES[static_cast<int>(level)], message.c_str());
+        return;
+    }
+    instance.push(level, message);
+}
+
+void Logger::flush() {
+    if (writerAlive.load()) {
+        writer().flush();
+    }
+}
+
+std::uint64_t Logger::getDroppedCount() {
+    return writerAlive.load() ? writer().getDropped() : 0;
+}
@@ -0,0 +1,139 @@
+﻿#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <string>
+#include <sstream>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Мінімальний рівень, що компілюється (0 - Debug ... 3 - Error)
+ *
+ * Виклики нижчого рівня вилучаються компілятором разом з обчисленням
+ * аргументів, наприклад /DCOURSEWORK1_LOG_COMPILED_LEVEL=1 прибирає LOG_DEBUG.
+ */
+#ifndef COURSEWORK1_LOG_COMPILED_LEVEL
+#define COURSEWORK1_LOG_COMPILED_LEVEL 0
+#endif
+
+/**
+ * @enum LogLevel
+ * @brief Рівні повідомлень журналу
+ */
+enum class LogLevel {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    Off
+};
+
+/**
+ * @class LogSite
+ * @brief Обмежувач частоти для одного місця виклику
+ *
+ * Пропускає не більше LOG_RATE_LIMIT_PER_SECOND повідомлень за секунду,
+ * решту лише рахує; кількість відкинутих дописується до наступного
+ * повідомлення, яке пройде обмеження. Створюється статично в макросі LOG_*.
+ */
+class LogSite {
+private:
+    std::atomic<std::int64_t> windowStart;
+    std::atomic<std::uint32_t> admitted;
+    std::atomic<std::uint32_t> suppressed;
+
+public:
+    // Конструктори
+    constexpr LogSite() : windowStart(0), admitted(0), suppressed(0) {
+    }
+    LogSite(const LogSite& other) = delete;
+    LogSite(LogSite&& other) = delete;
+
+    // Оператори присвоєння
+    LogSite& operator=(const LogSite& other) = delete;
+    LogSite& operator=(LogSite&& other) = delete;
+
+    /**
+     * @brief Вирішує, чи записувати чергове повідомлення
+     * @param dropped Кількість пропущених з минулого вікна (0 якщо не було)
+     * @return true якщо повідомлення слід записати
+     */
+    bool admit(std::uint32_t& dropped);
+};
+
+/**
+ * @class Logger
+ * @brief Асинхронний журнал з кільцевим буфером і фоновим потоком запису
+ *
+ * Потоки-виробники лише копіюють текст у вільну комірку кільцевого буфера
+ * (без блокувань, через атомарні номери послідовності), а окремий потік
+ * пише повідомлення у stderr і скидає буфер, коли черга спорожніє. Якщо
+ * буфер заповнений, повідомлення відкидається і рахується - виробник
+ * ніколи не чекає на термінал.
+ *
+ * Рівень задається змінною середовища COURSEWORK1_LOG_LEVEL
+ * (debug, info, warning, error, off) або setLevel; типово - info.
+ */
+class Logger {
+public:
+    /**
+     * @brief Чи записуються повідомлення цього рівня
+     * @param level Рівень
+     * @return true якщо рівень не нижчий за поточний
+     */
+    static bool isEnabled(LogLevel level);
+
+    /**
+     * @brief Встановлює мінімальний рівень під час виконання
+     * @param level Рівень (Off вимикає журнал)
+     */
+    static void setLevel(LogLevel level);
+
+    /**
+     * @brief Поточний мінімальний рівень
+     */
+    static LogLevel getLevel();
+
+    /**
+     * @brief Ставить повідомлення в чергу (довші за LOG_MESSAGE_MAX_BYTES обрізаються)
+     * @param level Рівень
+     * @param message Текст UTF-8
+     */
+    static void write(LogLevel level, const std::string& message);
+
+    /**
+     * @brief Чекає, доки фоновий потік запише всі повідомлення з черги
+     *
+     * Викликається перед очікуванням введення, щоб діагностика з'являлася
+     * до наступного запрошення меню.
+     */
+    static void flush();
+
+    /**
+     * @brief Кількість повідомлень, відкинутих через переповнений буфер
+     */
+    static std::uint64_t getDroppedCount();
+};
+
+#define COURSEWORK1_LOG(level, expression)                                              \
+    do {                                                                                \
+        if constexpr (static_cast<int>(level) >= COURSEWORK1_LOG_COMPILED_LEVEL) {      \
+            static LogSite logSite;                                                     \
+            std::uint32_t logDropped = 0;                                               \
+            if (Logger::isEnabled(level) && logSite.admit(logDropped)) {                \
+                std::ostringstream logStream;                                           \
+                logStream << expression;                                                \
+                if (logDropped > 0) {                                                   \
+                    logStream << " (ще " << logDropped << " схожих пропущено)";         \
+                }                                                                       \
+                Logger::write(level, logStream.str());                                  \
+            }                                                                           \
+        }                                                                               \
+    } while (false)
+
+#define LOG_DEBUG(expression) COURSEWORK1_LOG(LogLevel::Debug, expression)
+#define LOG_INFO(expression) COURSEWORK1_LOG(LogLevel::Info, expression)
+#define LOG_WARNING(expression) COURSEWORK1_LOG(LogLevel::Warning, expression)
+#define LOG_ERROR(expression) COURSEWORK1_LOG(LogLevel::Error, expression)
+
+#endif // LOGGER_H
@@ -0,0 +1,178 @@
+﻿#include "Money.h"
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+// Конструктори
+Money::Money()
+    : kopecks(0) {
+}
+
+Money::Money(std::int64_t kopecks)
+    : kopecks(kopecks) {
+}
+
+Money Money::fromHryvnias(double amount) {
+    return Money(static_cast<std::int64_t>(std::llround(amount * 100.0)));
+}
+
+// Getters
+std::int64_t Money::getKopecks() const {
+    return kopecks;
+}
+
+double Money::toHryvnias() const {
+    return kopecks / 100.0;
+}
+
+// Арифметика
+Money Money::operator+(Money other) const {
+    return Money(kopecks + other.kopecks);
+}
+
+Money Money::operator-(Money other) const {
+    return Money(kopecks - other.kopecks);
+}
+
+Money Money::operator*(std::int64_t factor) const {
+    return Money(kopecks * factor);
+}
+
+Money& Money::operator+=(Money other) {
+    kopecks += other.kopecks;
+    return *this;
+}
+
+Money& Money::operator-=(Money other) {
+    kopecks -= other.kopecks;
+    return *this;
+}
+
+// Порівняння
+bool Money::operator==(Money other) const {
+    return kopecks == other.kopecks;
+}
+
+bool Money::operator!=(Money other) const {
+    return kopecks != other.kopecks;
+}
+
+bool Money::operator<(Money other) const {
+    return kopecks < other.kopecks;
+}
+
+bool Money::operator<=(Money other) const {
+    return kopecks <= other.kopecks;
+}
+
+bool Money::operator>(Money other) const {
+    return kopecks > other.kopecks;
+}
+
+bool Money::operator>=(Money other) const {
+    return kopecks >= other.kopecks;
+}
+
+// Власні методи
+
+Money Money::discounted(double discountPercent) const {
+    std::int64_t basisPoints = static_cast<std::int64_t>(std::llround(discountPercent * 100.0));
+    std::int64_t scaled = kopecks * basisPoints;
+
+    // Округлення половини від нуля
+    std::int64_t discount = (scaled + (scaled >= 0 ? 5000 : -5000)) / 10000;
+    return Money(kopecks - discount);
+}
+
+char* Money::toChars(char* first, char* last) const {
+    // Модуль беремо у беззнаковому типі, щоб не переповнити INT64_MIN
+    std::uint64_t magnitude = kopecks < 0
+        ? 0 - static_cast<std::uint64_t>(kopecks)
+        : static_cast<std::uint64_t>(kopecks);
+
+    if (kopecks < 0) {
+        if (first == last) {
+            return nullptr;
+        }
+        *first++ = '-';
+    }
+
+    std::to_chars_result whole = std::to_chars(first, last, magnitude / 100);
+    if (whole.ec != std::errc() || last - whole.ptr < 3) {
+        return nullptr;
+    }
+
+    char* out = whole.ptr;
+    unsigned fraction = static_cast<unsigned>(magnitude % 100);
+    *out++ = '.';
+    *out++ = static_cast<char>('0' + fraction / 10);
+    *out++ = static_cast<char>('0' + fraction % 10);
+    return out;
+}
+
+std::string Money::toString() const {
+    char buffer[MAX_TEXT_LENGTH];
+    char* end = toChars(buffer, buffer + sizeof(buffer));
+    return std::string(buffer, end);
+}
+
+bool Money::parse(const std::string& text, Money& result) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+
+    bool negative = first != last && *first == '-';
+    if (negative) {
+        ++first;
+    }
+
+    // Більші суми не вміщуються в копійках int64
+    const std::int64_t maxWhole = std::numeric_limits<std::int64_t>::max() / 100 - 1;
+
+    std::int64_t whole = 0;
+    std::from_chars_result parsed = std::from_chars(first, last, whole);
+    if (parsed.ec == std::errc() && whole >= 0) {
+        if (whole > maxWhole) {
+            return false;
+        }
+        const char* cursor = parsed.ptr;
+        std::int64_t fraction = 0;
+
+        if (cursor != last && (*cursor == '.' || *cursor == ',')) {
+            ++cursor;
+            int digits = 0;
+            while (cursor != last && *cursor >= '0' && *cursor <= '9' && digits < 2) {
+                fraction = fraction * 10 + (*cursor - '0');
+                ++cursor;
+                ++digits;
+            }
+            if (digits == 1) {
+                fraction *= 10;
+            }
+        }
+
+        if (cursor == last) {
+            std::int64_t value = whole * 100 + fraction;
+            result = Money(negative ? -value : value);
+            return true;
+        }
+    }
+
+    // Запасний шлях для старих файлів: більше двох знаків після коми або експонента.
+    // from_chars не залежить від локалі, на відміну від strtod
+    double amount = 0.0;
+    parsed = std::from_chars(text.data(), text.data() + text.size(), amount);
+    if (text.empty() || parsed.ec != std::errc() || parsed.ptr != text.data() + text.size() ||
+        !std::isfinite(amount) ||
+        std::fabs(amount) * 100.0 >= static_cast<double>(std::numeric_limits<std::int64_t>::max())) {
+        return false;
+    }
+
+    result = fromHryvnias(amount);
+    return true;
+}
+
+std::ostream& operator<<(std::ostream& out, Money money) {
+    char buffer[Money::MAX_TEXT_LENGTH];
+    char* end = money.toChars(buffer, buffer + sizeof(buffer));
+    return out.write(buffer, end - buffer);
+}
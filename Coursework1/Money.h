@@ -0,0 +1,98 @@
+﻿#ifndef MONEY_H
+#define MONEY_H
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+
+/**
+ * @class Money
+ * @brief Грошова сума з фіксованою комою (копійки у 64-бітному цілому)
+ *
+ * Додавання та множення на кількість ночей - точні цілочисельні операції,
+ * тому сума виручки не накопичує похибки double. Текстове представлення
+ * ("1234.56") формується та розбирається через to_chars/from_chars.
+ */
+class Money {
+private:
+    std::int64_t kopecks;
+
+public:
+    /**
+     * @brief Максимальна довжина текстового представлення (знак, 19 цифр, крапка)
+     */
+    static const std::size_t MAX_TEXT_LENGTH = 24;
+
+    // Конструктори
+    Money();
+    explicit Money(std::int64_t kopecks);
+
+    /**
+     * @brief Створює суму з гривень з округленням до копійки
+     * @param amount Сума в гривнях (наприклад, введена користувачем)
+     * @return Сума в копійках
+     */
+    static Money fromHryvnias(double amount);
+
+    // Getters
+    std::int64_t getKopecks() const;
+    double toHryvnias() const;
+
+    // Арифметика
+    Money operator+(Money other) const;
+    Money operator-(Money other) const;
+    Money operator*(std::int64_t factor) const;
+    Money& operator+=(Money other);
+    Money& operator-=(Money other);
+
+    // Порівняння
+    bool operator==(Money other) const;
+    bool operator!=(Money other) const;
+    bool operator<(Money other) const;
+    bool operator<=(Money other) const;
+    bool operator>(Money other) const;
+    bool operator>=(Money other) const;
+
+    /**
+     * @brief Обчислює суму зі знижкою
+     *
+     * Відсоток переводиться у базисні пункти (0.01%), а знижка округлюється
+     * до копійки цілочисельно, тому результат не залежить від платформи.
+     * @param discountPercent Відсоток знижки (0-100)
+     * @return Сума після знижки
+     */
+    Money discounted(double discountPercent) const;
+
+    /**
+     * @brief Записує суму у буфер у форматі "1234.56"
+     * @param first Початок буфера
+     * @param last Кінець буфера
+     * @return Вказівник за останнім записаним символом або nullptr, якщо буфер замалий
+     */
+    char* toChars(char* first, char* last) const;
+
+    /**
+     * @brief Отримує текстове представлення суми ("1234.56")
+     * @return Рядок із двома знаками після крапки
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Розбирає суму з тексту
+     *
+     * Приймає "1234", "1234.5", "1234.56" (також з комою). Старі файли, записані
+     * через iostream (наприклад, "1.5e+06"), розбираються як double з округленням
+     * незалежно від локалі. Суми, що не вміщуються в int64 копійок, відхиляються.
+     * @param text Текст суми
+     * @param result Розібрана сума
+     * @return true якщо успішно, false в іншому випадку
+     */
+    static bool parse(const std::string& text, Money& result);
+};
+
+/**
+ * @brief Виводить суму у форматі "1234.56"
+ */
+std::ostream& operator<<(std::ostream& out, Money money);
+
+#endif // MONEY_H
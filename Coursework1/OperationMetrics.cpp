@@ -0,0 +1,279 @@
+﻿#include "OperationMetrics.h"
+#include "Json.h"
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <exception>
+#include <cmath>
+
+namespace {
+    const char* const OPERATION_NAMES[] = {
+        "checkAvailability",
+        "createBooking",
+        "cancelBooking",
+        "getAllBookings",
+        "loadBookings",
+        "saveBookings",
+        "loadHotels",
+        "saveHotels",
+        "findHotelsByCity",
+        "findHotelsByType",
+        "findHotelsByStars",
+        "findAvailableRooms",
+        "findHotelsWithAmenities",
+        "suggestHotels",
+        "getFacetCounts",
+        "sortHotelsByPrice",
+        "sortHotelsByName"
+    };
+
+    const size_t OPERATION_COUNT = static_cast<size_t>(MetricOperation::Count);
+    static_assert(sizeof(OPERATION_NAMES) / sizeof(OPERATION_NAMES[0]) == OPERATION_COUNT,
+        "Кожна операція повинна мати назву");
+
+    /**
+     * @struct ThreadMetrics
+     * @brief Буфер метрик одного потоку
+     *
+     * Пише лише потік-власник (load + store без read-modify-write), а
+     * зведення читає ті самі атомарні змінні з інших потоків.
+     */
+    struct ThreadMetrics {
+        std::atomic<std::uint64_t> calls[OPERATION_COUNT];
+        std::atomic<std::uint64_t> errors[OPERATION_COUNT];
+        std::atomic<std::uint64_t> totalNs[OPERATION_COUNT];
+        std::atomic<std::uint64_t> maxNs[OPERATION_COUNT];
+        std::atomic<std::uint64_t> buckets[OPERATION_COUNT][OperationMetrics::BUCKET_COUNT];
+
+        ThreadMetrics() {
+            for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+                calls[i].store(0, std::memory_order_relaxed);
+                errors[i].store(0, std::memory_order_relaxed);
+                totalNs[i].store(0, std::memory_order_relaxed);
+                maxNs[i].store(0, std::memory_order_relaxed);
+                for (auto& bucket : buckets[i]) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    void increase(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    // Реєстр буферів; буфери не звільняються, щоб метрики завершених потоків
+    // залишалися у звітах, а thread_local вказівник ніколи не висів
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadMetrics>>& registry() {
+        static std::vector<std::unique_ptr<ThreadMetrics>> buffers;
+        return buffers;
+    }
+
+    ThreadMetrics& localMetrics() {
+        thread_local ThreadMetrics* local = nullptr;
+        if (!local) {
+            std::unique_ptr<ThreadMetrics> buffer(new ThreadMetrics());
+            local = buffer.get();
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry().push_back(std::move(buffer));
+        }
+        return *local;
+    }
+
+    std::uint64_t percentile(const std::vector<std::uint64_t>& buckets, std::uint64_t total, double quantile) {
+        std::uint64_t target = static_cast<std::uint64_t>(std::ceil(quantile * total));
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= target && seen > 0) {
+                return OperationMetrics::bucketValue(static_cast<int>(i));
+            }
+        }
+        return 0;
+    }
+
+    double microseconds(std::uint64_t nanoseconds) {
+        return nanoseconds / 1e3;
+    }
+}
+
+// Власні методи
+
+void OperationMetrics::record(MetricOperation operation, std::uint64_t nanoseconds, bool failed) {
+    size_t index = static_cast<size_t>(operation);
+    ThreadMetrics& metrics = localMetrics();
+
+    increase(metrics.calls[index], 1);
+    if (failed) {
+        increase(metrics.errors[index], 1);
+    }
+    increase(metrics.totalNs[index], nanoseconds);
+    if (nanoseconds > metrics.maxNs[index].load(std::memory_order_relaxed)) {
+        metrics.maxNs[index].store(nanoseconds, std::memory_order_relaxed);
+    }
+    increase(metrics.buckets[index][bucketIndex(nanoseconds)], 1);
+}
+
+std::vector<OperationStats> OperationMetrics::snapshot() {
+    std::vector<OperationStats> result;
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    std::vector<std::uint64_t> buckets(BUCKET_COUNT);
+    for (size_t operation = 0; operation < OPERATION_COUNT; ++operation) {
+        OperationStats stats;
+        stats.name = OPERATION_NAMES[operation];
+        std::fill(buckets.begin(), buckets.end(), 0);
+
+        for (const auto& metrics : registry()) {
+            stats.calls += metrics->calls[operation].load(std::memory_order_relaxed);
+            stats.errors += metrics->errors[operation].load(std::memory_order_relaxed);
+            stats.totalNs += metrics->totalNs[operation].load(std::memory_order_relaxed);
+            stats.maxNs = std::max(stats.maxNs, metrics->maxNs[operation].load(std::memory_order_relaxed));
+            for (int i = 0; i < BUCKET_COUNT; ++i) {
+                buckets[i] += metrics->buckets[operation][i].load(std::memory_order_relaxed);
+            }
+        }
+
+        if (stats.calls == 0) {
+            continue;
+        }
+
+        // Лічильники читаються не атомарно як ціле, тож беремо суму кошиків
+        std::uint64_t recorded = 0;
+        for (std::uint64_t count : buckets) {
+            recorded += count;
+        }
+        // Середина кошика може перевищити фактичний максимум
+        stats.p50Ns = std::min(percentile(buckets, recorded, 0.50), stats.maxNs);
+        stats.p99Ns = std::min(percentile(buckets, recorded, 0.99), stats.maxNs);
+        stats.p999Ns = std::min(percentile(buckets, recorded, 0.999), stats.maxNs);
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+void OperationMetrics::printReport(std::ostream& out) {
+    std::vector<OperationStats> stats = snapshot();
+    if (stats.empty()) {
+        out << "Операції ще не викликалися." << std::endl;
+        return;
+    }
+
+    // setw рахує байти, тож кириличний заголовок вирівняно вручну
+    out << "Операція                     Виклики  Помилки   Середнє       p50       p99      p999      Макс" << std::endl;
+    out << "                                                  (мкс)" << std::endl;
+
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    for (const OperationStats& item : stats) {
+        out << std::left << std::setw(26) << item.name << std::right
+            << std::setw(10) << item.calls << std::setw(9) << item.errors
+            << std::setw(10) << microseconds(item.totalNs / item.calls)
+            << std::setw(10) << microseconds(item.p50Ns)
+            << std::setw(10) << microseconds(item.p99Ns)
+            << std::setw(10) << microseconds(item.p999Ns)
+            << std::setw(10) << microseconds(item.maxNs) << std::endl;
+    }
+    out.flags(flags);
+}
+
+bool OperationMetrics::writeReport(const std::string& filename) {
+    try {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Помилка: не вдалося створити файл " << filename << std::endl;
+            return false;
+        }
+
+        std::vector<OperationStats> stats = snapshot();
+        file << "{\"operations\":[";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            const OperationStats& item = stats[i];
+            file << (i > 0 ? ",\n" : "\n") << "{\"name\":" << Json::quote(item.name)
+                << ",\"calls\":" << item.calls << ",\"errors\":" << item.errors
+                << ",\"totalNs\":" << item.totalNs << ",\"avgNs\":" << item.totalNs / item.calls
+                << ",\"p50Ns\":" << item.p50Ns << ",\"p99Ns\":" << item.p99Ns
+                << ",\"p999Ns\":" << item.p999Ns << ",\"maxNs\":" << item.maxNs << "}";
+        }
+        file << "\n]}" << std::endl;
+
+        return static_cast<bool>(file);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Помилка запису метрик: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+const char* OperationMetrics::name(MetricOperation operation) {
+    size_t index = static_cast<size_t>(operation);
+    return index < OPERATION_COUNT ? OPERATION_NAMES[index] : "unknown";
+}
+
+int OperationMetrics::bucketIndex(std::uint64_t nanoseconds) {
+    const std::uint64_t subBucketCount = 1ull << SUB_BUCKET_BITS;
+    if (nanoseconds < subBucketCount) {
+        return static_cast<int>(nanoseconds);
+    }
+    if (nanoseconds >> (MAX_MAGNITUDE + 1)) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // Номер старшого біта двійковим пошуком (без інтринсиків компілятора)
+    int magnitude = 0;
+    std::uint64_t value = nanoseconds;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if (value >> shift) {
+            value >>= shift;
+            magnitude += shift;
+        }
+    }
+
+    int subBucket = static_cast<int>((nanoseconds >> (magnitude - SUB_BUCKET_BITS)) - subBucketCount);
+    return ((magnitude - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + subBucket;
+}
+
+std::uint64_t OperationMetrics::bucketValue(int index) {
+    const int subBucketCount = 1 << SUB_BUCKET_BITS;
+    if (index < subBucketCount) {
+        return static_cast<std::uint64_t>(index);
+    }
+
+    int magnitude = (index >> SUB_BUCKET_BITS) + SUB_BUCKET_BITS - 1;
+    std::uint64_t subBucket = static_cast<std::uint64_t>(index & (subBucketCount - 1));
+    std::uint64_t width = 1ull << (magnitude - SUB_BUCKET_BITS);
+    return ((subBucketCount + subBucket) << (magnitude - SUB_BUCKET_BITS)) + width / 2;
+}
+
+// Конструктор з параметрами
+OperationTimer::OperationTimer(MetricOperation operation)
+    : operation(operation), start(std::chrono::steady_clock::now()),
+    exceptionsAtStart(std::uncaught_exceptions()), failed(false) {
+}
+
+// Деструктор
+OperationTimer::~OperationTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    bool unwinding = std::uncaught_exceptions() > exceptionsAtStart;
+    try {
+        OperationMetrics::record(operation,
+            static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            failed || unwinding);
+    }
+    catch (const std::exception&) {
+        // Буфер потоку не вдалося виділити - вимір втрачається, операція ні
+    }
+}
+
+// Власні методи
+
+bool OperationTimer::result(bool success) {
+    failed = !success;
+    return success;
+}
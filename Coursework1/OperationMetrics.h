@@ -0,0 +1,152 @@
+﻿#ifndef OPERATIONMETRICS_H
+#define OPERATIONMETRICS_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @enum MetricOperation
+ * @brief Інструментовані операції (значення - індекс у таблицях метрик)
+ */
+enum class MetricOperation : std::uint8_t {
+    CheckAvailability,
+    CreateBooking,
+    CancelBooking,
+    GetAllBookings,
+    LoadBookings,
+    SaveBookings,
+    LoadHotels,
+    SaveHotels,
+    FindHotelsByCity,
+    FindHotelsByType,
+    FindHotelsByStars,
+    FindAvailableRooms,
+    FindHotelsWithAmenities,
+    SuggestHotels,
+    GetFacetCounts,
+    SortHotelsByPrice,
+    SortHotelsByName,
+    Count
+};
+
+/**
+ * @struct OperationStats
+ * @brief Зведені метрики однієї операції з усіх потоків
+ */
+struct OperationStats {
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t maxNs = 0;
+    std::uint64_t p50Ns = 0;
+    std::uint64_t p99Ns = 0;
+    std::uint64_t p999Ns = 0;
+};
+
+/**
+ * @class OperationMetrics
+ * @brief Лічильники викликів, помилок та гістограми затримок операцій
+ *
+ * Кожен потік пише у власний буфер (виділяється при першому записі і
+ * живе до кінця процесу), тому запис - це кілька відносних атомарних
+ * операцій без блокувань і без спільних кеш-ліній. Зведення проходить
+ * по всіх буферах під м'ютексом реєстру.
+ *
+ * Гістограма лог-лінійна, як у HdrHistogram: кожен інтервал [2^k, 2^(k+1))
+ * ділиться на 32 рівні частини, тож похибка перцентиля не перевищує ~3%.
+ */
+class OperationMetrics {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int MAX_MAGNITUDE = 40;    // 2^40 нс ~ 18 хвилин, довші значення обрізаються
+    static const int BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) << SUB_BUCKET_BITS;
+
+    /**
+     * @brief Записує один виклик операції
+     * @param operation Операція
+     * @param nanoseconds Тривалість виклику
+     * @param failed true якщо виклик завершився помилкою
+     */
+    static void record(MetricOperation operation, std::uint64_t nanoseconds, bool failed);
+
+    /**
+     * @brief Зводить метрики всіх потоків
+     * @return Метрики операцій, які викликалися хоча б раз
+     */
+    static std::vector<OperationStats> snapshot();
+
+    /**
+     * @brief Виводить таблицю метрик
+     * @param out Потік виведення
+     */
+    static void printReport(std::ostream& out);
+
+    /**
+     * @brief Записує метрики у файл у форматі JSON
+     * @param filename Шлях до файлу
+     * @return true якщо успішно, false в іншому випадку
+     */
+    static bool writeReport(const std::string& filename);
+
+    /**
+     * @brief Назва операції для звітів
+     * @param operation Операція
+     * @return Назва методу
+     */
+    static const char* name(MetricOperation operation);
+
+    /**
+     * @brief Індекс кошика гістограми для значення
+     * @param nanoseconds Тривалість
+     * @return Індекс від 0 до BUCKET_COUNT - 1
+     */
+    static int bucketIndex(std::uint64_t nanoseconds);
+
+    /**
+     * @brief Представницьке значення кошика (середина його інтервалу)
+     * @param index Індекс кошика
+     * @return Тривалість у наносекундах
+     */
+    static std::uint64_t bucketValue(int index);
+};
+
+/**
+ * @class OperationTimer
+ * @brief Вимірює тривалість області видимості і записує її в OperationMetrics
+ *
+ * Виклик вважається помилковим, якщо його позначено через result(false)
+ * або якщо область залишається через виняток.
+ */
+class OperationTimer {
+private:
+    MetricOperation operation;
+    std::chrono::steady_clock::time_point start;
+    int exceptionsAtStart;
+    bool failed;
+
+public:
+    // Конструктори
+    explicit OperationTimer(MetricOperation operation);
+    OperationTimer(const OperationTimer& other) = delete;
+    OperationTimer(OperationTimer&& other) = delete;
+
+    // Деструктор
+    ~OperationTimer();
+
+    // Оператори присвоєння
+    OperationTimer& operator=(const OperationTimer& other) = delete;
+    OperationTimer& operator=(OperationTimer&& other) = delete;
+
+    /**
+     * @brief Позначає результат виклику
+     * @param success false - виклик рахується як помилка
+     * @return success без змін, щоб писати return timer.result(...)
+     */
+    bool result(bool success);
+};
+
+#endif // OPERATIONMETRICS_H
@@ -0,0 +1,299 @@
+﻿#include "PasswordHasher.h"
+#include "Constants.hpp"
+#include <random>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    const std::uint32_t SHA256_K[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+
+    const size_t SHA256_BLOCK = 64;
+    const size_t SHA256_DIGEST = 32;
+
+    std::uint32_t rotr(std::uint32_t x, int n) {
+        return (x >> n) | (x << (32 - n));
+    }
+
+    // Потоковий SHA-256 (FIPS 180-4)
+    struct Sha256 {
+        std::uint32_t state[8];
+        std::uint8_t buffer[SHA256_BLOCK];
+        size_t buffered;
+        std::uint64_t totalBytes;
+
+        Sha256()
+            : state{ 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 },
+            buffer{}, buffered(0), totalBytes(0) {
+        }
+
+        void compress(const std::uint8_t* block) {
+            std::uint32_t w[64];
+            for (int i = 0; i < 16; ++i) {
+                w[i] = (std::uint32_t(block[i * 4]) << 24) | (std::uint32_t(block[i * 4 + 1]) << 16) |
+                    (std::uint32_t(block[i * 4 + 2]) << 8) | std::uint32_t(block[i * 4 + 3]);
+            }
+            for (int i = 16; i < 64; ++i) {
+                std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+            std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+            for (int i = 0; i < 64; ++i) {
+                std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+                std::uint32_t ch = (e & f) ^ (~e & g);
+                std::uint32_t t1 = h + s1 + ch + SHA256_K[i] + w[i];
+                std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+                std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+                std::uint32_t t2 = s0 + maj;
+
+                h = g;
+                g = f;
+                f = e;
+                e = d + t1;
+                d = c;
+                c = b;
+                b = a;
+                a = t1 + t2;
+            }
+
+            state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+            state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        }
+
+        void update(const std::uint8_t* data, size_t length) {
+            totalBytes += length;
+            while (length > 0) {
+                size_t take = std::min(length, SHA256_BLOCK - buffered);
+                std::memcpy(buffer + buffered, data, take);
+                buffered += take;
+                data += take;
+                length -= take;
+
+                if (buffered == SHA256_BLOCK) {
+                    compress(buffer);
+                    buffered = 0;
+                }
+            }
+        }
+
+        void finish(std::uint8_t* digest) {
+            std::uint64_t bitLength = totalBytes * 8;
+            std::uint8_t pad = 0x80;
+            update(&pad, 1);
+
+            std::uint8_t zero = 0;
+            while (buffered != SHA256_BLOCK - 8) {
+                update(&zero, 1);
+            }
+
+            std::uint8_t lengthBytes[8];
+            for (int i = 0; i < 8; ++i) {
+                lengthBytes[i] = static_cast<std::uint8_t>(bitLength >> (56 - i * 8));
+            }
+            update(lengthBytes, 8);
+
+            for (int i = 0; i < 8; ++i) {
+                digest[i * 4] = static_cast<std::uint8_t>(state[i] >> 24);
+                digest[i * 4 + 1] = static_cast<std::uint8_t>(state[i] >> 16);
+                digest[i * 4 + 2] = static_cast<std::uint8_t>(state[i] >> 8);
+                digest[i * 4 + 3] = static_cast<std::uint8_t>(state[i]);
+            }
+        }
+    };
+
+    // HMAC-SHA256 з попередньо обчисленими станами ipad/opad ключа
+    struct HmacSha256 {
+        Sha256 inner;
+        Sha256 outer;
+
+        explicit HmacSha256(const std::string& key) {
+            std::uint8_t block[SHA256_BLOCK] = {};
+            if (key.size() > SHA256_BLOCK) {
+                Sha256 keyHash;
+                keyHash.update(reinterpret_cast<const std::uint8_t*>(key.data()), key.size());
+                keyHash.finish(block);
+            }
+            else {
+                std::memcpy(block, key.data(), key.size());
+            }
+
+            std::uint8_t pad[SHA256_BLOCK];
+            for (size_t i = 0; i < SHA256_BLOCK; ++i) pad[i] = block[i] ^ 0x36;
+            inner.update(pad, SHA256_BLOCK);
+            for (size_t i = 0; i < SHA256_BLOCK; ++i) pad[i] = block[i] ^ 0x5c;
+            outer.update(pad, SHA256_BLOCK);
+        }
+
+        void compute(const std::uint8_t* data, size_t length, std::uint8_t* mac) const {
+            Sha256 in = inner;
+            in.update(data, length);
+            std::uint8_t innerDigest[SHA256_DIGEST];
+            in.finish(innerDigest);
+
+            Sha256 out = outer;
+            out.update(innerDigest, SHA256_DIGEST);
+            out.finish(mac);
+        }
+    };
+
+    // PBKDF2 з одним блоком виходу (32 байти)
+    std::vector<std::uint8_t> pbkdf2(const std::string& password,
+        const std::vector<std::uint8_t>& salt, int iterations) {
+        HmacSha256 hmac(password);
+
+        std::vector<std::uint8_t> first(salt);
+        first.push_back(0);
+        first.push_back(0);
+        first.push_back(0);
+        first.push_back(1);
+
+        std::uint8_t u[SHA256_DIGEST];
+        hmac.compute(first.data(), first.size(), u);
+
+        std::vector<std::uint8_t> result(u, u + SHA256_DIGEST);
+        for (int i = 1; i < iterations; ++i) {
+            hmac.compute(u, SHA256_DIGEST, u);
+            for (size_t j = 0; j < SHA256_DIGEST; ++j) {
+                result[j] ^= u[j];
+            }
+        }
+        return result;
+    }
+
+    bool fromHex(const std::string& text, std::vector<std::uint8_t>& bytes) {
+        if (text.size() % 2 != 0) {
+            return false;
+        }
+
+        bytes.clear();
+        for (size_t i = 0; i < text.size(); i += 2) {
+            int value = 0;
+            for (size_t j = i; j < i + 2; ++j) {
+                char ch = text[j];
+                int digit;
+                if (ch >= '0' && ch <= '9') digit = ch - '0';
+                else if (ch >= 'a' && ch <= 'f') digit = ch - 'a' + 10;
+                else if (ch >= 'A' && ch <= 'F') digit = ch - 'A' + 10;
+                else return false;
+                value = value * 16 + digit;
+            }
+            bytes.push_back(static_cast<std::uint8_t>(value));
+        }
+        return true;
+    }
+
+    // Розбирає запис "схема$ітерації$сіль$ключ"
+    bool parseRecord(const std::string& record, int& iterations,
+        std::vector<std::uint8_t>& salt, std::string& keyHex) {
+        size_t first = record.find('$');
+        size_t second = record.find('$', first + 1);
+        size_t third = record.find('$', second + 1);
+
+        if (first == std::string::npos || second == std::string::npos || third == std::string::npos) {
+            return false;
+        }
+        if (record.compare(0, first, PASSWORD_HASH_SCHEME) != 0) {
+            return false;
+        }
+
+        try {
+            iterations = std::stoi(record.substr(first + 1, second - first - 1));
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+
+        keyHex = record.substr(third + 1);
+        return iterations > 0 && fromHex(record.substr(second + 1, third - second - 1), salt);
+    }
+}
+
+std::vector<std::uint8_t> PasswordHasher::sha256(const std::string& data) {
+    Sha256 context;
+    context.update(reinterpret_cast<const std::uint8_t*>(data.data()), data.size());
+
+    std::vector<std::uint8_t> digest(SHA256_DIGEST);
+    context.finish(digest.data());
+    return digest;
+}
+
+std::vector<std::uint8_t> PasswordHasher::randomBytes(size_t count) {
+    std::random_device device;
+    std::vector<std::uint8_t> bytes(count);
+
+    for (size_t i = 0; i < count; i += 4) {
+        std::uint32_t value = device();
+        for (size_t j = i; j < count && j < i + 4; ++j) {
+            bytes[j] = static_cast<std::uint8_t>(value);
+            value >>= 8;
+        }
+    }
+    return bytes;
+}
+
+std::string PasswordHasher::toHex(const std::vector<std::uint8_t>& bytes) {
+    static const char DIGITS[] = "0123456789abcdef";
+
+    std::string result;
+    result.reserve(bytes.size() * 2);
+    for (std::uint8_t byte : bytes) {
+        result += DIGITS[byte >> 4];
+        result += DIGITS[byte & 0x0F];
+    }
+    return result;
+}
+
+std::string PasswordHasher::hash(const std::string& password) {
+    std::vector<std::uint8_t> salt = randomBytes(PASSWORD_SALT_BYTES);
+    std::vector<std::uint8_t> key = pbkdf2(password, salt, PASSWORD_HASH_ITERATIONS);
+
+    return PASSWORD_HASH_SCHEME + "$" + std::to_string(PASSWORD_HASH_ITERATIONS) + "$" +
+        toHex(salt) + "$" + toHex(key);
+}
+
+bool PasswordHasher::verify(const std::string& password, const std::string& record) {
+    int iterations = 0;
+    std::vector<std::uint8_t> salt;
+    std::string keyHex;
+
+    if (!parseRecord(record, iterations, salt, keyHex)) {
+        // Старий запис у відкритому вигляді
+        return constantTimeEquals(password, record);
+    }
+
+    return constantTimeEquals(toHex(pbkdf2(password, salt, iterations)), keyHex);
+}
+
+bool PasswordHasher::needsRehash(const std::string& record) {
+    int iterations = 0;
+    std::vector<std::uint8_t> salt;
+    std::string keyHex;
+
+    return !parseRecord(record, iterations, salt, keyHex) || iterations < PASSWORD_HASH_ITERATIONS;
+}
+
+bool PasswordHasher::constantTimeEquals(const std::string& a, const std::string& b) {
+    // Довжина не є секретом: для хешів вона фіксована
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    unsigned char difference = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        difference |= static_cast<unsigned char>(a[i] ^ b[i]);
+    }
+    return difference == 0;
+}
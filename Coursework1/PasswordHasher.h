@@ -0,0 +1,68 @@
+﻿#ifndef PASSWORDHASHER_H
+#define PASSWORDHASHER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * @class PasswordHasher
+ * @brief Солоне, навмисно повільне хешування паролів (PBKDF2-HMAC-SHA256)
+ *
+ * Запис пароля має вигляд "pbkdf2-sha256$<ітерації>$<сіль hex>$<ключ hex>"
+ * і не містить символу ':', тому зберігається у файлі користувачів як є.
+ * Записи без префікса схеми вважаються старими (відкритий текст).
+ */
+class PasswordHasher {
+public:
+    /**
+     * @brief Обчислює SHA-256
+     * @param data Вхідні дані
+     * @return 32 байти дайджесту
+     */
+    static std::vector<std::uint8_t> sha256(const std::string& data);
+
+    /**
+     * @brief Генерує криптографічно випадкові байти
+     * @param count Кількість байтів
+     * @return Випадкові байти
+     */
+    static std::vector<std::uint8_t> randomBytes(size_t count);
+
+    /**
+     * @brief Переводить байти у шістнадцятковий рядок
+     * @param bytes Байти
+     * @return Рядок з малих шістнадцяткових цифр
+     */
+    static std::string toHex(const std::vector<std::uint8_t>& bytes);
+
+    /**
+     * @brief Хешує пароль з новою випадковою сіллю
+     * @param password Пароль у відкритому вигляді
+     * @return Запис пароля для збереження
+     */
+    static std::string hash(const std::string& password);
+
+    /**
+     * @brief Перевіряє пароль за записом (порівняння за сталий час)
+     * @param password Введений пароль
+     * @param record Збережений запис (хеш або старий відкритий текст)
+     * @return true якщо пароль правильний, false в іншому випадку
+     */
+    static bool verify(const std::string& password, const std::string& record);
+
+    /**
+     * @brief Перевіряє чи потрібно перехешувати запис
+     * @param record Збережений запис
+     * @return true для відкритого тексту або меншої кількості ітерацій
+     */
+    static bool needsRehash(const std::string& record);
+
+    /**
+     * @brief Порівнює рядки за час, що не залежить від першої відмінності
+     * @return true якщо рядки однакові
+     */
+    static bool constantTimeEquals(const std::string& a, const std::string& b);
+};
+
+#endif // PASSWORDHASHER_H
@@ -0,0 +1,190 @@
+﻿#include "PrefixIndex.h"
+#include <algorithm>
+
+namespace {
+    // Декодує один символ UTF-8; при помилці повертає байт як є
+    std::uint32_t decodeUtf8(const std::string& text, size_t& pos) {
+        unsigned char lead = static_cast<unsigned char>(text[pos]);
+        int extra = 0;
+        std::uint32_t code = lead;
+
+        if (lead >= 0xF0) { extra = 3; code = lead & 0x07; }
+        else if (lead >= 0xE0) { extra = 2; code = lead & 0x0F; }
+        else if (lead >= 0xC0) { extra = 1; code = lead & 0x1F; }
+
+        if (extra > 0 && pos + extra >= text.size()) {
+            pos++;
+            return lead;
+        }
+
+        for (int i = 1; i <= extra; ++i) {
+            code = (code << 6) | (static_cast<unsigned char>(text[pos + i]) & 0x3F);
+        }
+        pos += extra + 1;
+        return code;
+    }
+
+    void encodeUtf8(std::uint32_t code, std::string& out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        }
+        else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    std::uint32_t lowerCodePoint(std::uint32_t code) {
+        if (code >= 'A' && code <= 'Z') return code + 0x20;
+        if (code >= 0x0410 && code <= 0x042F) return code + 0x20;  // А-Я
+        if (code >= 0x0400 && code <= 0x040F) return code + 0x50;  // Ѐ-Џ (Є, І, Ї)
+        if (code == 0x0490) return 0x0491;                         // Ґ
+        return code;
+    }
+
+    bool startsWith(const std::string& key, const std::string& prefix) {
+        return key.size() >= prefix.size() && key.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+// Конструктор за замовчуванням
+PrefixIndex::PrefixIndex() {
+}
+
+// Деструктор
+PrefixIndex::~PrefixIndex() {
+}
+
+std::string PrefixIndex::foldCase(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        encodeUtf8(lowerCodePoint(decodeUtf8(text, pos)), result);
+    }
+
+    return result;
+}
+
+// Допоміжні методи
+
+void PrefixIndex::collectKeys(const HotelBase& hotel, std::vector<Entry>& out) const {
+    std::string name = foldCase(hotel.getName());
+
+    // Назва індексується з початку кожного слова, щоб "pal" знаходив "Lviv Palace"
+    for (size_t pos = 0; pos < name.size(); ++pos) {
+        if (pos == 0 || name[pos - 1] == ' ') {
+            if (name[pos] != ' ') {
+                out.push_back(Entry{ name.substr(pos), hotel.getHotelId() });
+            }
+        }
+    }
+
+    std::string city = foldCase(hotel.getCity());
+    if (!city.empty()) {
+        out.push_back(Entry{ city, hotel.getHotelId() });
+    }
+}
+
+void PrefixIndex::eraseEntries(int hotelId) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+        [hotelId](const Entry& entry) { return entry.hotelId == hotelId; }),
+        entries.end());
+}
+
+void PrefixIndex::insertEntries(const HotelBase& hotel) {
+    std::vector<Entry> keys;
+    collectKeys(hotel, keys);
+
+    for (auto& entry : keys) {
+        auto it = std::upper_bound(entries.begin(), entries.end(), entry.key,
+            [](const std::string& key, const Entry& e) { return key < e.key; });
+        entries.insert(it, std::move(entry));
+    }
+}
+
+// Власні методи
+
+void PrefixIndex::clear() {
+    entries.clear();
+    tracked.clear();
+}
+
+void PrefixIndex::removeHotel(int hotelId) {
+    if (tracked.erase(hotelId) > 0) {
+        eraseEntries(hotelId);
+    }
+}
+
+void PrefixIndex::sync(const std::vector<std::shared_ptr<HotelBase>>& hotels) {
+    std::vector<std::shared_ptr<HotelBase>> changed;
+
+    for (const auto& hotel : hotels) {
+        auto it = tracked.find(hotel->getHotelId());
+        if (it == tracked.end() || it->second.hotel != hotel ||
+            it->second.revision != hotel->getRevision()) {
+            changed.push_back(hotel);
+        }
+    }
+
+    if (changed.empty()) {
+        return;
+    }
+
+    // Багато змін (напр. після завантаження) дешевше перебудувати одним сортуванням
+    if (changed.size() > 64 || changed.size() * 4 > hotels.size()) {
+        clear();
+        for (const auto& hotel : hotels) {
+            collectKeys(*hotel, entries);
+            tracked[hotel->getHotelId()] = Tracked{ hotel, hotel->getRevision() };
+        }
+        std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.key < b.key; });
+        return;
+    }
+
+    for (const auto& hotel : changed) {
+        eraseEntries(hotel->getHotelId());
+        insertEntries(*hotel);
+        tracked[hotel->getHotelId()] = Tracked{ hotel, hotel->getRevision() };
+    }
+}
+
+std::vector<std::shared_ptr<HotelBase>> PrefixIndex::find(const std::string& prefix, size_t limit) const {
+    std::vector<std::shared_ptr<HotelBase>> result;
+    std::string folded = foldCase(prefix);
+
+    if (folded.empty() || limit == 0) {
+        return result;
+    }
+
+    auto it = std::lower_bound(entries.begin(), entries.end(), folded,
+        [](const Entry& e, const std::string& key) { return e.key < key; });
+
+    std::vector<int> seen;
+    for (; it != entries.end() && startsWith(it->key, folded); ++it) {
+        if (std::find(seen.begin(), seen.end(), it->hotelId) != seen.end()) continue;
+
+        auto hotel = tracked.find(it->hotelId);
+        if (hotel == tracked.end()) continue;
+
+        seen.push_back(it->hotelId);
+        result.push_back(hotel->second.hotel);
+
+        if (result.size() >= limit) break;
+    }
+
+    return result;
+}
@@ -0,0 +1,86 @@
+﻿#ifndef PREFIXINDEX_H
+#define PREFIXINDEX_H
+
+#include "HotelBase.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @class PrefixIndex
+ * @brief Індекс автодоповнення за назвами та містами готелів
+ *
+ * Ключі (назва, кожне слово назви до кінця рядка, місто) зберігаються
+ * у відсортованому масиві після UTF-8 зведення регістру (латиниця та кирилиця),
+ * тому пошук за префіксом - це бінарний пошук і короткий прохід по діапазону.
+ */
+class PrefixIndex {
+private:
+    /**
+     * @struct Entry
+     * @brief Запис індексу
+     */
+    struct Entry {
+        std::string key;
+        int hotelId;
+    };
+
+    /**
+     * @struct Tracked
+     * @brief Готель, відомий індексу, та його ревізія на момент індексації
+     */
+    struct Tracked {
+        std::shared_ptr<HotelBase> hotel;
+        std::uint64_t revision;
+    };
+
+    std::vector<Entry> entries;
+    std::unordered_map<int, Tracked> tracked;
+
+    void collectKeys(const HotelBase& hotel, std::vector<Entry>& out) const;
+    void eraseEntries(int hotelId);
+    void insertEntries(const HotelBase& hotel);
+
+public:
+    // Конструктори
+    PrefixIndex();
+
+    // Деструктор
+    ~PrefixIndex();
+
+    /**
+     * @brief Зводить UTF-8 рядок до нижнього регістру (ASCII та кирилиця)
+     * @param text Вхідний рядок
+     * @return Рядок у нижньому регістрі
+     */
+    static std::string foldCase(const std::string& text);
+
+    /**
+     * @brief Очищає індекс
+     */
+    void clear();
+
+    /**
+     * @brief Видаляє готель з індексу
+     * @param hotelId ID готелю
+     */
+    void removeHotel(int hotelId);
+
+    /**
+     * @brief Синхронізує індекс з каталогом (нові та змінені готелі)
+     * @param hotels Готелі каталогу
+     */
+    void sync(const std::vector<std::shared_ptr<HotelBase>>& hotels);
+
+    /**
+     * @brief Знаходить готелі, назва, слово назви або місто яких починається з префікса
+     * @param prefix Префікс (без урахування регістру)
+     * @param limit Максимальна кількість результатів
+     * @return Готелі у порядку ключів
+     */
+    std::vector<std::shared_ptr<HotelBase>> find(const std::string& prefix, size_t limit) const;
+};
+
+#endif // PREFIXINDEX_H
@@ -1,47 +1,40 @@
 ﻿#include "PremiumHotel.h"
 #include "Constants.hpp"
+#include "Logger.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 
 // Конструктор за замовчуванням
 PremiumHotel::PremiumHotel()
-    : HotelBase(), stars(4), hasPool(false), hasSpa(false), hasRestaurant(false) {
+    : HotelBase(HotelType::Premium, 4) {
 }
 
 // Конструктор з параметрами
 PremiumHotel::PremiumHotel(int id, const std::string& name, const std::string& city,
     const std::string& description, int stars)
-    : HotelBase(id, name, city, description), stars(stars),
-    hasPool(false), hasSpa(false), hasRestaurant(false) {
+    : HotelBase(HotelType::Premium, id, name, city, description, stars) {
 }
 
 // Копіювальний конструктор
 PremiumHotel::PremiumHotel(const PremiumHotel& other)
-    : HotelBase(other), stars(other.stars), services(other.services),
-    hasPool(other.hasPool), hasSpa(other.hasSpa), hasRestaurant(other.hasRestaurant) {
+    : HotelBase(other) {
 }
 
 // Переміщувальний конструктор
 PremiumHotel::PremiumHotel(PremiumHotel&& other) noexcept
-    : HotelBase(std::move(other)), stars(other.stars), services(std::move(other.services)),
-    hasPool(other.hasPool), hasSpa(other.hasSpa), hasRestaurant(other.hasRestaurant) {
+    : HotelBase(std::move(other)) {
 }
 
 // Деструктор
 PremiumHotel::~PremiumHotel() {
-    std::cout << "Об'єкт PremiumHotel '" << getName() << "' знищено." << std::endl;
+    LOG_DEBUG("Об'єкт PremiumHotel '" << getName() << "' знищено.");
 }
 
 // Оператор копіювального присвоєння
 PremiumHotel& PremiumHotel::operator=(const PremiumHotel& other) {
     if (this != &other) {
         HotelBase::operator=(other);
-        stars = other.stars;
-        services = other.services;
-        hasPool = other.hasPool;
-        hasSpa = other.hasSpa;
-        hasRestaurant = other.hasRestaurant;
     }
     return *this;
 }
@@ -50,63 +43,53 @@ PremiumHotel& PremiumHotel::operator=(const PremiumHotel& other) {
 PremiumHotel& PremiumHotel::operator=(PremiumHotel&& other) noexcept {
     if (this != &other) {
         HotelBase::operator=(std::move(other));
-        stars = other.stars;
-        services = std::move(other.services);
-        hasPool = other.hasPool;
-        hasSpa = other.hasSpa;
-        hasRestaurant = other.hasRestaurant;
     }
     return *this;
 }
 
 // Getters
-int PremiumHotel::getStars() const {
-    return stars;
-}
-
 std::vector<std::string> PremiumHotel::getServices() const {
-    return services;
+    return AmenityDictionary::names(amenities);
 }
 
 bool PremiumHotel::getHasPool() const {
-    return hasPool;
+    return hasAmenities(AmenityDictionary::bit(Amenity::Pool));
 }
 
 bool PremiumHotel::getHasSpa() const {
-    return hasSpa;
+    return hasAmenities(AmenityDictionary::bit(Amenity::Spa));
 }
 
 bool PremiumHotel::getHasRestaurant() const {
-    return hasRestaurant;
+    return hasAmenities(AmenityDictionary::bit(Amenity::Restaurant));
 }
 
 // Setters
-void PremiumHotel::setStars(int stars) {
-    this->stars = stars;
-}
-
 void PremiumHotel::setServices(const std::vector<std::string>& services) {
-    this->services = services;
+    AmenityMask mask = 0;
+    for (const auto& service : services) {
+        Amenity amenity;
+        if (AmenityDictionary::lookup(service, amenity)) {
+            mask |= AmenityDictionary::bit(amenity);
+        }
+    }
+    setAmenities(mask);
 }
 
 void PremiumHotel::setHasPool(bool hasPool) {
-    this->hasPool = hasPool;
+    setAmenity(Amenity::Pool, hasPool);
 }
 
 void PremiumHotel::setHasSpa(bool hasSpa) {
-    this->hasSpa = hasSpa;
+    setAmenity(Amenity::Spa, hasSpa);
 }
 
 void PremiumHotel::setHasRestaurant(bool hasRestaurant) {
-    this->hasRestaurant = hasRestaurant;
+    setAmenity(Amenity::Restaurant, hasRestaurant);
 }
 
 // Реалізація віртуальних методів
 
-std::string PremiumHotel::getType() const {
-    return HOTEL_TYPE_PREMIUM;
-}
-
 void PremiumHotel::displayInfo() const {
     std::cout << "\n========================================" << std::endl;
     std::cout << "PREMIUM HOTEL" << std::endl;
@@ -119,10 +102,11 @@ void PremiumHotel::displayInfo() const {
     std::cout << "Кількість номерів: " << getRoomCount() << std::endl;
     std::cout << "Середня ціна: " << std::fixed << std::setprecision(2)
         << calculateAveragePrice() << " грн/ніч" << std::endl;
-    std::cout << "Басейн: " << (hasPool ? "Так" : "Ні") << std::endl;
-    std::cout << "SPA: " << (hasSpa ? "Так" : "Ні") << std::endl;
-    std::cout << "Ресторан: " << (hasRestaurant ? "Так" : "Ні") << std::endl;
+    std::cout << "Басейн: " << (getHasPool() ? "Так" : "Ні") << std::endl;
+    std::cout << "SPA: " << (getHasSpa() ? "Так" : "Ні") << std::endl;
+    std::cout << "Ресторан: " << (getHasRestaurant() ? "Так" : "Ні") << std::endl;
 
+    std::vector<std::string> services = getServices();
     if (!services.empty()) {
         std::cout << "Сервіси: ";
         for (size_t i = 0; i < services.size(); ++i) {
@@ -136,40 +120,39 @@ void PremiumHotel::displayInfo() const {
 }
 
 double PremiumHotel::calculateAveragePrice() const {
-    if (rooms.empty()) {
-        return 0.0;
-    }
-
-    double totalPrice = 0.0;
-    for (const auto& room : rooms) {
-        totalPrice += room.getPricePerNight();
-    }
-
-    return totalPrice / rooms.size();
+    return priceStats.averagePrice();
 }
 
 // Власні методи
 
 void PremiumHotel::addService(const std::string& service) {
-    if (hasService(service)) {
-        std::cerr << "Такий сервіс вже існує!" << std::endl;
+    Amenity amenity;
+    if (!AmenityDictionary::lookup(service, amenity)) {
+        LOG_WARNING("Невідомий сервіс: " << service);
+        return;
+    }
+
+    if (hasAmenities(AmenityDictionary::bit(amenity))) {
+        LOG_WARNING("Такий сервіс вже існує!");
         return;
     }
-    services.push_back(service);
+    setAmenity(amenity, true);
 }
 
 bool PremiumHotel::removeService(const std::string& service) {
-    auto it = std::remove(services.begin(), services.end(), service);
-
-    if (it != services.end()) {
-        services.erase(it, services.end());
-        return true;
+    Amenity amenity;
+    if (!AmenityDictionary::lookup(service, amenity) ||
+        !hasAmenities(AmenityDictionary::bit(amenity))) {
+        return false;
     }
 
-    return false;
+    setAmenity(amenity, false);
+    return true;
 }
 
 void PremiumHotel::displayServices() const {
+    std::vector<std::string> services = getServices();
+
     if (services.empty()) {
         std::cout << "Додаткові сервіси відсутні." << std::endl;
         return;
@@ -182,7 +165,9 @@ void PremiumHotel::displayServices() const {
 }
 
 bool PremiumHotel::hasService(const std::string& service) const {
-    return std::find(services.begin(), services.end(), service) != services.end();
+    Amenity amenity;
+    return AmenityDictionary::lookup(service, amenity) &&
+        hasAmenities(AmenityDictionary::bit(amenity));
 }
 
 std::string PremiumHotel::getStarsRepresentation() const {
@@ -208,11 +193,16 @@ bool PremiumHotel::validate() const {
 int PremiumHotel::calculateRating() const {
     int rating = stars * 15;
 
-    if (hasPool) rating += 10;
-    if (hasSpa) rating += 10;
-    if (hasRestaurant) rating += 10;
+    if (getHasPool()) rating += 10;
+    if (getHasSpa()) rating += 10;
+    if (getHasRestaurant()) rating += 10;
 
-    rating += services.size() * 5;
+    // Послуги з окремим прапорцем уже враховані вище, решта - по 5 балів
+    AmenityMask others = amenities & ~(AmenityDictionary::bit(Amenity::Pool) |
+        AmenityDictionary::bit(Amenity::Spa) | AmenityDictionary::bit(Amenity::Restaurant));
+    for (; others != 0; others &= others - 1) {
+        rating += 5;
+    }
 
     return std::min(rating, 100);
 }
\ No newline at end of file
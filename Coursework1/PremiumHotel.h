@@ -9,16 +9,10 @@
  * @class PremiumHotel
  * @brief Клас-нащадок для преміум готелів (4-5 зірок)
  *
- * Додає специфічні поля та методи для готелів високого класу
+ * Додає специфічні поля та методи для готелів високого класу.
+ * Сервіси (у т.ч. басейн, SPA, ресторан) зберігаються у масці зручностей HotelBase.
  */
 class PremiumHotel : public HotelBase {
-private:
-    int stars;
-    std::vector<std::string> services;
-    bool hasPool;
-    bool hasSpa;
-    bool hasRestaurant;
-
 public:
     // Конструктори
     PremiumHotel();
@@ -35,21 +29,18 @@ public:
     PremiumHotel& operator=(PremiumHotel&& other) noexcept;
 
     // Getters
-    int getStars() const;
     std::vector<std::string> getServices() const;
     bool getHasPool() const;
     bool getHasSpa() const;
     bool getHasRestaurant() const;
 
     // Setters
-    void setStars(int stars);
     void setServices(const std::vector<std::string>& services);
     void setHasPool(bool hasPool);
     void setHasSpa(bool hasSpa);
     void setHasRestaurant(bool hasRestaurant);
 
     // Реалізація віртуальних методів
-    std::string getType() const override;
     void displayInfo() const override;
     double calculateAveragePrice() const override;
 
@@ -57,7 +48,7 @@ public:
 
     /**
      * @brief Додає сервіс до готелю
-     * @param service Назва сервісу
+     * @param service Назва сервісу зі словника зручностей
      */
     void addService(const std::string& service);
 
@@ -94,6 +85,12 @@ public:
 
     /**
      * @brief Отримує рейтинг готелю на основі сервісів
+     *
+     * 15 балів за зірку, по 10 за басейн, SPA і ресторан та по 5 за кожну
+     * іншу зручність з маски. Басейн, SPA і ресторан - біти маски, тож вони
+     * враховуються і тоді, коли прийшли зі списку послуг у файлі
+     * ("SPA;Pool;Restaurant"): раніше такі рядки давали лише по 5 балів,
+     * тепер по 10, і рейтинг може бути вищим (до обмеження 100).
      * @return Рейтинг від 0 до 100
      */
     int calculateRating() const;
@@ -0,0 +1,327 @@
+﻿#include "ReportWriter.h"
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    const char* const TABLE_SEPARATOR = " | ";
+    const size_t TABLE_SEPARATOR_LENGTH = 3;
+    const char* const ELLIPSIS = "\xE2\x80\xA6";
+
+    bool isContinuationByte(char ch) {
+        return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+    }
+}
+
+// Конструктор з параметрами
+ReportWriter::ReportWriter(std::ostream& out, ReportFormat format, const std::vector<ReportColumn>& columns,
+    size_t capacity)
+    : out(out), format(format), columns(columns), buffer(capacity > 0 ? capacity : 1),
+    used(0), fieldIndex(0), rowCount(0), headerWritten(false), finished(false) {
+}
+
+// Деструктор
+ReportWriter::~ReportWriter() {
+    try {
+        finish();
+    }
+    catch (const std::exception&) {
+        // Деструктор не повинен кидати виняток
+    }
+}
+
+// Getters
+ReportFormat ReportWriter::getFormat() const {
+    return format;
+}
+
+size_t ReportWriter::getRowCount() const {
+    return rowCount;
+}
+
+// Власні методи
+
+void ReportWriter::flushBuffer() {
+    if (used > 0) {
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+        used = 0;
+    }
+}
+
+void ReportWriter::append(const char* text, size_t length) {
+    if (used + length > buffer.size()) {
+        flushBuffer();
+        if (length > buffer.size()) {
+            out.write(text, static_cast<std::streamsize>(length));
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void ReportWriter::append(const std::string& text) {
+    append(text.data(), text.size());
+}
+
+void ReportWriter::appendChar(char ch) {
+    if (used == buffer.size()) {
+        flushBuffer();
+    }
+    buffer[used++] = ch;
+}
+
+void ReportWriter::appendSpaces(size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        appendChar(' ');
+    }
+}
+
+void ReportWriter::writeHeader() {
+    headerWritten = true;
+
+    switch (format) {
+    case ReportFormat::Table: {
+        size_t totalWidth = 0;
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                append(TABLE_SEPARATOR, TABLE_SEPARATOR_LENGTH);
+                totalWidth += TABLE_SEPARATOR_LENGTH;
+            }
+            appendTableCell(columns[i].title.data(), columns[i].title.size(), columns[i].width, false);
+            totalWidth += static_cast<size_t>(columns[i].width);
+        }
+        appendChar('\n');
+        for (size_t i = 0; i < totalWidth; ++i) {
+            appendChar('-');
+        }
+        appendChar('\n');
+        break;
+    }
+    case ReportFormat::Csv:
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                appendChar(',');
+            }
+            appendCsvText(columns[i].key);
+        }
+        appendChar('\n');
+        break;
+    case ReportFormat::Json:
+        appendChar('[');
+        break;
+    }
+}
+
+void ReportWriter::beginField() {
+    if (!headerWritten) {
+        writeHeader();
+    }
+    if (fieldIndex >= columns.size()) {
+        throw std::out_of_range("Забагато полів у рядку звіту");
+    }
+
+    switch (format) {
+    case ReportFormat::Table:
+        if (fieldIndex > 0) {
+            append(TABLE_SEPARATOR, TABLE_SEPARATOR_LENGTH);
+        }
+        break;
+    case ReportFormat::Csv:
+        if (fieldIndex > 0) {
+            appendChar(',');
+        }
+        break;
+    case ReportFormat::Json:
+        if (fieldIndex == 0) {
+            append(rowCount > 0 ? ",\n{" : "\n{", rowCount > 0 ? 3 : 2);
+        }
+        else {
+            appendChar(',');
+        }
+        appendJsonText(columns[fieldIndex].key);
+        appendChar(':');
+        break;
+    }
+}
+
+void ReportWriter::appendTableCell(const char* text, size_t length, int columnWidth, bool alignRight) {
+    size_t width = columnWidth > 0 ? static_cast<size_t>(columnWidth) : 0;
+    size_t textWidth = displayWidth(text, length);
+
+    if (textWidth > width && width > 0) {
+        // Обрізаємо до width - 1 символів і ставимо три крапки
+        size_t bytes = 0;
+        for (size_t symbols = 0; symbols < width - 1 && bytes < length; ++symbols) {
+            ++bytes;
+            while (bytes < length && isContinuationByte(text[bytes])) {
+                ++bytes;
+            }
+        }
+        append(text, bytes);
+        append(ELLIPSIS, std::strlen(ELLIPSIS));
+        return;
+    }
+
+    size_t padding = width > textWidth ? width - textWidth : 0;
+    if (alignRight) {
+        appendSpaces(padding);
+        append(text, length);
+    }
+    else {
+        append(text, length);
+        appendSpaces(padding);
+    }
+}
+
+void ReportWriter::appendCsvText(const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        append(text);
+        return;
+    }
+
+    appendChar('"');
+    for (char ch : text) {
+        if (ch == '"') {
+            appendChar('"');
+        }
+        appendChar(ch);
+    }
+    appendChar('"');
+}
+
+void ReportWriter::appendJsonText(const std::string& text) {
+    static const char DIGITS[] = "0123456789abcdef";
+
+    appendChar('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char code = static_cast<unsigned char>(text[i]);
+        if (code != '"' && code != '\\' && code >= 0x20) {
+            continue;
+        }
+
+        // Незмінні відрізки копіюємо цілком, екрануємо лише спецсимволи
+        append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+        if (code == '"' || code == '\\') {
+            appendChar('\\');
+            appendChar(static_cast<char>(code));
+        }
+        else {
+            char escaped[6] = { '\\', 'u', '0', '0', DIGITS[code >> 4], DIGITS[code & 0x0F] };
+            append(escaped, sizeof(escaped));
+        }
+    }
+    append(text.data() + runStart, text.size() - runStart);
+    appendChar('"');
+}
+
+void ReportWriter::appendNumber(const char* text, size_t length) {
+    if (format == ReportFormat::Table) {
+        appendTableCell(text, length, columns[fieldIndex].width, true);
+    }
+    else {
+        append(text, length);
+    }
+}
+
+void ReportWriter::field(const std::string& text) {
+    beginField();
+    switch (format) {
+    case ReportFormat::Table:
+        appendTableCell(text.data(), text.size(), columns[fieldIndex].width, false);
+        break;
+    case ReportFormat::Csv:
+        appendCsvText(text);
+        break;
+    case ReportFormat::Json:
+        appendJsonText(text);
+        break;
+    }
+    ++fieldIndex;
+}
+
+void ReportWriter::field(std::int64_t value) {
+    beginField();
+    char text[24];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    appendNumber(text, static_cast<size_t>(result.ptr - text));
+    ++fieldIndex;
+}
+
+void ReportWriter::field(Money value) {
+    beginField();
+    char text[Money::MAX_TEXT_LENGTH];
+    char* end = value.toChars(text, text + sizeof(text));
+    appendNumber(text, end ? static_cast<size_t>(end - text) : 0);
+    ++fieldIndex;
+}
+
+void ReportWriter::field(double value, int precision) {
+    beginField();
+    char text[64];
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, precision);
+    appendNumber(text, result.ec == std::errc() ? static_cast<size_t>(result.ptr - text) : 0);
+    ++fieldIndex;
+}
+
+void ReportWriter::endRow() {
+    if (!headerWritten) {
+        writeHeader();
+    }
+    if (format == ReportFormat::Json) {
+        if (fieldIndex == 0) {
+            append(rowCount > 0 ? ",\n{" : "\n{", rowCount > 0 ? 3 : 2);
+        }
+        appendChar('}');
+    }
+    else {
+        appendChar('\n');
+    }
+    fieldIndex = 0;
+    ++rowCount;
+}
+
+bool ReportWriter::finish() {
+    if (finished) {
+        return static_cast<bool>(out);
+    }
+    finished = true;
+
+    if (!headerWritten) {
+        writeHeader();
+    }
+    if (format == ReportFormat::Json) {
+        append(rowCount > 0 ? "\n]\n" : "]\n", rowCount > 0 ? 3 : 2);
+    }
+    flushBuffer();
+    out.flush();
+    return static_cast<bool>(out);
+}
+
+bool ReportWriter::parseFormat(const std::string& name, ReportFormat& format) {
+    if (name == "table") {
+        format = ReportFormat::Table;
+    }
+    else if (name == "csv") {
+        format = ReportFormat::Csv;
+    }
+    else if (name == "json") {
+        format = ReportFormat::Json;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+size_t ReportWriter::displayWidth(const char* text, size_t length) {
+    size_t width = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (!isContinuationByte(text[i])) {
+            ++width;
+        }
+    }
+    return width;
+}
@@ -0,0 +1,138 @@
+﻿#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+#include "Money.h"
+#include "Constants.hpp"
+
+/**
+ * @enum ReportFormat
+ * @brief Формат виведення звіту
+ */
+enum class ReportFormat {
+    Table,
+    Csv,
+    Json
+};
+
+/**
+ * @struct ReportColumn
+ * @brief Колонка звіту
+ */
+struct ReportColumn {
+    std::string key;      // Заголовок CSV та ключ JSON
+    std::string title;    // Заголовок таблиці
+    int width;            // Ширина колонки таблиці в символах
+};
+
+/**
+ * @class ReportWriter
+ * @brief Потоковий запис звіту у великий буфер, що використовується повторно
+ *
+ * Поля форматуються прямо у буфер (числа та суми через to_chars), а в
+ * потік буфер потрапляє одним write, коли заповниться або при finish().
+ * Так виведення 100 тис. рядків не скидає консоль після кожного поля,
+ * як це робили std::endl у displayInfo.
+ *
+ * Використання: field(...) для кожної колонки, endRow() в кінці рядка,
+ * finish() після останнього рядка (викликається і деструктором).
+ */
+class ReportWriter {
+private:
+    std::ostream& out;
+    ReportFormat format;
+    std::vector<ReportColumn> columns;
+    std::vector<char> buffer;
+    size_t used;
+    size_t fieldIndex;
+    size_t rowCount;
+    bool headerWritten;
+    bool finished;
+
+    void flushBuffer();
+    void append(const char* text, size_t length);
+    void append(const std::string& text);
+    void appendChar(char ch);
+    void appendSpaces(size_t count);
+    void writeHeader();
+    void beginField();
+    void appendTableCell(const char* text, size_t length, int columnWidth, bool alignRight);
+    void appendCsvText(const std::string& text);
+    void appendJsonText(const std::string& text);
+    void appendNumber(const char* text, size_t length);
+
+public:
+    // Конструктори
+    ReportWriter(std::ostream& out, ReportFormat format, const std::vector<ReportColumn>& columns,
+        size_t capacity = REPORT_BUFFER_BYTES);
+    ReportWriter(const ReportWriter& other) = delete;
+    ReportWriter(ReportWriter&& other) = delete;
+
+    // Деструктор
+    ~ReportWriter();
+
+    // Оператори присвоєння
+    ReportWriter& operator=(const ReportWriter& other) = delete;
+    ReportWriter& operator=(ReportWriter&& other) = delete;
+
+    // Getters
+    ReportFormat getFormat() const;
+    size_t getRowCount() const;
+
+    /**
+     * @brief Записує текстове поле поточного рядка
+     * @param text Текст UTF-8
+     */
+    void field(const std::string& text);
+
+    /**
+     * @brief Записує ціле поле поточного рядка
+     * @param value Значення
+     */
+    void field(std::int64_t value);
+
+    /**
+     * @brief Записує грошове поле поточного рядка ("1234.56")
+     * @param value Сума
+     */
+    void field(Money value);
+
+    /**
+     * @brief Записує дробове поле з фіксованою кількістю знаків після крапки
+     * @param value Значення
+     * @param precision Кількість знаків після крапки
+     */
+    void field(double value, int precision);
+
+    /**
+     * @brief Завершує поточний рядок
+     */
+    void endRow();
+
+    /**
+     * @brief Закриває звіт (масив JSON) і записує залишок буфера
+     * @return true якщо потік не в стані помилки
+     */
+    bool finish();
+
+    /**
+     * @brief Розбирає назву формату (table, csv, json)
+     * @param name Назва
+     * @param format Результат
+     * @return true якщо назва відома
+     */
+    static bool parseFormat(const std::string& name, ReportFormat& format);
+
+    /**
+     * @brief Кількість символів (кодових точок UTF-8) у тексті
+     * @param text Текст
+     * @param length Довжина в байтах
+     * @return Ширина для вирівнювання колонок таблиці
+     */
+    static size_t displayWidth(const char* text, size_t length);
+};
+
+#endif // REPORTWRITER_H
@@ -0,0 +1,13 @@
+﻿#include "Repricing.h"
+#include "Constants.hpp"
+#include <algorithm>
+
+Money PriceAdjustment::apply(Money price) const {
+    Money result = mode == RepriceMode::Percent
+        ? price.discounted(-percent)
+        : price + amount;
+
+    static const Money minPrice = Money::fromHryvnias(MIN_PRICE);
+    static const Money maxPrice = Money::fromHryvnias(MAX_PRICE);
+    return std::min(std::max(result, minPrice), maxPrice);
+}
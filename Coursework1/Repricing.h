@@ -0,0 +1,48 @@
+﻿#ifndef REPRICING_H
+#define REPRICING_H
+
+#include "Money.h"
+#include <string>
+#include <cstdint>
+
+/**
+ * @enum RepriceMode
+ * @brief Спосіб зміни ціни номера
+ */
+enum class RepriceMode : std::uint8_t {
+    Percent,
+    Absolute
+};
+
+/**
+ * @struct PriceAdjustment
+ * @brief Зміна ціни номера: на відсоток або на фіксовану суму
+ *
+ * Від'ємні значення означають знижку. Результат обмежується діапазоном
+ * MIN_PRICE..MAX_PRICE, тому номер після зміни лишається коректним.
+ */
+struct PriceAdjustment {
+    RepriceMode mode = RepriceMode::Percent;
+    double percent = 0.0;
+    Money amount;
+
+    /**
+     * @brief Обчислює нову ціну
+     * @param price Поточна ціна
+     * @return Ціна після зміни
+     */
+    Money apply(Money price) const;
+};
+
+/**
+ * @struct RepriceRule
+ * @brief Правило масової зміни цін (порожній фільтр - без обмеження)
+ */
+struct RepriceRule {
+    std::string city;
+    std::string type;
+    std::string roomClass;
+    PriceAdjustment adjustment;
+};
+
+#endif // REPRICING_H
@@ -1,30 +1,39 @@
 ﻿#include "Room.h"
 #include "Constants.hpp"
-#include <iomanip>
+#include "Logger.h"
+#include <algorithm>
+
+namespace {
+    // Обмежує місткість діапазоном одного байта (валідація відкине зайве)
+    std::uint8_t packCapacity(int capacity) {
+        return static_cast<std::uint8_t>(std::min(std::max(capacity, 0), 255));
+    }
+}
 
 // Конструктор за замовчуванням
 Room::Room()
-    : roomNumber(0), roomClass(ROOM_CLASS_STANDARD), capacity(2), pricePerNight(0.0), isAvailable(true) {
+    : roomNumber(0), roomClass(RoomClass::Standard), capacity(2), flags(FLAG_AVAILABLE),
+    reserved(0), price() {
 }
 
 // Конструктор з параметрами
-Room::Room(int roomNumber, const std::string& roomClass, int capacity, double pricePerNight)
-    : roomNumber(roomNumber), roomClass(roomClass), capacity(capacity),
-    pricePerNight(pricePerNight), isAvailable(true) {
+Room::Room(int roomNumber, const std::string& roomClass, int capacity, Money pricePerNight)
+    : roomNumber(roomNumber), roomClass(parseRoomClass(roomClass)), capacity(packCapacity(capacity)),
+    flags(FLAG_AVAILABLE), reserved(0), price(pricePerNight) {
 }
 
 // Копіювальний конструктор
 Room::Room(const Room& other)
     : roomNumber(other.roomNumber), roomClass(other.roomClass),
-    capacity(other.capacity), pricePerNight(other.pricePerNight),
-    isAvailable(other.isAvailable) {
+    capacity(other.capacity), flags(other.flags), reserved(0),
+    price(other.price) {
 }
 
 // Переміщувальний конструктор
 Room::Room(Room&& other) noexcept
-    : roomNumber(other.roomNumber), roomClass(std::move(other.roomClass)),
-    capacity(other.capacity), pricePerNight(other.pricePerNight),
-    isAvailable(other.isAvailable) {
+    : roomNumber(other.roomNumber), roomClass(other.roomClass),
+    capacity(other.capacity), flags(other.flags), reserved(0),
+    price(other.price) {
 }
 
 // Деструктор
@@ -38,8 +47,8 @@ Room& Room::operator=(const Room& other) {
         roomNumber = other.roomNumber;
         roomClass = other.roomClass;
         capacity = other.capacity;
-        pricePerNight = other.pricePerNight;
-        isAvailable = other.isAvailable;
+        flags = other.flags;
+        price = other.price;
     }
     return *this;
 }
@@ -48,10 +57,10 @@ Room& Room::operator=(const Room& other) {
 Room& Room::operator=(Room&& other) noexcept {
     if (this != &other) {
         roomNumber = other.roomNumber;
-        roomClass = std::move(other.roomClass);
+        roomClass = other.roomClass;
         capacity = other.capacity;
-        pricePerNight = other.pricePerNight;
-        isAvailable = other.isAvailable;
+        flags = other.flags;
+        price = other.price;
     }
     return *this;
 }
@@ -61,7 +70,11 @@ int Room::getRoomNumber() const {
     return roomNumber;
 }
 
-std::string Room::getRoomClass() const {
+const std::string& Room::getRoomClass() const {
+    return roomClassName(roomClass);
+}
+
+RoomClass Room::getRoomClassId() const {
     return roomClass;
 }
 
@@ -69,12 +82,20 @@ int Room::getCapacity() const {
     return capacity;
 }
 
+Money Room::getPrice() const {
+    return price;
+}
+
 double Room::getPricePerNight() const {
-    return pricePerNight;
+    return price.toHryvnias();
+}
+
+std::int64_t Room::getPriceKopecks() const {
+    return price.getKopecks();
 }
 
 bool Room::getIsAvailable() const {
-    return isAvailable;
+    return (flags & FLAG_AVAILABLE) != 0;
 }
 
 // Setters
@@ -83,29 +104,60 @@ void Room::setRoomNumber(int roomNumber) {
 }
 
 void Room::setRoomClass(const std::string& roomClass) {
-    this->roomClass = roomClass;
+    this->roomClass = parseRoomClass(roomClass);
 }
 
 void Room::setCapacity(int capacity) {
-    this->capacity = capacity;
+    this->capacity = packCapacity(capacity);
+}
+
+void Room::setPrice(Money price) {
+    this->price = price;
 }
 
 void Room::setPricePerNight(double price) {
-    this->pricePerNight = price;
+    this->price = Money::fromHryvnias(price);
 }
 
 void Room::setIsAvailable(bool available) {
-    this->isAvailable = available;
+    if (available) {
+        flags |= FLAG_AVAILABLE;
+    }
+    else {
+        flags &= static_cast<std::uint8_t>(~FLAG_AVAILABLE);
+    }
+}
+
+RoomClass Room::parseRoomClass(const std::string& roomClass) {
+    if (roomClass == ROOM_CLASS_LUXURY) return RoomClass::Luxury;
+    if (roomClass == ROOM_CLASS_STANDARD) return RoomClass::Standard;
+    if (roomClass == ROOM_CLASS_ECONOMY) return RoomClass::Economy;
+    return RoomClass::Unknown;
+}
+
+const std::string& Room::roomClassName(RoomClass roomClass) {
+    static const std::string unknown = "Unknown";
+
+    switch (roomClass) {
+    case RoomClass::Luxury:
+        return ROOM_CLASS_LUXURY;
+    case RoomClass::Standard:
+        return ROOM_CLASS_STANDARD;
+    case RoomClass::Economy:
+        return ROOM_CLASS_ECONOMY;
+    default:
+        return unknown;
+    }
 }
 
 // Власні методи
 
 void Room::displayInfo() const {
     std::cout << "Номер: " << roomNumber
-        << " | Клас: " << roomClass
-        << " | Місць: " << capacity
-        << " | Ціна/ніч: " << std::fixed << std::setprecision(2) << pricePerNight << " грн"
-        << " | Статус: " << (isAvailable ? "Вільний" : "Зайнятий") << std::endl;
+        << " | Клас: " << getRoomClass()
+        << " | Місць: " << getCapacity()
+        << " | Ціна/ніч: " << price << " грн"
+        << " | Статус: " << (getIsAvailable() ? "Вільний" : "Зайнятий") << std::endl;
 }
 
 bool Room::validate() const {
@@ -117,50 +169,48 @@ bool Room::validate() const {
         return false;
     }
 
-    if (pricePerNight < MIN_PRICE || pricePerNight > MAX_PRICE) {
+    if (price < Money::fromHryvnias(MIN_PRICE) || price > Money::fromHryvnias(MAX_PRICE)) {
         return false;
     }
 
-    if (roomClass != ROOM_CLASS_LUXURY &&
-        roomClass != ROOM_CLASS_STANDARD &&
-        roomClass != ROOM_CLASS_ECONOMY) {
+    if (roomClass == RoomClass::Unknown) {
         return false;
     }
 
     return true;
 }
 
-double Room::calculateTotalPrice(int nights) const {
+Money Room::calculateTotalPrice(int nights) const {
     if (nights <= 0) {
-        return 0.0;
+        return Money();
     }
-    return pricePerNight * nights;
+    return price * nights;
 }
 
 void Room::applyDiscount(double discountPercent) {
     if (discountPercent < 0 || discountPercent > 100) {
-        std::cerr << "Некоректний відсоток знижки!" << std::endl;
+        LOG_WARNING("Некоректний відсоток знижки!");
         return;
     }
 
-    pricePerNight = pricePerNight * (1.0 - discountPercent / 100.0);
+    price = price.discounted(discountPercent);
 }
 
 std::string Room::getDetailedDescription() const {
-    std::string status = isAvailable ? "вільний" : "зайнятий";
+    std::string status = getIsAvailable() ? "вільний" : "зайнятий";
     return "Номер " + std::to_string(roomNumber) +
-        " (" + roomClass + ", " + std::to_string(capacity) + " місць) - " +
-        std::to_string(pricePerNight) + " грн/ніч [" + status + "]";
+        " (" + getRoomClass() + ", " + std::to_string(getCapacity()) + " місць) - " +
+        price.toString() + " грн/ніч [" + status + "]";
 }
 
 void Room::book() {
-    isAvailable = false;
+    setIsAvailable(false);
 }
 
 void Room::release() {
-    isAvailable = true;
+    setIsAvailable(true);
 }
 
 bool Room::isCheaperThan(const Room& other) const {
-    return pricePerNight < other.pricePerNight;
+    return price < other.price;
 }
\ No newline at end of file
@@ -1,27 +1,46 @@
 ﻿#ifndef ROOM_H
 #define ROOM_H
 
+#include "Money.h"
 #include <string>
 #include <iostream>
+#include <cstdint>
+
+/**
+ * @enum RoomClass
+ * @brief Клас номера у компактному (однобайтовому) представленні
+ */
+enum class RoomClass : std::uint8_t {
+    Luxury,
+    Standard,
+    Economy,
+    Unknown
+};
 
 /**
  * @class Room
  * @brief Клас для представлення номера готелю
  *
- * Містить інформацію про номер, клас, місткість та ціну
+ * Містить інформацію про номер, клас, місткість та ціну.
+ * Запис упаковано у 16 байт: ціна зберігається як Money (копійки, фіксована кома),
+ * клас - як RoomClass, місткість і прапорці - по одному байту.
+ * Завдяки цьому перебір номерів готелю не виділяє пам'ять.
  */
 class Room {
 private:
-    int roomNumber;
-    std::string roomClass;
-    int capacity;
-    double pricePerNight;
-    bool isAvailable;
+    static const std::uint8_t FLAG_AVAILABLE = 0x01;
+
+    std::int32_t roomNumber;
+    RoomClass roomClass;
+    std::uint8_t capacity;
+    std::uint8_t flags;
+    std::uint8_t reserved;
+    Money price;
 
 public:
     // Конструктори
     Room();
-    Room(int roomNumber, const std::string& roomClass, int capacity, double pricePerNight);
+    Room(int roomNumber, const std::string& roomClass, int capacity, Money pricePerNight);
     Room(const Room& other);
     Room(Room&& other) noexcept;
 
@@ -34,18 +53,36 @@ public:
 
     // Getters
     int getRoomNumber() const;
-    std::string getRoomClass() const;
+    const std::string& getRoomClass() const;
+    RoomClass getRoomClassId() const;
     int getCapacity() const;
+    Money getPrice() const;
     double getPricePerNight() const;
+    std::int64_t getPriceKopecks() const;
     bool getIsAvailable() const;
 
     // Setters
     void setRoomNumber(int roomNumber);
     void setRoomClass(const std::string& roomClass);
     void setCapacity(int capacity);
+    void setPrice(Money price);
     void setPricePerNight(double price);
     void setIsAvailable(bool available);
 
+    /**
+     * @brief Перетворює назву класу номера на RoomClass
+     * @param roomClass Назва класу (Luxury, Standard, Economy)
+     * @return Клас номера або RoomClass::Unknown
+     */
+    static RoomClass parseRoomClass(const std::string& roomClass);
+
+    /**
+     * @brief Отримує назву класу номера
+     * @param roomClass Клас номера
+     * @return Посилання на незмінний рядок з назвою
+     */
+    static const std::string& roomClassName(RoomClass roomClass);
+
     // Власні методи (мінімум 5)
 
     /**
@@ -62,12 +99,15 @@ public:
     /**
      * @brief Розраховує вартість проживання на кілька ночей
      * @param nights Кількість ночей
-     * @return Загальна вартість
+     * @return Загальна вартість (точна, у копійках)
      */
-    double calculateTotalPrice(int nights) const;
+    Money calculateTotalPrice(int nights) const;
 
     /**
      * @brief Застосовує знижку до ціни
+     *
+     * Для номера, що належить готелю, слід викликати HotelBase::applyRoomDiscount,
+     * щоб кешовані агрегати цін готелю залишались актуальними.
      * @param discountPercent Відсоток знижки (0-100)
      */
     void applyDiscount(double discountPercent);
@@ -96,4 +136,6 @@ public:
     bool isCheaperThan(const Room& other) const;
 };
 
+static_assert(sizeof(Room) <= 16, "Room must stay packed into 16 bytes");
+
 #endif // ROOM_H
\ No newline at end of file
@@ -0,0 +1,204 @@
+﻿#include "RoomIndex.h"
+#include <algorithm>
+
+namespace {
+    bool priceLess(const RoomIndex::Entry& a, const RoomIndex::Entry& b) {
+        return a.priceKopecks < b.priceKopecks;
+    }
+}
+
+// Конструктор за замовчуванням
+RoomIndex::RoomIndex()
+    : entryCount(0) {
+}
+
+// Деструктор
+RoomIndex::~RoomIndex() {
+}
+
+// Getters
+std::size_t RoomIndex::getEntryCount() const {
+    return entryCount;
+}
+
+void RoomIndex::collectPostings(const HotelBase& hotel, std::vector<Posting>& out) {
+    for (const auto& room : hotel.getRooms()) {
+        if (!room.getIsAvailable() || room.getRoomClassId() == RoomClass::Unknown) continue;
+
+        int capacity = room.getCapacity();
+        if (capacity < MIN_CAPACITY || capacity > MAX_CAPACITY) continue;
+
+        out.push_back(Posting{ static_cast<int>(room.getRoomClassId()), capacity,
+            Entry{ room.getPriceKopecks(), hotel.getHotelId(), room.getRoomNumber() } });
+    }
+}
+
+void RoomIndex::eraseEntries(const Tracked& hotel) {
+    // Запис шукаємо бінарним пошуком за ціною, а не проходом по кошику
+    for (const auto& posting : hotel.postings) {
+        auto& bucket = buckets[posting.roomClass][posting.capacity];
+        auto range = std::equal_range(bucket.begin(), bucket.end(), posting.entry, priceLess);
+        auto it = std::find_if(range.first, range.second, [&posting](const Entry& entry) {
+            return entry.hotelId == posting.entry.hotelId && entry.roomNumber == posting.entry.roomNumber;
+        });
+        if (it != range.second) {
+            bucket.erase(it);
+            entryCount--;
+        }
+    }
+}
+
+void RoomIndex::insertEntries(const Tracked& hotel) {
+    for (const auto& posting : hotel.postings) {
+        auto& bucket = buckets[posting.roomClass][posting.capacity];
+        bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), posting.entry, priceLess), posting.entry);
+        entryCount++;
+    }
+}
+
+void RoomIndex::build(const std::vector<std::shared_ptr<HotelBase>>& hotels) {
+    clear();
+
+    for (std::size_t position = 0; position < hotels.size(); ++position) {
+        const auto& hotel = hotels[position];
+        Tracked& entry = tracked[hotel->getHotelId()];
+        entry.hotel = hotel;
+        entry.revision = hotel->getRevision();
+        entry.position = position;
+        collectPostings(*hotel, entry.postings);
+
+        for (const auto& posting : entry.postings) {
+            buckets[posting.roomClass][posting.capacity].push_back(posting.entry);
+            entryCount++;
+        }
+    }
+
+    for (auto& byCapacity : buckets) {
+        for (auto& bucket : byCapacity) {
+            std::stable_sort(bucket.begin(), bucket.end(), priceLess);
+        }
+    }
+}
+
+// Власні методи
+
+void RoomIndex::clear() {
+    for (auto& byCapacity : buckets) {
+        for (auto& bucket : byCapacity) {
+            bucket.clear();
+        }
+    }
+    tracked.clear();
+    entryCount = 0;
+}
+
+void RoomIndex::removeHotel(int hotelId) {
+    auto it = tracked.find(hotelId);
+    if (it != tracked.end()) {
+        eraseEntries(it->second);
+        tracked.erase(it);
+    }
+}
+
+void RoomIndex::refreshHotel(int hotelId) {
+    auto it = tracked.find(hotelId);
+    if (it == tracked.end()) {
+        return;
+    }
+
+    Tracked& hotel = it->second;
+    eraseEntries(hotel);
+    hotel.postings.clear();
+    hotel.revision = hotel.hotel->getRevision();
+    collectPostings(*hotel.hotel, hotel.postings);
+    insertEntries(hotel);
+}
+
+void RoomIndex::sync(const std::vector<std::shared_ptr<HotelBase>>& hotels) {
+    std::vector<std::size_t> changed;
+
+    // Позиції оновлюються для всіх готелів, щоб результати йшли в порядку каталогу
+    for (std::size_t position = 0; position < hotels.size(); ++position) {
+        const auto& hotel = hotels[position];
+        auto it = tracked.find(hotel->getHotelId());
+        if (it == tracked.end() || it->second.hotel != hotel ||
+            it->second.revision != hotel->getRevision()) {
+            changed.push_back(position);
+        }
+        else {
+            it->second.position = position;
+        }
+    }
+
+    if (changed.empty()) {
+        return;
+    }
+
+    // Багато змін (напр. після завантаження чи масової зміни цін) дешевше
+    // перебудувати одним сортуванням кошиків
+    if (changed.size() > 64 || changed.size() * 4 > hotels.size()) {
+        build(hotels);
+        return;
+    }
+
+    for (std::size_t position : changed) {
+        const auto& hotel = hotels[position];
+        Tracked& entry = tracked[hotel->getHotelId()];
+        eraseEntries(entry);
+        entry.hotel = hotel;
+        entry.revision = hotel->getRevision();
+        entry.position = position;
+        entry.postings.clear();
+        collectPostings(*hotel, entry.postings);
+        insertEntries(entry);
+    }
+}
+
+std::vector<std::shared_ptr<HotelBase>> RoomIndex::findHotels(RoomClass roomClass, int minCapacity,
+    std::int64_t maxPriceKopecks) const {
+    int firstClass = 0;
+    int lastClass = CLASS_COUNT - 1;
+    if (roomClass != RoomClass::Unknown) {
+        firstClass = lastClass = static_cast<int>(roomClass);
+    }
+
+    int firstCapacity = std::max(minCapacity, MIN_CAPACITY);
+
+    // Збираємо лише ID готелів зі збігами, без масиву на весь каталог
+    std::vector<int> matched;
+    for (int cls = firstClass; cls <= lastClass; ++cls) {
+        for (int capacity = firstCapacity; capacity <= MAX_CAPACITY; ++capacity) {
+            const auto& bucket = buckets[cls][capacity];
+
+            // Кошик відсортовано за ціною: підходить лише префікс до maxPrice
+            auto end = std::upper_bound(bucket.begin(), bucket.end(), maxPriceKopecks,
+                [](std::int64_t price, const Entry& entry) { return price < entry.priceKopecks; });
+
+            for (auto it = bucket.begin(); it != end; ++it) {
+                matched.push_back(it->hotelId);
+            }
+        }
+    }
+
+    std::sort(matched.begin(), matched.end());
+    matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+
+    std::vector<const Tracked*> hotels;
+    hotels.reserve(matched.size());
+    for (int hotelId : matched) {
+        auto hotel = tracked.find(hotelId);
+        if (hotel != tracked.end()) {
+            hotels.push_back(&hotel->second);
+        }
+    }
+    std::sort(hotels.begin(), hotels.end(),
+        [](const Tracked* a, const Tracked* b) { return a->position < b->position; });
+
+    std::vector<std::shared_ptr<HotelBase>> result;
+    result.reserve(hotels.size());
+    for (const Tracked* hotel : hotels) {
+        result.push_back(hotel->hotel);
+    }
+
+    return result;
+}
@@ -0,0 +1,110 @@
+﻿#ifndef ROOMINDEX_H
+#define ROOMINDEX_H
+
+#include "HotelBase.h"
+#include "Constants.hpp"
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+/**
+ * @class RoomIndex
+ * @brief Багатовимірний індекс вільних номерів каталогу
+ *
+ * Номери розкладено по кошиках "клас x місткість", усередині кошика
+ * відсортовано за ціною. Запит "місткість >= c, ціна <= p, клас k"
+ * переглядає лише кошики з місткістю >= c і лише префікс кожного з них.
+ * Для кожного готелю запам'ятовуються його записи, тож зміна одного
+ * готелю оновлює лише їх, а не перебудовує весь індекс.
+ */
+class RoomIndex {
+public:
+    /**
+     * @struct Entry
+     * @brief Запис індексу (16 байт)
+     */
+    struct Entry {
+        std::int64_t priceKopecks;
+        std::int32_t hotelId;
+        std::int32_t roomNumber;
+    };
+
+private:
+    static const int CLASS_COUNT = 3;
+
+    /**
+     * @struct Posting
+     * @brief Запис готелю разом з кошиком, у якому він лежить
+     */
+    struct Posting {
+        int roomClass;
+        int capacity;
+        Entry entry;
+    };
+
+    /**
+     * @struct Tracked
+     * @brief Готель, відомий індексу, його ревізія та записи
+     */
+    struct Tracked {
+        std::shared_ptr<HotelBase> hotel;
+        std::uint64_t revision;
+        std::size_t position;           // позиція в каталозі на момент останньої синхронізації
+        std::vector<Posting> postings;
+    };
+
+    std::vector<Entry> buckets[CLASS_COUNT][MAX_CAPACITY + 1];
+    std::unordered_map<int, Tracked> tracked;
+    std::size_t entryCount;
+
+    static void collectPostings(const HotelBase& hotel, std::vector<Posting>& out);
+    void eraseEntries(const Tracked& hotel);
+    void insertEntries(const Tracked& hotel);
+    void build(const std::vector<std::shared_ptr<HotelBase>>& hotels);
+
+public:
+    // Конструктори
+    RoomIndex();
+
+    // Деструктор
+    ~RoomIndex();
+
+    // Getters
+    std::size_t getEntryCount() const;
+
+    /**
+     * @brief Очищає індекс
+     */
+    void clear();
+
+    /**
+     * @brief Видаляє записи готелю
+     * @param hotelId ID готелю
+     */
+    void removeHotel(int hotelId);
+
+    /**
+     * @brief Перераховує записи готелю, не чекаючи наступної синхронізації
+     * @param hotelId ID готелю
+     */
+    void refreshHotel(int hotelId);
+
+    /**
+     * @brief Синхронізує індекс з каталогом (нові та змінені готелі)
+     * @param hotels Готелі каталогу
+     */
+    void sync(const std::vector<std::shared_ptr<HotelBase>>& hotels);
+
+    /**
+     * @brief Знаходить готелі, що мають хоча б один номер за критеріями
+     * @param roomClass Клас номера або RoomClass::Unknown для будь-якого класу
+     * @param minCapacity Мінімальна місткість
+     * @param maxPriceKopecks Максимальна ціна в копійках
+     * @return Готелі в порядку каталогу
+     */
+    std::vector<std::shared_ptr<HotelBase>> findHotels(RoomClass roomClass, int minCapacity,
+        std::int64_t maxPriceKopecks) const;
+};
+
+#endif // ROOMINDEX_H
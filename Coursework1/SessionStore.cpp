@@ -0,0 +1,153 @@
+﻿#include "SessionStore.h"
+#include "PasswordHasher.h"
+#include "Constants.hpp"
+
+namespace {
+    // Таблиця ключується дайджестом, тож витік таблиці не розкриває токенів
+    std::string tokenDigest(const std::string& token) {
+        return PasswordHasher::toHex(PasswordHasher::sha256(token));
+    }
+
+    // Скільки видач між прибираннями прострочених сесій шарда
+    const size_t PURGE_INTERVAL = 256;
+}
+
+// Конструктор за замовчуванням
+SessionStore::SessionStore()
+    : SessionStore(std::chrono::seconds(SESSION_TTL_SECONDS), SESSION_SHARD_COUNT) {
+}
+
+// Конструктор з параметрами
+SessionStore::SessionStore(std::chrono::seconds ttl, size_t shardCount)
+    : ttl(ttl) {
+    size_t count = shardCount > 0 ? shardCount : 1;
+    shards.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        shards.push_back(std::unique_ptr<Shard>(new Shard()));
+    }
+}
+
+// Деструктор
+SessionStore::~SessionStore() {
+}
+
+SessionStore::Shard& SessionStore::shardFor(const std::string& digest) {
+    // Дайджест рівномірно розподілений, тому достатньо перших чотирьох hex-цифр
+    size_t bucket = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        char ch = digest[i];
+        bucket = bucket * 16 + static_cast<size_t>(ch <= '9' ? ch - '0' : ch - 'a' + 10);
+    }
+    return *shards[bucket % shards.size()];
+}
+
+size_t SessionStore::purgeShard(Shard& shard, std::chrono::steady_clock::time_point now) {
+    size_t removed = 0;
+    for (auto it = shard.sessions.begin(); it != shard.sessions.end();) {
+        if (it->second.expiresAt <= now) {
+            it = shard.sessions.erase(it);
+            removed++;
+        }
+        else {
+            ++it;
+        }
+    }
+    shard.issuedSincePurge = 0;
+    return removed;
+}
+
+// Власні методи
+
+std::string SessionStore::issue(const std::string& username, int accessLevel) {
+    std::string token = PasswordHasher::toHex(PasswordHasher::randomBytes(SESSION_TOKEN_BYTES));
+    std::string digest = tokenDigest(token);
+    auto now = std::chrono::steady_clock::now();
+
+    SessionInfo info;
+    info.username = username;
+    info.accessLevel = accessLevel;
+    info.expiresAt = now + ttl;
+
+    Shard& shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (++shard.issuedSincePurge >= PURGE_INTERVAL) {
+        purgeShard(shard, now);
+    }
+    shard.sessions[digest] = info;
+
+    return token;
+}
+
+bool SessionStore::validate(const std::string& token, SessionInfo& info) {
+    if (token.size() != static_cast<size_t>(SESSION_TOKEN_BYTES) * 2) {
+        return false;
+    }
+
+    std::string digest = tokenDigest(token);
+    Shard& shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.sessions.find(digest);
+    if (it == shard.sessions.end()) {
+        return false;
+    }
+
+    if (it->second.expiresAt <= std::chrono::steady_clock::now()) {
+        shard.sessions.erase(it);
+        return false;
+    }
+
+    info = it->second;
+    return true;
+}
+
+bool SessionStore::revoke(const std::string& token) {
+    std::string digest = tokenDigest(token);
+    Shard& shard = shardFor(digest);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.sessions.erase(digest) > 0;
+}
+
+size_t SessionStore::revokeUser(const std::string& username) {
+    size_t removed = 0;
+
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (auto it = shard->sessions.begin(); it != shard->sessions.end();) {
+            if (it->second.username == username) {
+                it = shard->sessions.erase(it);
+                removed++;
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    return removed;
+}
+
+size_t SessionStore::purgeExpired() {
+    size_t removed = 0;
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        removed += purgeShard(*shard, now);
+    }
+
+    return removed;
+}
+
+size_t SessionStore::size() const {
+    size_t total = 0;
+
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->sessions.size();
+    }
+
+    return total;
+}
@@ -0,0 +1,110 @@
+﻿#ifndef SESSIONSTORE_H
+#define SESSIONSTORE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <memory>
+
+/**
+ * @struct SessionInfo
+ * @brief Дані сесії, які повертаються при перевірці токена
+ */
+struct SessionInfo {
+    std::string username;
+    int accessLevel = 0;
+    std::chrono::steady_clock::time_point expiresAt;
+};
+
+/**
+ * @class SessionStore
+ * @brief Таблиця непрозорих токенів сесій з обмеженим часом життя
+ *
+ * Токен видається після (дорогої) перевірки пароля, а подальші запити
+ * перевіряють лише токен: пошук у хеш-таблиці за SHA-256 токена.
+ * Сам токен не зберігається. Таблиця розбита на шарди з окремими м'ютексами,
+ * тому паралельні запити різних агентів не конкурують за одне блокування.
+ */
+class SessionStore {
+private:
+    /**
+     * @struct Shard
+     * @brief Частина таблиці сесій зі своїм блокуванням
+     */
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, SessionInfo> sessions;
+        size_t issuedSincePurge = 0;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::chrono::seconds ttl;
+
+    /**
+     * @brief Обирає шард за дайджестом токена
+     */
+    Shard& shardFor(const std::string& digest);
+
+    /**
+     * @brief Видаляє прострочені сесії шарда (блокування вже взято)
+     * @return Кількість видалених сесій
+     */
+    static size_t purgeShard(Shard& shard, std::chrono::steady_clock::time_point now);
+
+public:
+    // Конструктори
+    SessionStore();
+    explicit SessionStore(std::chrono::seconds ttl, size_t shardCount);
+    SessionStore(const SessionStore& other) = delete;
+    SessionStore& operator=(const SessionStore& other) = delete;
+
+    // Деструктор
+    ~SessionStore();
+
+    // Власні методи
+
+    /**
+     * @brief Видає новий токен сесії
+     * @param username Логін користувача
+     * @param accessLevel Рівень доступу
+     * @return Непрозорий токен (hex)
+     */
+    std::string issue(const std::string& username, int accessLevel);
+
+    /**
+     * @brief Перевіряє токен
+     * @param token Токен сесії
+     * @param info Дані сесії (якщо токен дійсний)
+     * @return true якщо токен дійсний і не прострочений, false в іншому випадку
+     */
+    bool validate(const std::string& token, SessionInfo& info);
+
+    /**
+     * @brief Відкликає один токен (вихід із сесії)
+     * @param token Токен сесії
+     * @return true якщо токен існував, false в іншому випадку
+     */
+    bool revoke(const std::string& token);
+
+    /**
+     * @brief Відкликає всі сесії користувача
+     * @param username Логін користувача
+     * @return Кількість відкликаних сесій
+     */
+    size_t revokeUser(const std::string& username);
+
+    /**
+     * @brief Видаляє всі прострочені сесії
+     * @return Кількість видалених сесій
+     */
+    size_t purgeExpired();
+
+    /**
+     * @brief Отримує кількість сесій у таблиці (разом із ще не видаленими простроченими)
+     */
+    size_t size() const;
+};
+
+#endif // SESSIONSTORE_H
@@ -0,0 +1,200 @@
+﻿#include "Tracing.h"
+#include "Json.h"
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    std::string traceFilename() {
+#ifdef _MSC_VER
+        char* value = nullptr;
+        size_t length = 0;
+        std::string result;
+        if (_dupenv_s(&value, &length, "COURSEWORK1_TRACE") == 0 && value) {
+            result = value;
+        }
+        std::free(value);
+        return result;
+#else
+        const char* value = std::getenv("COURSEWORK1_TRACE");
+        return value ? value : "";
+#endif
+    }
+
+    /**
+     * @struct ThreadEvents
+     * @brief Події одного потоку (м'ютекс потрібен лише для flush з іншого потоку)
+     */
+    struct ThreadEvents {
+        std::mutex mutex;
+        std::vector<std::string> events;
+        int threadId = 0;
+    };
+
+    /**
+     * @struct TraceState
+     * @brief Стан трасування; при знищенні (завершення процесу) скидає події у файл
+     */
+    struct TraceState {
+        std::string filename;
+        std::chrono::steady_clock::time_point origin;
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<ThreadEvents>> threads;
+
+        TraceState() : filename(traceFilename()), origin(std::chrono::steady_clock::now()) {
+        }
+
+        ~TraceState() {
+            write();
+        }
+
+        bool write() {
+            if (filename.empty()) {
+                return true;
+            }
+
+            std::ofstream file(filename);
+            if (!file.is_open()) {
+                std::cerr << "Помилка: не вдалося створити файл трасування " << filename << std::endl;
+                return false;
+            }
+
+            file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+            bool first = true;
+            std::lock_guard<std::mutex> lock(registryMutex);
+            for (const auto& thread : threads) {
+                std::lock_guard<std::mutex> threadLock(thread->mutex);
+                for (const std::string& event : thread->events) {
+                    file << (first ? "\n" : ",\n") << event;
+                    first = false;
+                }
+            }
+            file << "\n]}" << std::endl;
+            return static_cast<bool>(file);
+        }
+    };
+
+    TraceState& state() {
+        static TraceState instance;
+        return instance;
+    }
+
+    // Ініціалізується до main, тож перевірка в TraceSpan - лише читання змінної
+    const bool traceEnabled = !state().filename.empty();
+
+    ThreadEvents& localEvents() {
+        thread_local ThreadEvents* local = nullptr;
+        if (!local) {
+            TraceState& trace = state();
+            std::unique_ptr<ThreadEvents> events(new ThreadEvents());
+            local = events.get();
+            std::lock_guard<std::mutex> lock(trace.registryMutex);
+            events->threadId = static_cast<int>(trace.threads.size()) + 1;
+            trace.threads.push_back(std::move(events));
+        }
+        return *local;
+    }
+
+    double micros(std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+}
+
+// Власні методи
+
+bool Tracer::isEnabled() {
+    return traceEnabled;
+}
+
+void Tracer::recordSpan(const char* name, const char* category,
+    std::chrono::steady_clock::time_point start,
+    std::chrono::steady_clock::time_point end,
+    const std::string& args) {
+    if (!traceEnabled) {
+        return;
+    }
+
+    ThreadEvents& events = localEvents();
+    char timing[96];
+    std::snprintf(timing, sizeof(timing), ",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+        micros(start - state().origin), micros(end - start), events.threadId);
+
+    std::string event = "{\"name\":" + Json::quote(name) + ",\"cat\":" + Json::quote(category) +
+        ",\"ph\":\"X\"" + timing;
+    if (!args.empty()) {
+        event += ",\"args\":{" + args + "}";
+    }
+    event += "}";
+
+    std::lock_guard<std::mutex> lock(events.mutex);
+    events.events.push_back(std::move(event));
+}
+
+bool Tracer::flush() {
+    return state().write();
+}
+
+// Конструктор з параметрами
+TraceSpan::TraceSpan(const char* name, const char* category)
+    : name(name), category(category), active(traceEnabled), phaseCount(0) {
+    if (active) {
+        start = std::chrono::steady_clock::now();
+        lastLap = start;
+    }
+}
+
+// Деструктор
+TraceSpan::~TraceSpan() {
+    if (!active) {
+        return;
+    }
+
+    try {
+        std::string allArgs = args;
+        for (int i = 0; i < phaseCount; ++i) {
+            char value[48];
+            std::snprintf(value, sizeof(value), "%.3f", phaseNs[i] / 1e3);
+            allArgs += (allArgs.empty() ? "" : ",") + Json::quote(std::string(phaseNames[i]) + "Us") + ":" + value;
+        }
+        Tracer::recordSpan(name, category, start, std::chrono::steady_clock::now(), allArgs);
+    }
+    catch (const std::exception&) {
+        // Подію не вдалося сформувати - трасування не повинне ламати операцію
+    }
+}
+
+// Власні методи
+
+void TraceSpan::lap(const char* phase) {
+    if (!active) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastLap).count();
+    lastLap = now;
+
+    for (int i = 0; i < phaseCount; ++i) {
+        if (phaseNames[i] == phase || std::strcmp(phaseNames[i], phase) == 0) {
+            phaseNs[i] += elapsed;
+            return;
+        }
+    }
+    if (phaseCount < MAX_PHASES) {
+        phaseNames[phaseCount] = phase;
+        phaseNs[phaseCount] = elapsed;
+        ++phaseCount;
+    }
+}
+
+void TraceSpan::addArg(const char* key, std::int64_t value) {
+    if (!active) {
+        return;
+    }
+    args += (args.empty() ? "" : ",") + Json::quote(key) + ":" + std::to_string(value);
+}
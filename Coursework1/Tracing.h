@@ -0,0 +1,96 @@
+﻿#ifndef TRACING_H
+#define TRACING_H
+
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class Tracer
+ * @brief Запис відрізків часу у форматі Chrome trace-event
+ *
+ * Вмикається змінною середовища COURSEWORK1_TRACE зі шляхом до файлу.
+ * Події накопичуються у буферах потоків і записуються у файл при
+ * завершенні процесу (або викликом flush); результат відкривається в
+ * chrome://tracing чи Perfetto. Без змінної кожен відрізок коштує лише
+ * перевірку прапорця.
+ */
+class Tracer {
+public:
+    /**
+     * @brief Чи ввімкнено трасування (значення визначається один раз при старті)
+     * @return true якщо задано COURSEWORK1_TRACE
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Додає завершений відрізок
+     * @param name Назва відрізка
+     * @param category Категорія (load, save, search...)
+     * @param start Початок
+     * @param end Кінець
+     * @param args Готовий вміст об'єкта args без дужок або порожній рядок
+     */
+    static void recordSpan(const char* name, const char* category,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end,
+        const std::string& args);
+
+    /**
+     * @brief Записує всі накопичені події у файл трасування
+     * @return true якщо успішно або трасування вимкнено, false при помилці запису
+     */
+    static bool flush();
+};
+
+/**
+ * @class TraceSpan
+ * @brief Відрізок трасування на час області видимості
+ *
+ * Для циклів, де окремий відрізок на кожен рядок був би завеликим,
+ * lap(phase) додає час від попередньої позначки до підсумку фази.
+ * Підсумки фаз (у мікросекундах) потрапляють в args відрізка, тож
+ * видно, скільки забрали читання, розбір, пошук чи запис.
+ */
+class TraceSpan {
+private:
+    static const int MAX_PHASES = 8;
+
+    const char* name;
+    const char* category;
+    bool active;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point lastLap;
+    const char* phaseNames[MAX_PHASES];
+    std::int64_t phaseNs[MAX_PHASES];
+    int phaseCount;
+    std::string args;
+
+public:
+    // Конструктори
+    TraceSpan(const char* name, const char* category);
+    TraceSpan(const TraceSpan& other) = delete;
+    TraceSpan(TraceSpan&& other) = delete;
+
+    // Деструктор
+    ~TraceSpan();
+
+    // Оператори присвоєння
+    TraceSpan& operator=(const TraceSpan& other) = delete;
+    TraceSpan& operator=(TraceSpan&& other) = delete;
+
+    /**
+     * @brief Зараховує час від попередньої позначки до фази
+     * @param phase Назва фази (рядковий літерал)
+     */
+    void lap(const char* phase);
+
+    /**
+     * @brief Додає числовий аргумент відрізка (кількість рядків тощо)
+     * @param key Назва аргументу
+     * @param value Значення
+     */
+    void addArg(const char* key, std::int64_t value);
+};
+
+#endif // TRACING_H
@@ -1,5 +1,7 @@
 ﻿#include "User.h"
 #include "Constants.hpp"
+#include "PasswordHasher.h"
+#include "Logger.h"
 
 // Конструктор за замовчуванням
 User::User() : username(""), password(""), accessLevel(ACCESS_LEVEL_USER) {
@@ -24,7 +26,7 @@ User::User(User&& other) noexcept
 
 // Деструктор
 User::~User() {
-    std::cout << "Об'єкт User '" << username << "' знищено." << std::endl;
+    LOG_DEBUG("Об'єкт User '" << username << "' знищено.");
 }
 
 // Оператор копіювального присвоєння
@@ -66,7 +68,7 @@ void User::setUsername(const std::string& username) {
 }
 
 void User::setPassword(const std::string& password) {
-    this->password = password;
+    this->password = PasswordHasher::hash(password);
 }
 
 void User::setAccessLevel(int accessLevel) {
@@ -80,7 +82,11 @@ bool User::isAdmin() const {
 }
 
 bool User::verifyPassword(const std::string& inputPassword) const {
-    return password == inputPassword;
+    return PasswordHasher::verify(inputPassword, password);
+}
+
+bool User::needsPasswordRehash() const {
+    return PasswordHasher::needsRehash(password);
 }
 
 bool User::validateUsername() const {
@@ -116,7 +122,7 @@ bool User::changePassword(const std::string& oldPassword, const std::string& new
         return false;
     }
 
-    password = newPassword;
+    setPassword(newPassword);
     return true;
 }
 
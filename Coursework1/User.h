@@ -8,7 +8,9 @@
  * @class User
  * @brief Клас для представлення користувача системи
  *
- * Містить інформацію про логін, пароль та рівень доступу користувача
+ * Містить інформацію про логін, пароль та рівень доступу користувача.
+ * Пароль зберігається як запис PasswordHasher (сіль + PBKDF2); конструктор
+ * приймає запис як є, а setPassword хешує новий пароль.
  */
 class User {
 private:
@@ -49,12 +51,18 @@ public:
     bool isAdmin() const;
 
     /**
-     * @brief Перевіряє правильність пароля
+     * @brief Перевіряє правильність пароля (навмисно повільно, PBKDF2)
      * @param inputPassword Пароль для перевірки
      * @return true якщо пароль співпадає, false в іншому випадку
      */
     bool verifyPassword(const std::string& inputPassword) const;
 
+    /**
+     * @brief Перевіряє чи збережено пароль у старому форматі (відкритий текст)
+     * @return true якщо запис пароля слід перехешувати
+     */
+    bool needsPasswordRehash() const;
+
     /**
      * @brief Валідує username (перевіряє на коректність)
      * @return true якщо username валідний, false в іншому випадку
@@ -1,43 +1,79 @@
 ﻿#include "UserAccountManager.h"
 #include "Constants.hpp"
+#include "PasswordHasher.h"
+#include "Logger.h"
+#include "Journal.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <filesystem>
+#include <cstdio>
+
+namespace {
+    // Пише знімок записів у тимчасовий файл (виконується у фоновому потоці)
+    bool writeSnapshot(const std::string& path, const std::vector<std::string>& records) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        for (const auto& record : records) {
+            file << record << '\n';
+        }
+
+        file.close();
+        return !file.fail() && Journal::syncFile(path);
+    }
+}
 
 // Конструктор за замовчуванням
 UserAccountManager::UserAccountManager()
-    : currentUser(nullptr), filename(USERS_FILE) {
+    : currentUser(), filename(USERS_FILE), sessions(std::make_shared<SessionStore>()),
+    fileRecords(0), compactionRecords(0) {
 }
 
 // Конструктор з параметром
 UserAccountManager::UserAccountManager(const std::string& filename)
-    : currentUser(nullptr), filename(filename) {
+    : currentUser(), filename(filename), sessions(std::make_shared<SessionStore>()),
+    fileRecords(0), compactionRecords(0) {
 }
 
 // Копіювальний конструктор
 UserAccountManager::UserAccountManager(const UserAccountManager& other)
-    : users(other.users), currentUser(nullptr), filename(other.filename) {
+    : slots(other.slots), freeSlots(other.freeSlots), usernameIndex(other.usernameIndex),
+    currentUser(), filename(other.filename), sessions(std::make_shared<SessionStore>()),
+    fileRecords(other.fileRecords), compactionRecords(0) {
 }
 
 // Переміщувальний конструктор
 UserAccountManager::UserAccountManager(UserAccountManager&& other) noexcept
-    : users(std::move(other.users)), currentUser(other.currentUser), filename(std::move(other.filename)) {
-    other.currentUser = nullptr;
+    : slots(std::move(other.slots)), freeSlots(std::move(other.freeSlots)),
+    usernameIndex(std::move(other.usernameIndex)), currentUser(other.currentUser),
+    filename(std::move(other.filename)), sessions(other.sessions), fileRecords(other.fileRecords),
+    compaction(std::move(other.compaction)), compactionRecords(other.compactionRecords),
+    compactionBacklog(std::move(other.compactionBacklog)) {
+    other.currentUser = UserHandle();
 }
 
 // Деструктор
 UserAccountManager::~UserAccountManager() {
+    finishCompaction(true);
     logout();
-    std::cout << "Об'єкт UserAccountManager знищено." << std::endl;
+    LOG_DEBUG("Об'єкт UserAccountManager знищено.");
 }
 
 // Оператор копіювального присвоєння
 UserAccountManager& UserAccountManager::operator=(const UserAccountManager& other) {
     if (this != &other) {
-        users = other.users;
+        // Фонова компактизація пише файл цього об'єкта, тож завершуємо її до заміни стану
+        finishCompaction(true);
+        slots = other.slots;
+        freeSlots = other.freeSlots;
+        usernameIndex = other.usernameIndex;
         filename = other.filename;
-        currentUser = nullptr;
+        fileRecords = other.fileRecords;
+        currentUser = UserHandle();
     }
     return *this;
 }
@@ -45,21 +81,201 @@ UserAccountManager& UserAccountManager::operator=(const UserAccountManager& othe
 // Оператор переміщувального присвоєння
 UserAccountManager& UserAccountManager::operator=(UserAccountManager&& other) noexcept {
     if (this != &other) {
-        users = std::move(other.users);
+        finishCompaction(true);
+        slots = std::move(other.slots);
+        freeSlots = std::move(other.freeSlots);
+        usernameIndex = std::move(other.usernameIndex);
         filename = std::move(other.filename);
+        sessions = other.sessions;
+        fileRecords = other.fileRecords;
+        compaction = std::move(other.compaction);
+        compactionRecords = other.compactionRecords;
+        compactionBacklog = std::move(other.compactionBacklog);
         currentUser = other.currentUser;
-        other.currentUser = nullptr;
+        other.currentUser = UserHandle();
     }
     return *this;
 }
 
 // Getters
-User* UserAccountManager::getCurrentUser() const {
+std::optional<User> UserAccountManager::getCurrentUser() const {
+    const User* user = resolve(currentUser);
+    if (!user) {
+        return std::nullopt;
+    }
+    return *user;
+}
+
+UserHandle UserAccountManager::getCurrentUserHandle() const {
     return currentUser;
 }
 
 std::vector<User> UserAccountManager::getUsers() const {
-    return users;
+    std::vector<User> result;
+    result.reserve(usernameIndex.size());
+    for (const auto& slot : slots) {
+        if (slot.occupied) {
+            result.push_back(slot.user);
+        }
+    }
+    return result;
+}
+
+size_t UserAccountManager::getUserCount() const {
+    return usernameIndex.size();
+}
+
+// Сховище користувачів
+
+UserHandle UserAccountManager::insertUser(User&& user) {
+    std::uint32_t index;
+    if (!freeSlots.empty()) {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[index];
+    slot.user = std::move(user);
+    slot.occupied = true;
+    usernameIndex[slot.user.getUsername()] = index;
+
+    UserHandle handle;
+    handle.slot = index;
+    handle.generation = slot.generation;
+    return handle;
+}
+
+void UserAccountManager::clearUsers() {
+    slots.clear();
+    freeSlots.clear();
+    usernameIndex.clear();
+}
+
+const User* UserAccountManager::resolve(UserHandle handle) const {
+    if (handle.slot >= slots.size()) {
+        return nullptr;
+    }
+
+    const Slot& slot = slots[handle.slot];
+    if (!slot.occupied || slot.generation != handle.generation) {
+        return nullptr;
+    }
+    return &slot.user;
+}
+
+void UserAccountManager::releaseSlot(std::uint32_t slotIndex) {
+    // Нове покоління робить недійсними всі дескриптори цього слота
+    Slot& slot = slots[slotIndex];
+    usernameIndex.erase(slot.user.getUsername());
+    slot.occupied = false;
+    slot.generation++;
+    slot.user = User();
+    freeSlots.push_back(slotIndex);
+}
+
+// Інкрементальний файл користувачів
+
+std::string UserAccountManager::formatRecord(const User& user) {
+    return user.getUsername() + ":" + user.getPassword() + ":" + std::to_string(user.getAccessLevel());
+}
+
+bool UserAccountManager::appendRecord(const std::string& record) {
+    finishCompaction(false);
+
+    try {
+        std::ofstream file(filename, std::ios::app);
+
+        if (!file.is_open()) {
+            LOG_ERROR("Не вдалося відкрити файл для запису: " << filename);
+            return false;
+        }
+
+        file << record << '\n';
+        file.close();
+        if (file.fail() || !Journal::syncFile(filename)) {
+            return false;
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка збереження користувачів: " << e.what());
+        return false;
+    }
+
+    fileRecords++;
+    if (compaction.valid()) {
+        compactionBacklog.push_back(record);
+    }
+    return true;
+}
+
+void UserAccountManager::maybeCompact() {
+    if (compaction.valid()) {
+        return;
+    }
+
+    size_t liveRecords = usernameIndex.size();
+    if (fileRecords < static_cast<size_t>(USERS_COMPACT_MIN_RECORDS) || fileRecords < liveRecords * 2) {
+        return;
+    }
+
+    std::vector<std::string> records;
+    records.reserve(liveRecords);
+    for (const auto& slot : slots) {
+        if (slot.occupied) {
+            records.push_back(formatRecord(slot.user));
+        }
+    }
+
+    compactionRecords = records.size();
+    compactionBacklog.clear();
+    std::string tempPath = filename + USERS_TEMP_SUFFIX;
+    compaction = std::async(std::launch::async, [tempPath, records]() {
+        return writeSnapshot(tempPath, records);
+    });
+}
+
+bool UserAccountManager::finishCompaction(bool wait) {
+    if (!compaction.valid()) {
+        return true;
+    }
+    if (!wait && compaction.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return true;
+    }
+
+    std::string tempPath = filename + USERS_TEMP_SUFFIX;
+    bool written = false;
+    try {
+        written = compaction.get();
+
+        // Записи, дописані під час компактизації, переносимо у новий файл
+        if (written && !compactionBacklog.empty()) {
+            std::ofstream file(tempPath, std::ios::app);
+            for (const auto& record : compactionBacklog) {
+                file << record << '\n';
+            }
+            file.close();
+            written = !file.fail() && Journal::syncFile(tempPath);
+        }
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Помилка компактизації користувачів: " << e.what());
+        written = false;
+    }
+
+    if (written && Journal::replaceFile(tempPath, filename)) {
+        fileRecords = compactionRecords + compactionBacklog.size();
+    }
+    else {
+        std::remove(tempPath.c_str());
+        written = false;
+    }
+
+    compactionBacklog.clear();
+    return written;
 }
 
 // Setters
@@ -70,33 +286,83 @@ void UserAccountManager::setFilename(const std::string& filename) {
 // Власні методи
 
 bool UserAccountManager::loadUsers() {
+    finishCompaction(true);
+
     try {
         std::ifstream file(filename);
 
         if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл: " << filename << std::endl;
+            LOG_ERROR("Не вдалося відкрити файл: " << filename);
             initializeDefaultAdmin();
             return false;
         }
 
-        users.clear();
+        // Сесію відновлюємо за логіном, бо слоти будуються заново
+        const User* sessionUser = resolve(currentUser);
+        std::string sessionUsername = sessionUser ? sessionUser->getUsername() : "";
+        currentUser = UserHandle();
+
+        clearUsers();
+        fileRecords = 0;
         std::string line;
+        size_t tornBytes = 0;
 
         while (std::getline(file, line)) {
+            // Рядок без завершального '\n' - недописаний при збої запис
+            if (file.eof() && !line.empty()) {
+                tornBytes = line.size();
+                break;
+            }
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
             if (line.empty()) continue;
+            fileRecords++;
+
+            // Надгробок видаленого користувача
+            if (line[0] == '-') {
+                auto it = usernameIndex.find(line.substr(1));
+                if (it != usernameIndex.end()) {
+                    releaseSlot(it->second);
+                }
+                continue;
+            }
 
             std::stringstream ss(line);
             std::string username, password;
             int accessLevel;
 
             if (std::getline(ss, username, ':') && std::getline(ss, password, ':') && ss >> accessLevel) {
-                users.emplace_back(username, password, accessLevel);
+                // Файл дописується, тому пізніший запис логіну замінює попередній
+                auto it = usernameIndex.find(username);
+                if (it != usernameIndex.end()) {
+                    slots[it->second].user = User(username, password, accessLevel);
+                }
+                else {
+                    insertUser(User(username, password, accessLevel));
+                }
             }
         }
 
         file.close();
 
-        if (users.empty()) {
+        // Обрізаємо хвіст, щоб наступний дописаний запис почався з нового рядка
+        if (tornBytes > 0) {
+            LOG_WARNING("Файл " << filename << ": відкинуто недописаний запис (" << tornBytes << " байт)");
+            std::error_code error;
+            auto size = std::filesystem::file_size(filename, error);
+            if (!error && size >= tornBytes) {
+                std::filesystem::resize_file(filename, size - tornBytes, error);
+            }
+        }
+
+        auto session = usernameIndex.find(sessionUsername);
+        if (session != usernameIndex.end()) {
+            currentUser.slot = session->second;
+            currentUser.generation = slots[session->second].generation;
+        }
+
+        if (usernameIndex.empty()) {
             initializeDefaultAdmin();
         }
 
@@ -104,111 +370,210 @@ bool UserAccountManager::loadUsers() {
 
     }
     catch (const std::exception& e) {
-        std::cerr << "Помилка завантаження користувачів: " << e.what() << std::endl;
+        LOG_ERROR("Помилка завантаження користувачів: " << e.what());
         initializeDefaultAdmin();
         return false;
     }
 }
 
 bool UserAccountManager::saveUsers() {
-    try {
-        std::ofstream file(filename);
+    finishCompaction(true);
 
-        if (!file.is_open()) {
-            std::cerr << "Не вдалося відкрити файл для запису: " << filename << std::endl;
-            return false;
+    try {
+        std::vector<std::string> records;
+        records.reserve(usernameIndex.size());
+        for (const auto& slot : slots) {
+            if (slot.occupied) {
+                records.push_back(formatRecord(slot.user));
+            }
         }
 
-        for (const auto& user : users) {
-            file << user.getUsername() << ":"
-                << user.getPassword() << ":"
-                << user.getAccessLevel() << std::endl;
+        // Повний запис іде через тимчасовий файл, тому збій не зіпсує наявний
+        std::string tempPath = filename + USERS_TEMP_SUFFIX;
+        if (!writeSnapshot(tempPath, records) || !Journal::replaceFile(tempPath, filename)) {
+            LOG_ERROR("Не вдалося відкрити файл для запису: " << filename);
+            std::remove(tempPath.c_str());
+            return false;
         }
 
-        file.close();
+        fileRecords = records.size();
         return true;
 
     }
     catch (const std::exception& e) {
-        std::cerr << "Помилка збереження користувачів: " << e.what() << std::endl;
+        LOG_ERROR("Помилка збереження користувачів: " << e.what());
         return false;
     }
 }
 
+bool UserAccountManager::checkCredentials(const std::string& username, const std::string& password,
+    UserHandle& handle) {
+    auto it = usernameIndex.find(username);
+    if (it == usernameIndex.end()) {
+        return false;
+    }
+
+    Slot& slot = slots[it->second];
+    if (!slot.user.verifyPassword(password)) {
+        return false;
+    }
+
+    // Старий запис у відкритому вигляді замінюємо хешем при першому вході
+    if (slot.user.needsPasswordRehash()) {
+        slot.user.setPassword(password);
+        appendRecord(formatRecord(slot.user));
+        maybeCompact();
+    }
+
+    handle.slot = it->second;
+    handle.generation = slot.generation;
+    return true;
+}
+
 bool UserAccountManager::login(const std::string& username, const std::string& password) {
-    for (auto& user : users) {
-        if (user.getUsername() == username && user.verifyPassword(password)) {
-            currentUser = &user;
-            return true;
-        }
+    UserHandle handle;
+    if (!checkCredentials(username, password, handle)) {
+        return false;
     }
-    return false;
+
+    currentUser = handle;
+    return true;
 }
 
 void UserAccountManager::logout() {
-    currentUser = nullptr;
+    currentUser = UserHandle();
+}
+
+std::string UserAccountManager::startSession(const std::string& username, const std::string& password) {
+    UserHandle handle;
+    if (!checkCredentials(username, password, handle)) {
+        return "";
+    }
+
+    return sessions->issue(username, slots[handle.slot].user.getAccessLevel());
+}
+
+std::optional<User> UserAccountManager::findUser(const std::string& username) const {
+    auto it = usernameIndex.find(username);
+    if (it == usernameIndex.end()) {
+        return std::nullopt;
+    }
+    return slots[it->second].user;
+}
+
+std::string UserAccountManager::startCheckedSession(const User& checked, const User& updated) {
+    auto it = usernameIndex.find(checked.getUsername());
+    if (it == usernameIndex.end()) {
+        return "";
+    }
+
+    // Пароль міг змінитися, поки його перевіряли без блокування
+    Slot& slot = slots[it->second];
+    if (slot.user.getPassword() != checked.getPassword()) {
+        return "";
+    }
+
+    // Конструктор приймає запис пароля як є, тож хешування тут не повторюється
+    if (updated.getPassword() != checked.getPassword()) {
+        slot.user = User(slot.user.getUsername(), updated.getPassword(), slot.user.getAccessLevel());
+        appendRecord(formatRecord(slot.user));
+        maybeCompact();
+    }
+
+    return sessions->issue(slot.user.getUsername(), slot.user.getAccessLevel());
+}
+
+bool UserAccountManager::validateSession(const std::string& token, SessionInfo& info) const {
+    return sessions->validate(token, info);
+}
+
+void UserAccountManager::endSession(const std::string& token) {
+    sessions->revoke(token);
 }
 
 bool UserAccountManager::registerUser(const std::string& username, const std::string& password, int accessLevel) {
     if (userExists(username)) {
-        std::cerr << "Користувач з таким логіном вже існує!" << std::endl;
+        LOG_WARNING("Користувач з таким логіном вже існує!");
         return false;
     }
 
     User newUser(username, password, accessLevel);
 
     if (!newUser.validateUsername() || !newUser.validatePassword()) {
-        std::cerr << "Некоректні дані користувача!" << std::endl;
+        LOG_WARNING("Некоректні дані користувача!");
         return false;
     }
 
-    users.push_back(newUser);
-    return saveUsers();
+    newUser.setPassword(password);
+    std::string record = formatRecord(newUser);
+
+    // Спершу файл: якщо запис не вдався, користувач не з'являється в пам'яті
+    if (!appendRecord(record)) {
+        return false;
+    }
+    insertUser(std::move(newUser));
+    maybeCompact();
+    return true;
 }
 
 bool UserAccountManager::deleteUser(const std::string& username) {
     if (username == "admin") {
-        std::cerr << "Не можна видалити адміністратора!" << std::endl;
+        LOG_WARNING("Не можна видалити адміністратора!");
         return false;
     }
 
-    auto it = std::remove_if(users.begin(), users.end(),
-        [&username](const User& user) { return user.getUsername() == username; });
+    auto it = usernameIndex.find(username);
+    if (it == usernameIndex.end()) {
+        return false;
+    }
 
-    if (it != users.end()) {
-        users.erase(it, users.end());
-        return saveUsers();
+    if (!appendRecord("-" + username)) {
+        return false;
     }
 
-    return false;
+    releaseSlot(it->second);
+    sessions->revokeUser(username);
+    maybeCompact();
+    return true;
 }
 
 void UserAccountManager::displayAllUsers() const {
     std::cout << "\n=== Список користувачів ===" << std::endl;
     std::cout << "------------------------------------------------------------" << std::endl;
 
-    for (const auto& user : users) {
-        std::cout << "Логін: " << user.getUsername()
-            << " | Рівень доступу: " << user.getAccessLevelName() << std::endl;
+    for (const auto& slot : slots) {
+        if (!slot.occupied) continue;
+
+        std::cout << "Логін: " << slot.user.getUsername()
+            << " | Рівень доступу: " << slot.user.getAccessLevelName() << std::endl;
     }
 
     std::cout << "------------------------------------------------------------" << std::endl;
-    std::cout << "Всього користувачів: " << users.size() << std::endl;
+    std::cout << "Всього користувачів: " << usernameIndex.size() << std::endl;
 }
 
 bool UserAccountManager::userExists(const std::string& username) const {
-    return std::any_of(users.begin(), users.end(),
-        [&username](const User& user) { return user.getUsername() == username; });
+    return usernameIndex.find(username) != usernameIndex.end();
 }
 
 bool UserAccountManager::isCurrentUserAdmin() const {
-    return currentUser != nullptr && currentUser->isAdmin();
+    const User* user = resolve(currentUser);
+    return user != nullptr && user->isAdmin();
 }
 
 void UserAccountManager::initializeDefaultAdmin() {
     if (!userExists("admin")) {
-        users.emplace_back("admin", "admin123", ACCESS_LEVEL_ADMIN);
-        saveUsers();
+        User admin("admin", "", ACCESS_LEVEL_ADMIN);
+        admin.setPassword("admin123");
+        std::string record = formatRecord(admin);
+
+        // Як і в addUser: адміністратор з'являється в пам'яті лише після запису у файл
+        if (!appendRecord(record)) {
+            LOG_ERROR("Не вдалося зберегти адміністратора за замовчуванням у " << filename);
+            return;
+        }
+        insertUser(std::move(admin));
+        maybeCompact();
         std::cout << "Створено адміністратора за замовчуванням (admin:admin123)" << std::endl;
     }
 }
\ No newline at end of file
@@ -2,20 +2,128 @@
 #define USERACCOUNTMANAGER_H
 
 #include "User.h"
+#include "SessionStore.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <memory>
+#include <future>
+#include <optional>
+#include <cstdint>
+
+/**
+ * @struct UserHandle
+ * @brief Стабільний дескриптор користувача (номер слота та його покоління)
+ *
+ * Після видалення користувача покоління слота збільшується, тому старий
+ * дескриптор більше не розіменовується, навіть якщо слот зайняв інший запис.
+ */
+struct UserHandle {
+    static const std::uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+
+    std::uint32_t slot = INVALID_SLOT;
+    std::uint32_t generation = 0;
+};
 
 /**
  * @class UserAccountManager
  * @brief Менеджер для управління обліковими записами користувачів
  *
- * Відповідає за авторизацію, реєстрацію, видалення та перегляд користувачів
+ * Відповідає за авторизацію, реєстрацію, видалення та перегляд користувачів.
+ * Користувачі зберігаються у слотах (slot map) з індексом за логіном, тому
+ * вхід і перевірка існування виконуються за O(1), а реєстрація нових
+ * користувачів не робить недійсним дескриптор поточної сесії.
+ *
+ * Для багатьох агентів пароль перевіряється один раз (startSession), після
+ * чого запити пред'являють токен, який перевіряє SessionStore без хешування пароля.
  */
 class UserAccountManager {
 private:
-    std::vector<User> users;
-    User* currentUser;
+    /**
+     * @struct Slot
+     * @brief Комірка сховища користувачів
+     */
+    struct Slot {
+        User user;
+        std::uint32_t generation = 0;
+        bool occupied = false;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<std::uint32_t> freeSlots;
+    std::unordered_map<std::string, std::uint32_t> usernameIndex;
+    UserHandle currentUser;
     std::string filename;
+    std::shared_ptr<SessionStore> sessions;
+
+    // Кількість рядків у файлі разом із застарілими записами та надгробками
+    size_t fileRecords;
+    std::future<bool> compaction;
+    size_t compactionRecords;
+    std::vector<std::string> compactionBacklog;
+
+    /**
+     * @brief Формує рядок файлу для користувача ("логін:пароль:рівень")
+     */
+    static std::string formatRecord(const User& user);
+
+    /**
+     * @brief Дописує рядок у кінець файлу користувачів
+     * @param record Запис користувача або надгробок "-логін"
+     * @return true якщо успішно, false в іншому випадку
+     */
+    bool appendRecord(const std::string& record);
+
+    /**
+     * @brief Запускає фонову компактизацію, якщо застарілих записів забагато
+     *
+     * Викликається після зміни пам'яті, щоб знімок уже містив дописаний запис.
+     * Знімок живих записів пишеться у тимчасовий файл в окремому потоці;
+     * записи, дописані тим часом, зберігаються і додаються перед перейменуванням.
+     */
+    void maybeCompact();
+
+    /**
+     * @brief Завершує фонову компактизацію атомарним перейменуванням
+     * @param wait Чекати завершення, якщо потік ще працює
+     * @return true якщо компактизація завершена або не виконувалась
+     */
+    bool finishCompaction(bool wait);
+
+    /**
+     * @brief Звільняє слот користувача, роблячи його дескриптори недійсними
+     * @param slotIndex Номер слота
+     */
+    void releaseSlot(std::uint32_t slotIndex);
+
+    /**
+     * @brief Перевіряє логін і пароль, за потреби оновлюючи формат запису пароля
+     * @param username Логін
+     * @param password Пароль
+     * @param handle Дескриптор знайденого користувача
+     * @return true якщо дані правильні, false в іншому випадку
+     */
+    bool checkCredentials(const std::string& username, const std::string& password,
+        UserHandle& handle);
+
+    /**
+     * @brief Розміщує користувача у вільному слоті та індексує його логін
+     * @param user Користувач
+     * @return Дескриптор нового користувача
+     */
+    UserHandle insertUser(User&& user);
+
+    /**
+     * @brief Очищує сховище користувачів
+     */
+    void clearUsers();
+
+    /**
+     * @brief Розіменовує дескриптор
+     * @param handle Дескриптор
+     * @return Вказівник на користувача або nullptr, якщо дескриптор застарів
+     */
+    const User* resolve(UserHandle handle) const;
 
 public:
     // Конструктори
@@ -32,8 +140,11 @@ public:
     UserAccountManager& operator=(UserAccountManager&& other) noexcept;
 
     // Getters
-    User* getCurrentUser() const;
+    // Копія: вказівник у слот став би недійсним після росту сховища
+    std::optional<User> getCurrentUser() const;
+    UserHandle getCurrentUserHandle() const;
     std::vector<User> getUsers() const;
+    size_t getUserCount() const;
 
     // Setters
     void setFilename(const std::string& filename);
@@ -48,6 +159,9 @@ public:
 
     /**
      * @brief Зберігає користувачів у файл
+     *
+     * Повністю перезаписує файл через тимчасовий файл та атомарне перейменування.
+     * Окремі зміни (реєстрація, видалення) лише дописуються у файл.
      * @return true якщо успішно, false в іншому випадку
      */
     bool saveUsers();
@@ -65,6 +179,46 @@ public:
      */
     void logout();
 
+    /**
+     * @brief Перевіряє пароль і видає токен сесії
+     * @param username Логін
+     * @param password Пароль
+     * @return Токен сесії або порожній рядок, якщо дані неправильні
+     */
+    std::string startSession(const std::string& username, const std::string& password);
+
+    /**
+     * @brief Знаходить користувача за логіном
+     * @param username Логін
+     * @return Копія користувача або std::nullopt
+     */
+    std::optional<User> findUser(const std::string& username) const;
+
+    /**
+     * @brief Видає токен сесії користувачу, пароль якого перевірено поза менеджером
+     *
+     * Дає змогу хешувати пароль (PBKDF2) без блокування менеджера: токен
+     * видається, лише якщо запис користувача не змінився після findUser.
+     * @param checked Копія з findUser, для якої пароль перевірено
+     * @param updated Та сама копія, з перехешованим паролем, якщо запис був у відкритому вигляді
+     * @return Токен сесії або порожній рядок, якщо запис змінився чи зник
+     */
+    std::string startCheckedSession(const User& checked, const User& updated);
+
+    /**
+     * @brief Перевіряє токен сесії (без хешування пароля, потокобезпечно)
+     * @param token Токен сесії
+     * @param info Дані сесії (логін, рівень доступу)
+     * @return true якщо токен дійсний, false в іншому випадку
+     */
+    bool validateSession(const std::string& token, SessionInfo& info) const;
+
+    /**
+     * @brief Завершує сесію, відкликаючи токен
+     * @param token Токен сесії
+     */
+    void endSession(const std::string& token);
+
     /**
      * @brief Реєструє нового користувача
      * @param username Логін